@@ -7,24 +7,73 @@ CONFIG += c++17
 
 SOURCES += \
     apiclient.cpp \
+    apiendpoints.cpp \
     apiworker.cpp \
+    archivebackfill.cpp \
+    circuitbreaker.cpp \
     connectionmanager.cpp \
     datamanager.cpp \
+    diagnosticsdialog.cpp \
+    harvester.cpp \
+    healthmonitor.cpp \
+    historyloader.cpp \
+    httpserver.cpp \
     main.cpp \
     mainwindow.cpp \
+    measurementdecoder.cpp \
     measurementhandler.cpp \
+    measurementpipeline.cpp \
+    metrics.cpp \
+    prefetcher.cpp \
+    queryserver.cpp \
+    requestscheduler.cpp \
+    requesttiming.cpp \
+    responsecache.cpp \
     sensorhandler.cpp \
-    stationhandler.cpp
+    stationcatalog.cpp \
+    stationdatasync.cpp \
+    stationhandler.cpp \
+    stationlistmodel.cpp \
+    stationsearchindex.cpp \
+    stationspatialindex.cpp \
+    taskexecutor.cpp \
+    textnormalizer.cpp \
+    tracing.cpp
 
 HEADERS += \
     apiclient.h \
+    apiendpoints.h \
     apiworker.h \
+    archivebackfill.h \
+    circuitbreaker.h \
     connectionmanager.h \
     datamanager.h \
+    diagnosticsdialog.h \
+    harvester.h \
+    healthmonitor.h \
+    historyloader.h \
+    httpserver.h \
     mainwindow.h \
+    measurementdecoder.h \
     measurementhandler.h \
+    measurementpipeline.h \
+    metrics.h \
+    prefetcher.h \
+    queryserver.h \
+    requestscheduler.h \
+    requesttiming.h \
+    responsecache.h \
     sensorhandler.h \
-    stationhandler.h
+    spscqueue.h \
+    stationcatalog.h \
+    stationdatasync.h \
+    stationhandler.h \
+    stationlistmodel.h \
+    stationsearchindex.h \
+    stationspatialindex.h \
+    taskexecutor.h \
+    textnormalizer.h \
+    tracing.h
 
 FORMS += \
     mainwindow.ui
@@ -4,28 +4,76 @@
  */
 
 #include "apiclient.h"
-#include "apiworker.h"
+#include "apiendpoints.h"
+#include "metrics.h"
+#include "tracing.h"
+
+#include <algorithm>
+
+namespace {
+/** Pojemność kanału wyników; przy pełnym kanale wyniki są przekazywane sygnałami. */
+constexpr int CompletionCapacity = 1024;
+/** Najkrótszy odstęp między kolejnymi opróżnieniami kanału wyników (ms) - jedna klatka przy 60 Hz. */
+constexpr int FrameInterval = 16;
+}
 
 /**
  * @brief Konstruktor klasy ApiClient.
  * 
  * Inicjalizuje obiekt klasy ApiClient, tworząc nowy wątek roboczy (`workerThread`) oraz obiekt `ApiWorker`, 
  * który jest przenoszony do tego wątku. Ustawia połączenia sygnałów i slotów między `ApiClient` a `ApiWorker`, 
- * aby umożliwić asynchroniczne przetwarzanie żądań API oraz obsługę wyników i błędów. Wywołuje metodę `init` 
+ * aby umożliwić asynchroniczne przetwarzanie żądań API oraz obsługę wyników, błędów i zmian stanu połączenia. 
+ * Wyniki żądań nie są przekazywane osobnymi sygnałami, lecz przez kanał wyników (`ApiWorker::CompletionChannel`): 
+ * wątek roboczy sygnalizuje tylko pierwszy wynik od ostatniego opróżnienia kanału, a `drainCompletions` obsługuje 
+ * naraz wszystkie oczekujące wyniki, najwyżej raz na klatkę (`FrameInterval`). Statystyki zgłaszane przez 
+ * ApiWorker po każdej odpowiedzi są zapamiętywane i przekazywane dalej razem z wynikami. Wywołuje metodę `init` 
  * obiektu `ApiWorker` w sposób opóźniony (QueuedConnection) i uruchamia wątek roboczy.
  * 
  * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
  */
 ApiClient::ApiClient(QObject *parent)
-    : QObject(parent), nextRequestId(0)
+    : QObject(parent), completions(CompletionCapacity), nextRequestId(0), nextBatchId(0), nextNetworkId(0), online(false), pendingStats(0)
 {
     worker = new ApiWorker();
+    worker->setCompletionChannel(&completions);
+    workerThread.setObjectName("ApiWorker");
     worker->moveToThread(&workerThread);
 
     connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
     connect(this, &ApiClient::requestApiData, worker, &ApiWorker::processRequest);
+    connect(this, &ApiClient::requestApiBatch, worker, &ApiWorker::processBatch);
+    connect(this, &ApiClient::cancelApiRequest, worker, &ApiWorker::cancelRequest);
     connect(worker, &ApiWorker::resultReady, this, &ApiClient::handleResults);
+    connect(worker, &ApiWorker::staleResultReady, this, &ApiClient::handleStaleResults);
     connect(worker, &ApiWorker::errorOccurred, this, &ApiClient::handleErrors);
+    connect(worker, &ApiWorker::completionsAvailable, this, &ApiClient::scheduleDrain);
+    drainTimer.setSingleShot(true);
+    drainTimer.setTimerType(Qt::PreciseTimer);
+    connect(&drainTimer, &QTimer::timeout, this, &ApiClient::drainCompletions);
+    qRegisterMetaType<ResponseCache::Stats>();
+    qRegisterMetaType<RequestScheduler::Stats>();
+    qRegisterMetaType<RequestScheduler::Priority>();
+    qRegisterMetaType<RequestTiming::Stats>();
+    connect(this, &ApiClient::promoteApiRequest, worker, &ApiWorker::promoteRequest);
+    connect(worker, &ApiWorker::schedulerStatsChanged, this, [this](const RequestScheduler::Stats &stats) {
+        lastSchedulerStats = stats;
+        pendingStats |= SchedulerStatsPending;
+        scheduleDrain();
+    });
+    connect(worker, &ApiWorker::timingStatsChanged, this, [this](const RequestTiming::Stats &stats) {
+        lastTimingStats = stats;
+        pendingStats |= TimingStatsPending;
+        scheduleDrain();
+    });
+    connect(worker, &ApiWorker::cacheStatsChanged, this, [this](const ResponseCache::Stats &stats) {
+        lastCacheStats = stats;
+        pendingStats |= CacheStatsPending;
+        scheduleDrain();
+    });
+    connect(worker, &ApiWorker::connectivityChanged, this, [this](bool online) {
+        this->online = online;
+        emit connectivityChanged(online);
+    });
 
     QMetaObject::invokeMethod(worker, &ApiWorker::init, Qt::QueuedConnection);
 
@@ -47,62 +95,481 @@ ApiClient::~ApiClient()
 /**
  * @brief Wysyła żądanie pobrania danych z podanego adresu URL.
  * 
- * Generuje unikalny identyfikator żądania (`requestId`) i emituje sygnał `requestApiData` z podanym adresem URL 
- * oraz identyfikatorem. Żądanie jest przekazywane do obiektu `ApiWorker` w celu asynchronicznego przetworzenia.
+ * Generuje unikalny identyfikator żądania (`requestId`) i dołącza żądanie do żądania sieciowego dla tego 
+ * adresu URL (`attach`). Identyczne żądania zlecone, zanim nadejdzie odpowiedź, są obsługiwane jednym 
+ * żądaniem sieciowym, a odpowiedź jest przekazywana każdemu z nich osobno. Żądania pojedyncze są 
+ * zlecane przez użytkownika, więc mają klasę priorytetu `RequestScheduler::Interactive`.
  * 
  * @param url Adres URL, z którego mają zostać pobrane dane.
+ * @param kind Rodzaj żądania.
+ * @param entityId Identyfikator encji (stacji lub czujnika).
+ * @return int Identyfikator żądania.
  * @note Funkcja zwiększa licznik `nextRequestId` dla każdego nowego żądania.
  */
-void ApiClient::fetchData(const QUrl &url)
+int ApiClient::fetchData(const QUrl &url, RequestKind kind, int entityId)
 {
     int requestId = nextRequestId++;
-    emit requestApiData(url, requestId);
+    attach(url, {requestId, kind, entityId}, RequestScheduler::Interactive);
+    return requestId;
+}
+
+/**
+ * @brief Wysyła żądanie pobrania listy wszystkich stacji.
+ * 
+ * @return int Identyfikator żądania.
+ */
+int ApiClient::fetchStations()
+{
+    return fetchData(ApiEndpoints::stations(), Stations);
+}
+
+/**
+ * @brief Wysyła żądanie pobrania listy czujników stacji.
+ * 
+ * Zastępuje poprzednie żądanie czujników (`replaceCurrent`).
+ * 
+ * @param stationId Identyfikator stacji.
+ * @return int Identyfikator żądania.
+ */
+int ApiClient::fetchSensors(int stationId)
+{
+    return replaceCurrent(Sensors, ApiEndpoints::sensors(stationId), stationId);
 }
 
 /**
  * @brief Wysyła żądanie pobrania danych dla konkretnego czujnika na podstawie jego identyfikatora.
  * 
- * Tworzy adres URL w formacie specyficznym dla API (https://api.gios.gov.pl/pjp-api/rest/data/getData/<sensorId>), 
- * generuje unikalny identyfikator żądania (`requestId`) i emituje sygnał `requestApiData` z utworzonym adresem URL 
- * oraz identyfikatorem. Żądanie jest przekazywane do obiektu `ApiWorker` w celu asynchronicznego przetworzenia.
+ * Tworzy adres URL w formacie specyficznym dla API (`ApiEndpoints::measurements`, <adres bazowy>/data/getData/<sensorId>). 
+ * Zastępuje poprzednie żądanie danych pomiarowych (`replaceCurrent`), np. gdy użytkownik szybko przechodzi 
+ * między czujnikami.
  * 
  * @param sensorId Identyfikator czujnika, dla którego mają zostać pobrane dane.
+ * @return int Identyfikator żądania.
  * @note Funkcja zwiększa licznik `nextRequestId` dla każdego nowego żądania.
  */
-void ApiClient::fetchSensorData(int sensorId)
+int ApiClient::fetchSensorData(int sensorId)
 {
-    QUrl url(QString("https://api.gios.gov.pl/pjp-api/rest/data/getData/%1").arg(sensorId));
-    int requestId = nextRequestId++;
-    emit requestApiData(url, requestId);
+    return replaceCurrent(Measurements, ApiEndpoints::measurements(sensorId), sensorId);
+}
+
+/**
+ * @brief Zastępuje bieżące żądanie danego rodzaju żądaniem dla podanego adresu URL.
+ * 
+ * Jeśli bieżące żądanie tego rodzaju dotyczy tego samego adresu i jest jeszcze w toku (np. ponowne 
+ * kliknięcie tej samej stacji), jest zachowywane. W przeciwnym razie nowe żądanie jest najpierw dołączane 
+ * (`attach`), a dopiero potem poprzednie jest odłączane (`detach`), więc żądanie sieciowe współdzielone 
+ * przez oba nie jest przerywane i wysyłane ponownie.
+ * 
+ * @param kind Rodzaj żądania.
+ * @param url Adres URL żądania.
+ * @param entityId Identyfikator encji (stacji lub czujnika).
+ * @return int Identyfikator bieżącego żądania.
+ */
+int ApiClient::replaceCurrent(RequestKind kind, const QUrl &url, int entityId)
+{
+    const int previous = currentRequest.value(kind, -1);
+    if (previous != -1) {
+        auto request = inFlight.constFind(networkIdForRequest.value(previous, -1));
+        if (request != inFlight.constEnd() && request->url == url) {
+            return previous;
+        }
+    }
+
+    const int requestId = fetchData(url, kind, entityId);
+    currentRequest.insert(kind, requestId);
+    if (previous != -1) {
+        detach(previous);
+    }
+    return requestId;
+}
+
+/**
+ * @brief Anuluje bieżące żądanie danego rodzaju.
+ * 
+ * Odłącza żądanie od żądania sieciowego (`detach`), więc jego odpowiedź nie zostanie przekazana. 
+ * Jeśli na żądanie sieciowe nie czeka już żadne inne żądanie, jest ono przerywane w wątku roboczym.
+ * 
+ * @param kind Rodzaj żądania.
+ */
+void ApiClient::cancel(RequestKind kind)
+{
+    auto it = currentRequest.find(kind);
+    if (it == currentRequest.end()) {
+        return;
+    }
+    const int requestId = it.value();
+    currentRequest.erase(it);
+    detach(requestId);
+}
+
+/**
+ * @brief Wysyła pakiet żądań pobrania danych z podanych adresów URL.
+ * 
+ * Nadaje identyfikator pakietu oraz kolejne identyfikatory żądań, zapamiętuje dla każdego żądania 
+ * jego pakiet i pozycję w pakiecie, a następnie przekazuje adresy, dla których nie ma jeszcze żądania 
+ * sieciowego w toku, do obiektu `ApiWorker` jednym sygnałem `requestApiBatch` (jedno zdarzenie 
+ * międzywątkowe zamiast jednego na adres).
+ * 
+ * @param urls Lista adresów URL.
+ * @param priority Klasa priorytetu żądań pakietu.
+ * @return int Identyfikator pakietu lub -1, jeśli lista jest pusta.
+ */
+int ApiClient::fetchBatch(const QVector<QUrl> &urls, RequestScheduler::Priority priority)
+{
+    if (urls.isEmpty()) {
+        return -1;
+    }
+
+    int batchId = nextBatchId++;
+    batches.insert(batchId, {static_cast<int>(urls.size()), 0});
+
+    QVector<QUrl> newUrls;
+    QVector<int> networkIds;
+    for (int i = 0; i < urls.size(); ++i) {
+        int requestId = nextRequestId++;
+        batchItems.insert(requestId, {batchId, i});
+        const bool known = inFlightByUrl.contains(urls.at(i));
+        const int networkId = attach(urls.at(i), {requestId, Other, -1}, priority, false);
+        if (!known) {
+            newUrls.append(urls.at(i));
+            networkIds.append(networkId);
+        }
+    }
+
+    if (!newUrls.isEmpty()) {
+        emit requestApiBatch(newUrls, networkIds, priority);
+    }
+    return batchId;
+}
+
+/**
+ * @brief Anuluje pakiet żądań.
+ * 
+ * Usuwa stan pakietu i odłącza (`detach`) wszystkie jego nieobsłużone jeszcze żądania, więc żądania 
+ * sieciowe współdzielone z innymi odbiorcami (np. z żądaniem interaktywnym o tym samym adresie) 
+ * są kontynuowane, a pozostałe są przerywane w wątku roboczym.
+ * 
+ * @param batchId Identyfikator pakietu zwrócony przez `fetchBatch`.
+ */
+void ApiClient::cancelBatch(int batchId)
+{
+    if (!batches.remove(batchId)) {
+        return;
+    }
+    for (auto it = batchItems.begin(); it != batchItems.end();) {
+        if (it->batchId == batchId) {
+            detach(it.key());
+            it = batchItems.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief Zwraca ostatni stan połączenia z API zgłoszony przez monitor dostępności.
+ * 
+ * @return bool Wartość true, jeśli API jest osiągalne.
+ */
+bool ApiClient::isOnline() const
+{
+    return online;
+}
+
+/**
+ * @brief Zwraca ostatnie statystyki pamięci podręcznej odpowiedzi zgłoszone przez ApiWorker.
+ * 
+ * @return ResponseCache::Stats Statystyki pamięci podręcznej.
+ */
+ResponseCache::Stats ApiClient::cacheStats() const
+{
+    return lastCacheStats;
+}
+
+/**
+ * @brief Zwraca ostatnie statystyki kolejki żądań zgłoszone przez ApiWorker.
+ * 
+ * @return RequestScheduler::Stats Głębokość kolejki i czas oczekiwania dla każdej klasy priorytetu.
+ */
+RequestScheduler::Stats ApiClient::schedulerStats() const
+{
+    return lastSchedulerStats;
+}
+
+/**
+ * @brief Zwraca ostatnie statystyki czasu etapów żądań zgłoszone przez ApiWorker.
+ * 
+ * @return RequestTiming::Stats Średnie czasy połączenia, pierwszego bajtu i transferu oraz udział ciepłych połączeń.
+ */
+RequestTiming::Stats ApiClient::timingStats() const
+{
+    return lastTimingStats;
+}
+
+/**
+ * @brief Planuje opróżnienie kanału wyników.
+ * 
+ * Pierwszy wynik po okresie bezczynności jest obsługiwany bez opóźnienia; kolejne opróżnienia następują 
+ * nie częściej niż co `FrameInterval` ms, więc wyniki napływające w tym czasie są obsługiwane razem, 
+ * w jednym zdarzeniu pętli zdarzeń.
+ */
+void ApiClient::scheduleDrain()
+{
+    if (drainTimer.isActive()) {
+        return;
+    }
+    const qint64 elapsed = sinceDrain.isValid() ? sinceDrain.elapsed() : FrameInterval;
+    drainTimer.start(static_cast<int>(qMax<qint64>(0, FrameInterval - elapsed)));
+}
+
+/**
+ * @brief Obsługuje wszystkie wyniki oczekujące w kanale wyników.
+ * 
+ * Flaga `wakePending` jest zerowana przed opróżnieniem kanału, więc wynik dodany w trakcie opróżniania 
+ * zostanie obsłużony teraz albo wywoła kolejny sygnał `completionsAvailable` - nigdy nie utknie w kanale. 
+ * Liczba wyników obsłużonych naraz jest zapisywana w histogramie `mjp_completion_batch_size`. 
+ * Na końcu emituje sygnały zmiany statystyk (kolejki, czasu etapów, pamięci podręcznej) - każdy najwyżej raz, 
+ * z ostatnimi statystykami zgłoszonymi przez ApiWorker.
+ */
+void ApiClient::drainCompletions()
+{
+    MJP_TRACE_SCOPE("ApiClient::drainCompletions");
+    static Metrics::Histogram &batchSize = Metrics::histogram("mjp_completion_batch_size",
+                                                              "Wyniki żądań obsłużone w jednym opróżnieniu kanału wyników");
+    completions.wakePending.store(false);
+    sinceDrain.start();
+
+    ApiWorker::Completion completion;
+    int count = 0;
+    while (completions.queue.pop(&completion)) {
+        if (completion.error) {
+            handleErrors(completion.payload, completion.requestId);
+        } else if (completion.stale) {
+            handleStaleResults(completion.payload, completion.requestId);
+        } else {
+            handleResults(completion.payload, completion.requestId);
+        }
+        ++count;
+    }
+    if (count > 0) {
+        batchSize.record(count);
+    }
+
+    const int stats = pendingStats;
+    pendingStats = 0;
+    if (stats & SchedulerStatsPending) {
+        emit schedulerStatsChanged(lastSchedulerStats);
+    }
+    if (stats & TimingStatsPending) {
+        emit timingStatsChanged(lastTimingStats);
+    }
+    if (stats & CacheStatsPending) {
+        emit cacheStatsChanged(lastCacheStats);
+    }
 }
 
 /**
  * @brief Obsługuje wyniki żądania zwrócone przez obiekt ApiWorker.
  * 
- * Emituje sygnał `dataReady` z otrzymanymi danymi w formacie QString oraz usuwa identyfikator żądania 
- * z mapy `requestTypes`. Dodatkowo wyświetla informację debugującą z identyfikatorem bieżącego wątku.
+ * Usuwa żądanie sieciowe z listy żądań w toku i przekazuje wynik każdemu oczekującemu na nie żądaniu: 
+ * żądaniom pakietu przez `completeBatchItem`, a pozostałym sygnałem `dataReady` z rodzajem żądania 
+ * i identyfikatorem encji, dla której je zlecono. Wyniki przerwanych żądań sieciowych są pomijane.
  * 
  * @param result Dane zwrócone w odpowiedzi na żądanie API, w formacie QString.
- * @param requestId Identyfikator żądania, dla którego zwrócono wyniki.
+ * @param networkId Identyfikator żądania sieciowego, dla którego zwrócono wyniki.
  */
-void ApiClient::handleResults(const QString &result, int requestId)
+void ApiClient::handleResults(const QString &result, int networkId)
 {
-    emit dataReady(result);
-    requestTypes.remove(requestId);
+    MJP_TRACE_SCOPE_ID("ApiClient::handleResults", networkId);
+    completeRequest(result, networkId, false);
     //qDebug() << "handleResults — thread:" << QThread::currentThreadId();
 }
 
+/**
+ * @brief Obsługuje nieświeżą odpowiedź z pamięci podręcznej zwróconą przez obiekt ApiWorker zamiast błędu.
+ * 
+ * @param result Treść odpowiedzi z pamięci podręcznej.
+ * @param networkId Identyfikator żądania sieciowego.
+ */
+void ApiClient::handleStaleResults(const QString &result, int networkId)
+{
+    MJP_TRACE_SCOPE_ID("ApiClient::handleStaleResults", networkId);
+    completeRequest(result, networkId, true);
+}
+
+/**
+ * @brief Kończy żądanie sieciowe i przekazuje jego wynik oczekującym żądaniom.
+ * 
+ * Aktualny wynik trafia do żądań pakietu przez `completeBatchItem`, a do pozostałych sygnałem `dataReady`. 
+ * Nieświeży wynik z pamięci podręcznej jest dla żądań pakietu błędem (pobieranie w tle nie zapisuje 
+ * nieświeżych danych), a pozostałym jest przekazywany sygnałem `staleDataReady`.
+ * 
+ * @param result Dane zwrócone w odpowiedzi na żądanie API.
+ * @param networkId Identyfikator żądania sieciowego.
+ * @param stale Wartość true, jeśli wynik jest nieświeżą odpowiedzią z pamięci podręcznej.
+ */
+void ApiClient::completeRequest(const QString &result, int networkId, bool stale)
+{
+    auto it = inFlight.find(networkId);
+    if (it == inFlight.end()) {
+        return;
+    }
+    MJP_TRACE_ASYNC_END("request", networkId);
+    const InFlight request = it.value();
+    inFlight.erase(it);
+    inFlightByUrl.remove(request.url);
+
+    for (const Waiter &waiter : request.waiters) {
+        networkIdForRequest.remove(waiter.requestId);
+        if (currentRequest.value(waiter.kind, -1) == waiter.requestId) {
+            currentRequest.remove(waiter.kind);
+        }
+        if (batchItems.contains(waiter.requestId)) {
+            completeBatchItem(waiter.requestId, stale ? nullptr : &result);
+        } else if (stale) {
+            emit staleDataReady(result, waiter.kind, waiter.entityId);
+        } else {
+            emit dataReady(result, waiter.kind, waiter.entityId);
+        }
+    }
+}
+
 /**
  * @brief Obsługuje błędy zgłoszone przez obiekt ApiWorker.
  * 
- * Emituje sygnał `errorOccurred` z opisem błędu w formacie QString oraz usuwa identyfikator żądania 
- * z mapy `requestTypes`.
+ * Dla każdego żądania oczekującego na żądanie sieciowe: jeśli żądanie należy do pakietu, zlicza błąd 
+ * w stanie pakietu (bez emitowania `errorOccurred`, aby pobieranie w tle nie powodowało przełączenia 
+ * widoku na dane lokalne), a w przeciwnym razie emituje sygnał `errorOccurred` z opisem błędu, 
+ * rodzajem żądania i identyfikatorem encji. Błędy przerwanych żądań sieciowych są pomijane.
  * 
  * @param error Opis błędu zwrócony w odpowiedzi na żądanie API, w formacie QString.
- * @param requestId Identyfikator żądania, dla którego zgłoszono błąd.
+ * @param networkId Identyfikator żądania sieciowego, dla którego zgłoszono błąd.
+ */
+void ApiClient::handleErrors(const QString &error, int networkId)
+{
+    MJP_TRACE_SCOPE_ID("ApiClient::handleErrors", networkId);
+    auto it = inFlight.find(networkId);
+    if (it == inFlight.end()) {
+        return;
+    }
+    MJP_TRACE_ASYNC_END("request", networkId);
+    const InFlight request = it.value();
+    inFlight.erase(it);
+    inFlightByUrl.remove(request.url);
+
+    for (const Waiter &waiter : request.waiters) {
+        networkIdForRequest.remove(waiter.requestId);
+        if (currentRequest.value(waiter.kind, -1) == waiter.requestId) {
+            currentRequest.remove(waiter.kind);
+        }
+        if (batchItems.contains(waiter.requestId)) {
+            completeBatchItem(waiter.requestId, nullptr);
+        } else {
+            emit errorOccurred(error, waiter.kind, waiter.entityId);
+        }
+    }
+}
+
+/**
+ * @brief Dołącza żądanie do żądania sieciowego dla podanego adresu URL.
+ * 
+ * Jeśli żądanie sieciowe dla tego adresu jest w toku, dodaje żądanie do listy oczekujących, a gdy nowe 
+ * żądanie ma wyższy priorytet, podnosi priorytet żądania sieciowego sygnałem `promoteApiRequest` 
+ * (np. użytkownik wybrał czujnik, którego dane czekają w kolejce pobierania w tle). W przeciwnym razie tworzy nowe żądanie sieciowe i (gdy `sendNow` jest ustawione) przekazuje je 
+ * do obiektu `ApiWorker` sygnałem `requestApiData`.
+ * 
+ * @param url Adres URL żądania.
+ * @param waiter Żądanie oczekujące na odpowiedź.
+ * @param priority Klasa priorytetu żądania.
+ * @param sendNow Wartość false, jeśli nowe żądanie sieciowe wyśle wywołujący (np. w pakiecie).
+ * @return int Identyfikator żądania sieciowego.
+ */
+int ApiClient::attach(const QUrl &url, const Waiter &waiter, RequestScheduler::Priority priority, bool sendNow)
+{
+    auto existing = inFlightByUrl.constFind(url);
+    if (existing != inFlightByUrl.constEnd()) {
+        InFlight &request = inFlight[existing.value()];
+        request.waiters.append(waiter);
+        networkIdForRequest.insert(waiter.requestId, existing.value());
+        if (priority < request.priority) {
+            request.priority = priority;
+            emit promoteApiRequest(existing.value(), priority);
+        }
+        return existing.value();
+    }
+
+    const int networkId = nextNetworkId++;
+    MJP_TRACE_ASYNC_BEGIN("request", networkId);
+    inFlight.insert(networkId, {url, priority, {waiter}});
+    inFlightByUrl.insert(url, networkId);
+    networkIdForRequest.insert(waiter.requestId, networkId);
+    if (sendNow) {
+        emit requestApiData(url, networkId, priority);
+    }
+    return networkId;
+}
+
+/**
+ * @brief Odłącza żądanie od jego żądania sieciowego.
+ * 
+ * Jeśli było to ostatnie żądanie oczekujące na odpowiedź, żądanie sieciowe jest usuwane z listy 
+ * żądań w toku i przerywane w wątku roboczym sygnałem `cancelApiRequest`.
+ * 
+ * @param requestId Identyfikator żądania.
+ */
+void ApiClient::detach(int requestId)
+{
+    const int networkId = networkIdForRequest.value(requestId, -1);
+    networkIdForRequest.remove(requestId);
+    auto it = inFlight.find(networkId);
+    if (it == inFlight.end()) {
+        return;
+    }
+
+    QVector<Waiter> &waiters = it->waiters;
+    waiters.erase(std::remove_if(waiters.begin(), waiters.end(), [requestId](const Waiter &waiter) {
+        return waiter.requestId == requestId;
+    }), waiters.end());
+
+    if (waiters.isEmpty()) {
+        inFlightByUrl.remove(it->url);
+        inFlight.erase(it);
+        emit cancelApiRequest(networkId);
+    }
+}
+
+/**
+ * @brief Kończy obsługę jednego żądania pakietu.
+ * 
+ * Emituje `batchItemReady` dla pobranych danych (lub zlicza błąd, gdy `data` to nullptr), 
+ * a po obsłużeniu ostatniego żądania pakietu emituje `batchFinished` i usuwa stan pakietu. 
+ * Stan pakietu jest aktualizowany przed emisją sygnałów, bo obsługa `batchItemReady` może zlecić 
+ * kolejny pakiet (`fetchBatch`), a wstawienie do `batches` unieważnia iteratory.
+ * 
+ * @param requestId Identyfikator żądania należącego do pakietu.
+ * @param data Wskaźnik na pobrane dane lub nullptr w przypadku błędu.
  */
-void ApiClient::handleErrors(const QString &error, int requestId)
+void ApiClient::completeBatchItem(int requestId, const QString *data)
 {
-    emit errorOccurred(error);
-    requestTypes.remove(requestId);
+    const BatchItem item = batchItems.take(requestId);
+    auto batch = batches.find(item.batchId);
+    if (batch == batches.end()) {
+        return;
+    }
+
+    if (!data) {
+        batch->failed++;
+    }
+    const bool finished = --batch->remaining == 0;
+    const int failed = batch->failed;
+    if (finished) {
+        batches.erase(batch);
+    }
+
+    if (data) {
+        emit batchItemReady(item.batchId, item.index, *data);
+    }
+    if (finished) {
+        emit batchFinished(item.batchId, failed);
+    }
 }
@@ -9,9 +9,14 @@
  #include <QObject>
  #include <QUrl>
  #include <QThread>
- #include <QMap>
- 
- class ApiWorker;
+ #include <QHash>
+ #include <QVector>
+ #include <QElapsedTimer>
+ #include <QTimer>
+ #include "apiworker.h"
+ #include "requestscheduler.h"
+ #include "requesttiming.h"
+ #include "responsecache.h"
  
  class ApiClient : public QObject
  {
@@ -23,8 +28,9 @@
       *
       * Inicjalizuje obiekt klasy ApiClient, tworząc nowy wątek roboczy (`workerThread`) oraz obiekt `ApiWorker`,
       * który jest przenoszony do tego wątku. Ustawia połączenia sygnałów i slotów między `ApiClient` a `ApiWorker`,
-      * aby umożliwić asynchroniczne wysyłanie żądań API, odbieranie wyników oraz obsługę błędów. Wywołuje metodę
-      * `init` obiektu `ApiWorker` w sposób opóźniony (QueuedConnection) i uruchamia wątek roboczy.
+      * aby umożliwić asynchroniczne wysyłanie żądań API, odbieranie wyników oraz obsługę błędów. Wyniki trafiają
+      * do bezblokadowego kanału (`completions`), opróżnianego najwyżej raz na klatkę (`drainCompletions`).
+      * Wywołuje metodę `init` obiektu `ApiWorker` w sposób opóźniony (QueuedConnection) i uruchamia wątek roboczy.
       *
       * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
       */
@@ -38,40 +44,152 @@
       */
      ~ApiClient();
  
+     /**
+      * @brief Rodzaj żądania API, określający sposób przekazania odpowiedzi.
+      *
+      * Odpowiedzi są przekazywane razem z rodzajem żądania i identyfikatorem encji (stacji lub czujnika),
+      * dla której zostały zlecone, więc odbiorca nie musi rozpoznawać ich po kształcie danych JSON
+      * ani po bieżącym zaznaczeniu w interfejsie.
+      */
+     enum RequestKind {
+         Stations,
+         Sensors,
+         Measurements,
+         Other
+     };
+     Q_ENUM(RequestKind)
+
      /**
       * @brief Wysyła żądanie pobrania danych z podanego adresu URL.
       *
-      * Generuje unikalny identyfikator żądania (`requestId`) i emituje sygnał `requestApiData` z podanym adresem
-      * URL oraz identyfikatorem. Żądanie jest przekazywane do obiektu `ApiWorker` w celu asynchronicznego
-      * przetworzenia w osobnym wątku.
+      * Generuje unikalny identyfikator żądania (`requestId`) i przekazuje żądanie do obiektu `ApiWorker` w celu
+      * asynchronicznego przetworzenia w osobnym wątku. Jeśli żądanie o tym samym adresie URL jest już w toku,
+      * nowe żądanie dołącza do niego zamiast wysyłać kolejne.
       *
       * @param url Adres URL, z którego mają zostać pobrane dane (np. lista stacji lub czujników).
+      * @param kind Rodzaj żądania, domyślnie `Other`.
+      * @param entityId Identyfikator encji (stacji lub czujnika), domyślnie -1.
+      * @return int Identyfikator żądania.
       * @note Funkcja zwiększa licznik `nextRequestId` dla każdego nowego żądania.
       */
-     void fetchData(const QUrl &url);
- 
+     int fetchData(const QUrl &url, RequestKind kind = Other, int entityId = -1);
+
+     /**
+      * @brief Wysyła żądanie pobrania listy wszystkich stacji.
+      *
+      * @return int Identyfikator żądania.
+      */
+     int fetchStations();
+
+     /**
+      * @brief Wysyła żądanie pobrania listy czujników stacji.
+      *
+      * Zastępuje poprzednie żądanie czujników (patrz `fetchSensorData`); ponowne żądanie tej samej stacji
+      * w trakcie pobierania dołącza do żądania w toku.
+      *
+      * @param stationId Identyfikator stacji.
+      * @return int Identyfikator żądania.
+      */
+     int fetchSensors(int stationId);
+
      /**
       * @brief Wysyła żądanie pobrania danych dla konkretnego czujnika na podstawie jego identyfikatora.
       *
-      * Tworzy adres URL w formacie specyficznym dla API (https://api.gios.gov.pl/pjp-api/rest/data/getData/<sensorId>),
-      * generuje unikalny identyfikator żądania (`requestId`) i emituje sygnał `requestApiData` z utworzonym adresem
-      * URL oraz identyfikatorem. Żądanie jest przekazywane do obiektu `ApiWorker` w celu asynchronicznego
-      * przetworzenia w osobnym wątku.
+      * Tworzy adres URL w formacie specyficznym dla API (`ApiEndpoints::measurements`, <adres bazowy>/data/getData/<sensorId>)
+      * i przekazuje żądanie do obiektu `ApiWorker` w celu asynchronicznego przetworzenia w osobnym wątku.
+      * Żądanie zastępuje poprzednie żądanie danych pomiarowych: jego odpowiedź nie zostanie przekazana,
+      * a jeśli nikt inny na nią nie czeka, połączenie jest przerywane. Ponowne żądanie tego samego czujnika
+      * w trakcie pobierania nie przerywa połączenia, lecz pozostaje przy żądaniu w toku.
       *
       * @param sensorId Identyfikator czujnika, dla którego mają zostać pobrane dane pomiarowe.
+      * @return int Identyfikator żądania.
       * @note Funkcja zwiększa licznik `nextRequestId` dla każdego nowego żądania.
       */
-     void fetchSensorData(int sensorId);
+     int fetchSensorData(int sensorId);
+
+     /**
+      * @brief Anuluje bieżące żądanie danego rodzaju (np. po zmianie zaznaczenia przez użytkownika).
+      *
+      * @param kind Rodzaj żądania.
+      */
+     void cancel(RequestKind kind);
+
+     /**
+      * @brief Wysyła pakiet żądań pobrania danych z podanych adresów URL.
+      *
+      * Nadaje identyfikator pakietu oraz identyfikatory żądań i przekazuje cały pakiet do obiektu `ApiWorker`
+      * jednym sygnałem `requestApiBatch`. Wyniki pakietu nie są przekazywane sygnałem `dataReady`, lecz
+      * sygnałami `batchItemReady` (dla każdego adresu) i `batchFinished` (po obsłużeniu wszystkich adresów),
+      * dzięki czemu pobieranie w tle nie wpływa na bieżący widok.
+      *
+      * @param urls Lista adresów URL.
+      * @param priority Klasa priorytetu żądań pakietu, domyślnie `RequestScheduler::Prefetch`.
+      * @return int Identyfikator pakietu lub -1, jeśli lista jest pusta.
+      */
+     int fetchBatch(const QVector<QUrl> &urls, RequestScheduler::Priority priority = RequestScheduler::Prefetch);
+
+     /**
+      * @brief Anuluje pakiet żądań (np. niepotrzebne już pobieranie z wyprzedzeniem).
+      *
+      * Żądania pakietu są odłączane od żądań sieciowych, a żądania sieciowe, na które nikt inny nie czeka,
+      * są przerywane. Dla anulowanego pakietu nie są emitowane sygnały `batchItemReady` ani `batchFinished`.
+      *
+      * @param batchId Identyfikator pakietu zwrócony przez `fetchBatch`.
+      */
+     void cancelBatch(int batchId);
+
+     /**
+      * @brief Zwraca ostatni stan połączenia z API zgłoszony przez monitor dostępności.
+      *
+      * @return bool Wartość true, jeśli API jest osiągalne.
+      */
+     bool isOnline() const;
+
+     /**
+      * @brief Zwraca ostatnie statystyki pamięci podręcznej odpowiedzi zgłoszone przez ApiWorker.
+      *
+      * @return ResponseCache::Stats Statystyki pamięci podręcznej.
+      */
+     ResponseCache::Stats cacheStats() const;
+
+     /**
+      * @brief Zwraca ostatnie statystyki kolejki żądań zgłoszone przez ApiWorker.
+      *
+      * @return RequestScheduler::Stats Głębokość kolejki i czas oczekiwania dla każdej klasy priorytetu.
+      */
+     RequestScheduler::Stats schedulerStats() const;
+
+     /**
+      * @brief Zwraca ostatnie statystyki czasu etapów żądań zgłoszone przez ApiWorker.
+      *
+      * @return RequestTiming::Stats Średnie czasy połączenia, pierwszego bajtu i transferu oraz udział ciepłych połączeń.
+      */
+     RequestTiming::Stats timingStats() const;
  
  signals:
      /**
       * @brief Sygnał emitowany, gdy dane z żądania API są gotowe.
       *
       * Przekazuje zwrócone dane w formacie QString do slotów podłączonych do tego sygnału (np. `MainWindow::onDataReady`).
+      * Sygnał jest emitowany osobno dla każdego żądania dołączonego do wspólnego żądania sieciowego.
       *
       * @param data Dane zwrócone w odpowiedzi na żądanie API.
+      * @param kind Rodzaj żądania.
+      * @param entityId Identyfikator encji (stacji lub czujnika), dla której zlecono żądanie.
       */
-     void dataReady(const QString &data);
+     void dataReady(const QString &data, ApiClient::RequestKind kind, int entityId);
+ 
+     /**
+      * @brief Sygnał emitowany, gdy API jest niedostępne, a zamiast błędu zwrócono nieświeżą odpowiedź z pamięci podręcznej.
+      *
+      * Dane mogą być wyświetlone (np. `MainWindow::onStaleDataReady`), ale nie powinny być zapisywane jako aktualne.
+      * Żądania pakietu otrzymują w takim przypadku błąd, aby pobieranie w tle nie zapisało nieświeżych danych.
+      *
+      * @param data Treść odpowiedzi z pamięci podręcznej.
+      * @param kind Rodzaj żądania.
+      * @param entityId Identyfikator encji (stacji lub czujnika), dla której zlecono żądanie.
+      */
+     void staleDataReady(const QString &data, ApiClient::RequestKind kind, int entityId);
  
      /**
       * @brief Sygnał emitowany, gdy wystąpi błąd podczas przetwarzania żądania API.
@@ -79,48 +197,203 @@
       * Przekazuje opis błędu w formacie QString do slotów podłączonych do tego sygnału (np. `MainWindow::onErrorOccurred`).
       *
       * @param error Opis błędu zwrócony przez `ApiWorker`.
+      * @param kind Rodzaj żądania.
+      * @param entityId Identyfikator encji (stacji lub czujnika), dla której zlecono żądanie.
       */
-     void errorOccurred(const QString &error);
+     void errorOccurred(const QString &error, ApiClient::RequestKind kind, int entityId);
  
      /**
       * @brief Sygnał emitowany w celu przekazania żądania API do ApiWorker.
       *
-      * Przekazuje adres URL oraz identyfikator żądania do slotu `ApiWorker::processRequest` w celu asynchronicznego
+      * Przekazuje adres URL oraz identyfikator żądania sieciowego do slotu `ApiWorker::processRequest` w celu asynchronicznego
       * przetworzenia.
       *
       * @param url Adres URL żądania API.
-      * @param requestId Identyfikator żądania.
+      * @param networkId Identyfikator żądania sieciowego.
+      * @param priority Klasa priorytetu żądania.
+      */
+     void requestApiData(const QUrl &url, int networkId, RequestScheduler::Priority priority);
+
+     /**
+      * @brief Sygnał emitowany w celu przekazania pakietu żądań API do ApiWorker.
+      *
+      * @param urls Adresy URL żądań.
+      * @param networkIds Identyfikatory żądań sieciowych (w tej samej kolejności co `urls`).
+      * @param priority Klasa priorytetu żądań.
       */
-     void requestApiData(const QUrl &url, int requestId);
+     void requestApiBatch(const QVector<QUrl> &urls, const QVector<int> &networkIds, RequestScheduler::Priority priority);
+
+     /**
+      * @brief Sygnał emitowany, gdy do żądania sieciowego w tle dołączyło żądanie o wyższym priorytecie.
+      *
+      * @param networkId Identyfikator żądania sieciowego.
+      * @param priority Nowa klasa priorytetu.
+      */
+     void promoteApiRequest(int networkId, RequestScheduler::Priority priority);
+
+     /**
+      * @brief Sygnał emitowany w celu przerwania żądania sieciowego, na którego wynik nikt już nie czeka.
+      *
+      * @param networkId Identyfikator żądania sieciowego.
+      */
+     void cancelApiRequest(int networkId);
+
+     /**
+      * @brief Sygnał emitowany po pobraniu danych dla jednego adresu z pakietu.
+      *
+      * @param batchId Identyfikator pakietu zwrócony przez `fetchBatch`.
+      * @param index Pozycja adresu URL w pakiecie.
+      * @param data Dane zwrócone w odpowiedzi na żądanie API.
+      */
+     void batchItemReady(int batchId, int index, const QString &data);
+
+     /**
+      * @brief Sygnał emitowany po obsłużeniu wszystkich żądań pakietu.
+      *
+      * @param batchId Identyfikator pakietu zwrócony przez `fetchBatch`.
+      * @param failedCount Liczba żądań zakończonych błędem.
+      */
+     void batchFinished(int batchId, int failedCount);
+
+     /**
+      * @brief Sygnał emitowany po ustaleniu pierwszego stanu połączenia z API i przy każdej jego zmianie.
+      *
+      * Stan jest ustalany w wątku roboczym przez `HealthMonitor` (sondy HEAD do serwera API oraz wyniki
+      * zwykłych żądań).
+      *
+      * @param online Wartość true, jeśli API jest osiągalne.
+      */
+     void connectivityChanged(bool online);
+
+     /**
+      * @brief Sygnał emitowany po odpowiedziach obsłużonych z udziałem pamięci podręcznej (najwyżej raz na klatkę).
+      *
+      * @param stats Bieżące statystyki pamięci podręcznej (trafienia, odpowiedzi 304, zaoszczędzone bajty).
+      */
+     void cacheStatsChanged(const ResponseCache::Stats &stats);
+
+     /**
+      * @brief Sygnał emitowany po zmianach stanu kolejki żądań w wątku roboczym (najwyżej raz na klatkę).
+      *
+      * @param stats Głębokość kolejki i czas oczekiwania dla każdej klasy priorytetu.
+      */
+     void schedulerStatsChanged(const RequestScheduler::Stats &stats);
+
+     /**
+      * @brief Sygnał emitowany po zakończonych odpowiedziach sieciowych w wątku roboczym (najwyżej raz na klatkę).
+      *
+      * @param stats Średnie czasy połączenia, pierwszego bajtu i transferu oraz udział ciepłych połączeń.
+      */
+     void timingStatsChanged(const RequestTiming::Stats &stats);
  
  private slots:
      /**
       * @brief Obsługuje wyniki żądania zwrócone przez ApiWorker.
       *
-      * Odbiera dane zwrócone przez `ApiWorker`, emituje sygnał `dataReady` z wynikami oraz usuwa identyfikator
-      * żądania z mapy `requestTypes`. Wyświetla informację debugującą z identyfikatorem bieżącego wątku.
+      * Odbiera dane zwrócone przez `ApiWorker` i dla każdego żądania oczekującego na to żądanie sieciowe emituje
+      * sygnał `dataReady` z wynikami (lub `batchItemReady`, jeśli żądanie należy do pakietu).
       *
       * @param result Dane zwrócone w odpowiedzi na żądanie API, w formacie QString.
-      * @param requestId Identyfikator żądania, dla którego zwrócono wyniki.
+      * @param networkId Identyfikator żądania sieciowego, dla którego zwrócono wyniki.
+      */
+     void handleResults(const QString &result, int networkId);
+ 
+     /**
+      * @brief Obsługuje nieświeżą odpowiedź z pamięci podręcznej zwróconą przez ApiWorker zamiast błędu.
+      *
+      * Dla każdego żądania oczekującego na to żądanie sieciowe emituje sygnał `staleDataReady`
+      * (lub zlicza błąd pakietu, jeśli żądanie należy do pakietu).
+      *
+      * @param result Treść odpowiedzi z pamięci podręcznej.
+      * @param networkId Identyfikator żądania sieciowego.
       */
-     void handleResults(const QString &result, int requestId);
+     void handleStaleResults(const QString &result, int networkId);
  
      /**
       * @brief Obsługuje błędy zgłoszone przez ApiWorker.
       *
-      * Odbiera opis błędu zwrócony przez `ApiWorker`, emituje sygnał `errorOccurred` oraz usuwa identyfikator
-      * żądania z mapy `requestTypes`.
+      * Odbiera opis błędu zwrócony przez `ApiWorker` i dla każdego żądania oczekującego na to żądanie sieciowe
+      * emituje sygnał `errorOccurred` (lub zlicza błąd pakietu, jeśli żądanie należy do pakietu).
       *
       * @param error Opis błędu zwrócony w odpowiedzi na żądanie API, w formacie QString.
-      * @param requestId Identyfikator żądania, dla którego zgłoszono błąd.
+      * @param networkId Identyfikator żądania sieciowego, dla którego zgłoszono błąd.
       */
-     void handleErrors(const QString &error, int requestId);
+     void handleErrors(const QString &error, int networkId);
+
+     /**
+      * @brief Planuje opróżnienie kanału wyników.
+      *
+      * Jeśli od poprzedniego opróżnienia minął co najmniej czas klatki, kanał jest opróżniany w najbliższym
+      * przebiegu pętli zdarzeń; w przeciwnym razie dopiero po upływie czasu klatki, więc wyniki napływające
+      * seriami są obsługiwane wspólnie.
+      */
+     void scheduleDrain();
+
+     /**
+      * @brief Obsługuje wszystkie wyniki oczekujące w kanale wyników.
+      *
+      * Dla każdego wyniku wywołuje `handleResults` lub `handleErrors`, w kolejności nadejścia, a następnie
+      * emituje zaległe sygnały zmiany statystyk.
+      */
+     void drainCompletions();
  
  private:
+     /**
+      * @brief Statystyki zgłoszone przez ApiWorker, które nie zostały jeszcze przekazane dalej.
+      */
+     enum PendingStats {
+         SchedulerStatsPending = 0x1,
+         TimingStatsPending = 0x2,
+         CacheStatsPending = 0x4
+     };
+
+     struct BatchItem {
+         int batchId;
+         int index;
+     };
+
+     struct BatchState {
+         int remaining;
+         int failed;
+     };
+
+     struct Waiter {
+         int requestId;
+         RequestKind kind;
+         int entityId;
+     };
+
+     struct InFlight {
+         QUrl url;
+         RequestScheduler::Priority priority;
+         QVector<Waiter> waiters;
+     };
+
+     int attach(const QUrl &url, const Waiter &waiter, RequestScheduler::Priority priority, bool sendNow = true);
+     int replaceCurrent(RequestKind kind, const QUrl &url, int entityId);
+     void detach(int requestId);
+     void completeBatchItem(int requestId, const QString *data);
+     void completeRequest(const QString &result, int networkId, bool stale);
+
+     ApiWorker::CompletionChannel completions;
      ApiWorker *worker;
      QThread workerThread;
+     QTimer drainTimer;
+     QElapsedTimer sinceDrain;
      int nextRequestId;
-     QMap<int, QString> requestTypes;
+     int nextBatchId;
+     int nextNetworkId;
+     bool online;
+     int pendingStats;
+     ResponseCache::Stats lastCacheStats;
+     RequestScheduler::Stats lastSchedulerStats;
+     RequestTiming::Stats lastTimingStats;
+     QHash<int, InFlight> inFlight;
+     QHash<QUrl, int> inFlightByUrl;
+     QHash<int, int> networkIdForRequest;
+     QHash<int, int> currentRequest;
+     QHash<int, BatchItem> batchItems;
+     QHash<int, BatchState> batches;
  };
  
  #endif
@@ -0,0 +1,115 @@
+/**
+ * @file apiendpoints.cpp
+ * @brief Implementacja klasy ApiEndpoints - adresów punktów końcowych API GIOS.
+ */
+
+#include "apiendpoints.h"
+
+#include <QUrlQuery>
+
+namespace {
+/** Adres bazowy publicznego API GIOS. */
+const char *const DefaultBaseUrl = "https://api.gios.gov.pl/pjp-api/rest/";
+
+/**
+ * @brief Zwraca adres z dodanym końcowym znakiem '/', aby względne ścieżki dołączały się do niego.
+ */
+QUrl withTrailingSlash(QUrl url) {
+    if (!url.path().endsWith('/')) {
+        url.setPath(url.path() + '/');
+    }
+    return url;
+}
+
+/**
+ * @brief Zwraca adres bazowy wczytany przy pierwszym użyciu (zmienna środowiskowa lub adres domyślny).
+ */
+QUrl &configuredBaseUrl() {
+    static QUrl url = [] {
+        const QUrl fromEnvironment(qEnvironmentVariable("MJP_API_BASE_URL"));
+        if (fromEnvironment.isValid() && (fromEnvironment.scheme() == "http" || fromEnvironment.scheme() == "https")) {
+            return withTrailingSlash(fromEnvironment);
+        }
+        return QUrl(DefaultBaseUrl);
+    }();
+    return url;
+}
+}
+
+/**
+ * @brief Zwraca adres bazowy API (zakończony znakiem '/').
+ *
+ * @return QUrl Adres bazowy API.
+ */
+QUrl ApiEndpoints::baseUrl() {
+    return configuredBaseUrl();
+}
+
+/**
+ * @brief Ustawia adres bazowy API.
+ *
+ * @param url Adres bazowy API; brakujący końcowy znak '/' jest dodawany.
+ * @return bool Wartość true, jeśli adres jest poprawnym adresem HTTP lub HTTPS.
+ */
+bool ApiEndpoints::setBaseUrl(const QUrl &url) {
+    if (!url.isValid() || (url.scheme() != "http" && url.scheme() != "https")) {
+        return false;
+    }
+    configuredBaseUrl() = withTrailingSlash(url);
+    return true;
+}
+
+/**
+ * @brief Zwraca adres listy wszystkich stacji (`station/findAll`).
+ */
+QUrl ApiEndpoints::stations() {
+    return resolve("station/findAll");
+}
+
+/**
+ * @brief Zwraca adres listy czujników stacji (`station/sensors/<stationId>`).
+ *
+ * @param stationId Identyfikator stacji.
+ */
+QUrl ApiEndpoints::sensors(int stationId) {
+    return resolve(QString("station/sensors/%1").arg(stationId));
+}
+
+/**
+ * @brief Zwraca adres danych pomiarowych czujnika (`data/getData/<sensorId>`).
+ *
+ * @param sensorId Identyfikator czujnika.
+ */
+QUrl ApiEndpoints::measurements(int sensorId) {
+    return resolve(QString("data/getData/%1").arg(sensorId));
+}
+
+/**
+ * @brief Zwraca adres strony archiwalnych danych pomiarowych czujnika (`archivalData/getDataBySensor/<sensorId>`).
+ *
+ * Zakres dat jest przekazywany w parametrach `dateFrom` i `dateTo` w formacie "yyyy-MM-dd HH:mm",
+ * a stronicowanie w parametrach `page` i `size`.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @param from Początek zakresu dat.
+ * @param to Koniec zakresu dat.
+ * @param page Numer strony (od 0).
+ * @param pageSize Liczba pomiarów na stronie.
+ */
+QUrl ApiEndpoints::archivalMeasurements(int sensorId, const QDateTime &from, const QDateTime &to, int page, int pageSize) {
+    QUrl url = resolve(QString("archivalData/getDataBySensor/%1").arg(sensorId));
+    QUrlQuery query;
+    query.addQueryItem("dateFrom", from.toString("yyyy-MM-dd HH:mm"));
+    query.addQueryItem("dateTo", to.toString("yyyy-MM-dd HH:mm"));
+    query.addQueryItem("page", QString::number(page));
+    query.addQueryItem("size", QString::number(pageSize));
+    url.setQuery(query);
+    return url;
+}
+
+/**
+ * @brief Dołącza ścieżkę względną do adresu bazowego API.
+ */
+QUrl ApiEndpoints::resolve(const QString &path) {
+    return configuredBaseUrl().resolved(QUrl(path));
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ * @file apiendpoints.h
+ * @brief Definicja klasy ApiEndpoints - adresów punktów końcowych API GIOS.
+ */
+
+#ifndef APIENDPOINTS_H
+#define APIENDPOINTS_H
+
+#include <QDateTime>
+#include <QString>
+#include <QUrl>
+
+class ApiEndpoints
+{
+public:
+    /**
+     * @brief Zwraca adres bazowy API (zakończony znakiem '/').
+     *
+     * Domyślnie `https://api.gios.gov.pl/pjp-api/rest/`; może zostać zmieniony zmienną środowiskową
+     * `MJP_API_BASE_URL` lub metodą `setBaseUrl` (np. na adres lokalnego serwera testowego).
+     *
+     * @return QUrl Adres bazowy API.
+     */
+    static QUrl baseUrl();
+
+    /**
+     * @brief Ustawia adres bazowy API.
+     *
+     * Należy ją wywołać przed utworzeniem pierwszego obiektu `ApiClient`; adres jest potem tylko
+     * odczytywany (także z wątku roboczego), więc nie wymaga synchronizacji.
+     *
+     * @param url Adres bazowy API; brakujący końcowy znak '/' jest dodawany.
+     * @return bool Wartość true, jeśli adres jest poprawnym adresem HTTP lub HTTPS.
+     */
+    static bool setBaseUrl(const QUrl &url);
+
+    /**
+     * @brief Zwraca adres listy wszystkich stacji (`station/findAll`).
+     */
+    static QUrl stations();
+
+    /**
+     * @brief Zwraca adres listy czujników stacji (`station/sensors/<stationId>`).
+     *
+     * @param stationId Identyfikator stacji.
+     */
+    static QUrl sensors(int stationId);
+
+    /**
+     * @brief Zwraca adres danych pomiarowych czujnika (`data/getData/<sensorId>`).
+     *
+     * @param sensorId Identyfikator czujnika.
+     */
+    static QUrl measurements(int sensorId);
+
+    /**
+     * @brief Zwraca adres strony archiwalnych danych pomiarowych czujnika (`archivalData/getDataBySensor/<sensorId>`).
+     *
+     * @param sensorId Identyfikator czujnika.
+     * @param from Początek zakresu dat.
+     * @param to Koniec zakresu dat.
+     * @param page Numer strony (od 0).
+     * @param pageSize Liczba pomiarów na stronie.
+     */
+    static QUrl archivalMeasurements(int sensorId, const QDateTime &from, const QDateTime &to, int page, int pageSize);
+
+private:
+    static QUrl resolve(const QString &path);
+};
+
+#endif
\ No newline at end of file
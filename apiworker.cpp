@@ -4,6 +4,44 @@
  */
 
 #include "apiworker.h"
+#include "apiendpoints.h"
+#include "healthmonitor.h"
+#include "tracing.h"
+
+#include <QRandomGenerator>
+#ifndef QT_NO_SSL
+#include <QSslConfiguration>
+#endif
+
+namespace {
+/** Maksymalny czas przesyłania odpowiedzi bez postępu (ms), po którym żądanie jest przerywane. */
+constexpr int TransferTimeout = 10000;
+/** Maksymalna liczba prób żądania interaktywnego (użytkownik czeka na wynik). */
+constexpr int MaxInteractiveAttempts = 2;
+/** Maksymalna liczba prób żądania pobieranego w tle. */
+constexpr int MaxBackgroundAttempts = 4;
+/** Najkrótsze opóźnienie ponowienia (ms). */
+constexpr int BaseRetryDelay = 500;
+/** Najdłuższe opóźnienie ponowienia (ms); dłuższy nagłówek Retry-After kończy żądanie błędem. */
+constexpr int MaxRetryDelay = 10000;
+/** Opis błędu żądania odrzuconego przez otwarty bezpiecznik. */
+const char *const BreakerOpenError = "API chwilowo niedostępne (zbyt wiele błędów)";
+
+/** Nazwy klas priorytetu w etykietach metryk (w kolejności `RequestScheduler::Priority`). */
+const char *const PriorityLabels[RequestScheduler::PriorityCount] = {"interactive", "prefetch", "backfill"};
+
+/** Licznik bajtów pobranych z API. */
+Metrics::Counter &downloadedBytes() {
+    static Metrics::Counter &counter = Metrics::counter("mjp_http_downloaded_bytes_total", "Bajty pobrane z API (po rozpakowaniu)");
+    return counter;
+}
+
+/** Licznik odpowiedzi o podanym wyniku pamięci podręcznej; wynik należy zapamiętać w zmiennej statycznej. */
+Metrics::Counter &cacheLookups(const char *result) {
+    return Metrics::counter("mjp_cache_lookups_total", "Odpowiedzi według wyniku pamięci podręcznej (hit, revalidated, miss)",
+                            Metrics::label("result", result));
+}
+}
 
 /**
  * @brief Konstruktor klasy ApiWorker.
@@ -13,11 +51,21 @@
  * 
  * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
  */
-ApiWorker::ApiWorker(QObject *parent) : QObject(parent)
+ApiWorker::ApiWorker(QObject *parent) : QObject(parent), manager(nullptr), healthMonitor(nullptr), completions(nullptr), scheduler(nullptr)
 {
     //qDebug() << "ApiWorker constructor - thread:" << QThread::currentThreadId();
 }
 
+/**
+ * @brief Ustawia kanał, którym wyniki żądań są przekazywane zamiast sygnałów `resultReady` i `errorOccurred`.
+ * 
+ * @param channel Wskaźnik na kanał wyników lub nullptr.
+ */
+void ApiWorker::setCompletionChannel(CompletionChannel *channel)
+{
+    completions = channel;
+}
+
 /**
  * @brief Destruktor klasy ApiWorker.
  * 
@@ -28,41 +76,402 @@ ApiWorker::~ApiWorker() {}
 /**
  * @brief Przetwarza żądanie sieciowe dla podanego adresu URL.
  * 
- * Tworzy obiekt QNetworkRequest z podanym adresem URL, ustawia nagłówek User-Agent na "MJP" 
- * i wysyła żądanie GET za pomocą QNetworkAccessManager. Przechowuje mapowanie odpowiedzi 
- * na identyfikator żądania w replyToRequestId.
+ * Jeśli w pamięci podręcznej (`ResponseCache`) jest odpowiedź, której termin ważności wynikający z polityki 
+ * dla danego punktu końcowego jeszcze nie minął, od razu przekazuje jej treść jako wynik (`deliver`). 
+ * W przeciwnym razie tworzy obiekt QNetworkRequest z podanym adresem URL, ustawia nagłówek User-Agent na "MJP", 
+ * a dla nieświeżej odpowiedzi z pamięci podręcznej także nagłówki If-None-Match i If-Modified-Since. 
+ * Nagłówek Accept-Encoding nie jest ustawiany ręcznie: QNetworkAccessManager sam negocjuje kompresję 
+ * (gzip i deflate, a w Qt 6.7+ zbudowanym z odpowiednimi bibliotekami także brotli i zstd) i rozpakowuje 
+ * odpowiedź. Żądanie może zostać wysłane przez HTTP/2 (w Qt 5.15 domyślnie wyłączone), dzięki czemu 
+ * wiele małych żądań czujników i pomiarów korzysta z jednego połączenia. 
+ * Ustawia limit czasu przesyłania (`TransferTimeout`), zapamiętuje żądanie na potrzeby ponowień 
+ * i przekazuje je do `dispatch`, który dodaje je do kolejki `RequestScheduler` z podaną klasą priorytetu. 
+ * Żądanie zostanie wysłane w `startRequest`, gdy pozwolą na to limity kolejki.
  * 
  * @param url Adres URL, z którego mają zostać pobrane dane.
  * @param requestId Identyfikator żądania.
+ * @param priority Klasa priorytetu żądania.
  */
-void ApiWorker::processRequest(const QUrl &url, int requestId)
+void ApiWorker::processRequest(const QUrl &url, int requestId, RequestScheduler::Priority priority)
 {
+    MJP_TRACE_SCOPE_ID("ApiWorker::processRequest", requestId);
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::UserAgentHeader, "MJP");
+    request.setTransferTimeout(TransferTimeout);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+
+    ResponseCache::Entry cached;
+    if (cache.lookup(url, &cached)) {
+        if (cached.expiresAt > QDateTime::currentDateTimeUtc()) {
+            static Metrics::Counter &hits = cacheLookups("hit");
+            hits.add();
+            cache.recordHit(cached.body.size());
+            emit cacheStatsChanged(cache.stats());
+            deliver(requestId, QString::fromUtf8(cached.body), false);
+            return;
+        }
+        if (!cached.etag.isEmpty()) {
+            request.setRawHeader("If-None-Match", cached.etag);
+        }
+        if (!cached.lastModified.isEmpty()) {
+            request.setRawHeader("If-Modified-Since", cached.lastModified);
+        }
+    }
+
+    PendingRequest entry;
+    entry.request = request;
+    entry.priority = priority;
+    pending.insert(requestId, entry);
+    dispatch(requestId);
+}
 
+/**
+ * @brief Dodaje zapamiętane żądanie do kolejki `RequestScheduler`, jeśli pozwala na to bezpiecznik.
+ * 
+ * Gdy bezpiecznik rodziny punktów końcowych jest otwarty, żądanie kończy się od razu (`fail`) 
+ * bez połączenia z serwerem, więc przeciążone API nie otrzymuje kolejnych żądań, a interfejs nie czeka. 
+ * Żądanie dopuszczone przy półotwartym bezpieczniku jest żądaniem próbnym (`trial`). Bezpiecznik jest 
+ * sprawdzany ponownie przy wysyłaniu (`startRequest`), bo żądanie może długo czekać w kolejce.
+ * 
+ * @param requestId Identyfikator żądania.
+ */
+void ApiWorker::dispatch(int requestId)
+{
+    auto it = pending.find(requestId);
+    if (it == pending.end()) {
+        return;
+    }
+    const QString family = CircuitBreaker::familyFor(it->request.url());
+    const bool probing = breaker.state(family) != CircuitBreaker::Closed;
+    if (!breaker.allowRequest(family)) {
+        fail(requestId, BreakerOpenError);
+        return;
+    }
+    it->trial = probing;
+    it->attempt++;
+    scheduler->enqueue(it->request, requestId, it->priority);
+}
+
+/**
+ * @brief Planuje ponowienie żądania zakończonego błędem przejściowym.
+ * 
+ * Opóźnienie jest losowane według schematu "decorrelated jitter": z przedziału od `BaseRetryDelay` 
+ * do trzykrotności poprzedniego opóźnienia, nie więcej niż `MaxRetryDelay`. Losowość rozprasza ponowienia 
+ * wielu żądań, które zakończyły się błędem w tej samej chwili. Nagłówek Retry-After (w sekundach) wydłuża 
+ * opóźnienie. Żądanie nie jest ponawiane po wyczerpaniu liczby prób dla jego klasy priorytetu, przy 
+ * otwartym bezpieczniku ani gdy serwer żąda dłuższej przerwy niż `MaxRetryDelay`.
+ * 
+ * @param requestId Identyfikator żądania.
+ * @param reply Wskaźnik na odpowiedź zakończoną błędem.
+ * @return bool Wartość true, jeśli zaplanowano ponowienie.
+ */
+bool ApiWorker::retryLater(int requestId, QNetworkReply *reply)
+{
+    auto it = pending.find(requestId);
+    if (it == pending.end()) {
+        return false;
+    }
+    const int maxAttempts = it->priority == RequestScheduler::Interactive ? MaxInteractiveAttempts : MaxBackgroundAttempts;
+    if (it->attempt >= maxAttempts || breaker.state(CircuitBreaker::familyFor(it->request.url())) == CircuitBreaker::Open) {
+        return false;
+    }
+
+    const int upper = qMax(BaseRetryDelay, it->lastDelay * 3);
+    int delay = qMin(MaxRetryDelay, QRandomGenerator::global()->bounded(BaseRetryDelay, upper + 1));
+    bool hasRetryAfter = false;
+    const int retryAfter = reply->rawHeader("Retry-After").toInt(&hasRetryAfter);
+    if (hasRetryAfter) {
+        if (retryAfter * 1000 > MaxRetryDelay) {
+            return false;
+        }
+        delay = qMax(delay, retryAfter * 1000);
+    }
+    it->lastDelay = delay;
+
+    QTimer *timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, &QTimer::timeout, this, [this, requestId, timer]() {
+        timer->deleteLater();
+        auto it = pending.find(requestId);
+        if (it != pending.end()) {
+            it->retryTimer = nullptr;
+            dispatch(requestId);
+        }
+    });
+    it->retryTimer = timer;
+    timer->start(delay);
+    return true;
+}
+
+/**
+ * @brief Kończy żądanie, które nie może zostać wysłane lub ponowione.
+ * 
+ * Jeśli w pamięci podręcznej jest odpowiedź na to żądanie (nawet nieświeża), przekazuje jej treść jako wynik 
+ * oznaczony jako nieświeży (`Completion::stale`), aby przy niedostępnym API wyświetlić ostatnie znane dane 
+ * i poinformować o tym użytkownika. W przeciwnym razie przekazuje błąd.
+ * 
+ * @param requestId Identyfikator żądania.
+ * @param error Opis błędu.
+ */
+void ApiWorker::fail(int requestId, const QString &error)
+{
+    const PendingRequest request = pending.take(requestId);
+    ResponseCache::Entry cached;
+    if (!request.request.url().isEmpty() && cache.lookup(request.request.url(), &cached)) {
+        deliver(requestId, QString::fromUtf8(cached.body), false, true);
+    } else {
+        deliver(requestId, error, true);
+    }
+}
+
+/**
+ * @brief Przekazuje wynik żądania do wątku interfejsu.
+ * 
+ * Wynik jest dodawany do kanału wyników (`CompletionChannel`) bez blokady; sygnał `completionsAvailable` 
+ * jest emitowany tylko dla pierwszego wyniku od ostatniego opróżnienia kanału, więc przy masowym pobieraniu 
+ * do pętli zdarzeń wątku interfejsu trafia jedno zdarzenie zamiast jednego na każdą odpowiedź. 
+ * Bez kanału lub gdy kanał jest pełny wynik jest przekazywany sygnałem `resultReady`, `staleResultReady` 
+ * albo `errorOccurred`, więc nie jest nigdy gubiony, a wątek roboczy nie czeka na wątek interfejsu. 
+ * 
+ * @param requestId Identyfikator żądania.
+ * @param payload Treść odpowiedzi lub opis błędu.
+ * @param error Wartość true, jeśli `payload` jest opisem błędu.
+ * @param stale Wartość true, jeśli `payload` jest nieświeżą odpowiedzią z pamięci podręcznej.
+ */
+void ApiWorker::deliver(int requestId, const QString &payload, bool error, bool stale)
+{
+    if (completions && completions->queue.push({requestId, error, stale, payload})) {
+        if (!completions->wakePending.exchange(true)) {
+            emit completionsAvailable();
+        }
+        return;
+    }
+
+    if (completions) {
+        static Metrics::Counter &overflows = Metrics::counter("mjp_completion_queue_overflows_total",
+                                                              "Wyniki przekazane sygnałem z powodu pełnego kanału wyników");
+        overflows.add();
+    }
+    if (error) {
+        emit errorOccurred(payload, requestId);
+    } else if (stale) {
+        emit staleResultReady(payload, requestId);
+    } else {
+        emit resultReady(payload, requestId);
+    }
+}
+
+/**
+ * @brief Sprawdza, czy odpowiedź zakończyła się błędem przejściowym, po którym warto ponowić żądanie.
+ * 
+ * Błędami przejściowymi są odpowiedzi 429 i 5xx, przekroczenie limitu czasu (przerwanie przez 
+ * `setTransferTimeout` daje OperationCanceledError; żądania anulowane przez użytkownika są obsługiwane 
+ * wcześniej) oraz zerwane lub odrzucone połączenia.
+ * 
+ * @param reply Wskaźnik na odpowiedź.
+ * @return bool Wartość true, jeśli błąd jest przejściowy.
+ */
+bool ApiWorker::isTransient(QNetworkReply *reply)
+{
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 429 || status >= 500) {
+        return true;
+    }
+    switch (reply->error()) {
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::OperationCanceledError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyTimeoutError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Wysyła żądanie zwolnione z kolejki przez `RequestScheduler`.
+ * 
+ * Ponownie sprawdza bezpiecznik rodziny punktów końcowych: jeśli otworzył się, gdy żądanie czekało 
+ * w kolejce (zwykle żądania w tle), żądanie kończy się od razu (`fail`), a miejsce w `RequestScheduler` 
+ * jest zwalniane w kolejnym przebiegu pętli zdarzeń (bez rekurencji przy długiej kolejce). 
+ * W przeciwnym razie wysyła żądanie GET za pomocą QNetworkAccessManager, przechowuje mapowanie odpowiedzi 
+ * na identyfikator żądania w replyToRequestId i rozpoczyna pomiar czasu etapów żądania (`RequestTiming`).
+ * 
+ * @param request Żądanie sieciowe.
+ * @param requestId Identyfikator żądania.
+ */
+void ApiWorker::startRequest(const QNetworkRequest &request, int requestId)
+{
+    auto it = pending.find(requestId);
+    if (it != pending.end() && !it->trial) {
+        const QString family = CircuitBreaker::familyFor(request.url());
+        const bool probing = breaker.state(family) != CircuitBreaker::Closed;
+        if (!breaker.allowRequest(family)) {
+            const QUrl url = request.url();
+            QMetaObject::invokeMethod(scheduler, [this, url]() {
+                scheduler->requestFinished(url);
+            }, Qt::QueuedConnection);
+            fail(requestId, BreakerOpenError);
+            return;
+        }
+        it->trial = probing;
+    }
+
+    MJP_TRACE_ASYNC_BEGIN("network", requestId);
     QNetworkReply *reply = manager->get(request);
     replyToRequestId[reply] = requestId;
+    timing.track(reply);
+}
+
+/**
+ * @brief Przetwarza pakiet żądań sieciowych.
+ * 
+ * Wywołuje `processRequest` dla każdej pary (adres URL, identyfikator żądania) z pakietu. 
+ * Żądania trafiają do kolejki z podaną klasą priorytetu, więc pakiet pobierany w tle nie opóźnia 
+ * żądań interaktywnych.
+ * 
+ * @param urls Adresy URL żądań.
+ * @param requestIds Identyfikatory żądań (w tej samej kolejności co `urls`).
+ * @param priority Klasa priorytetu żądań.
+ */
+void ApiWorker::processBatch(const QVector<QUrl> &urls, const QVector<int> &requestIds, RequestScheduler::Priority priority)
+{
+    for (int i = 0; i < urls.size() && i < requestIds.size(); ++i) {
+        processRequest(urls.at(i), requestIds.at(i), priority);
+    }
+}
+
+/**
+ * @brief Przenosi oczekujące w kolejce żądanie do wyższej klasy priorytetu.
+ * 
+ * @param requestId Identyfikator żądania.
+ * @param priority Nowa klasa priorytetu.
+ */
+void ApiWorker::promoteRequest(int requestId, RequestScheduler::Priority priority)
+{
+    scheduler->promote(requestId, priority);
+}
+
+/**
+ * @brief Przerywa żądanie sieciowe o podanym identyfikatorze.
+ * 
+ * Żądanie oczekujące na ponowienie lub w kolejce jest usuwane (żądanie próbne zwalnia przy tym bezpiecznik). 
+ * W przeciwnym razie wyszukuje odpowiedź przypisaną do identyfikatora i wywołuje `abort()`, co zamyka 
+ * transfer i kończy odpowiedź błędem OperationCanceledError; usunięcie żądania z `pending` odróżnia 
+ * je od przekroczenia limitu czasu. Identyfikator przerwanego żądania próbnego jest zapamiętywany 
+ * w `cancelledTrials`, aby bezpiecznik zwolniło tylko ono, a nie każde anulowane żądanie tej rodziny. Żądania obsłużone już z pamięci podręcznej lub zakończone są pomijane.
+ * 
+ * @param requestId Identyfikator żądania.
+ */
+void ApiWorker::cancelRequest(int requestId)
+{
+    const PendingRequest request = pending.take(requestId);
+    if (request.retryTimer) {
+        delete request.retryTimer;
+        return;
+    }
+    if (scheduler->cancel(requestId)) {
+        if (request.trial) {
+            breaker.releaseTrial(CircuitBreaker::familyFor(request.request.url()));
+        }
+        return;
+    }
+    for (auto it = replyToRequestId.begin(); it != replyToRequestId.end(); ++it) {
+        if (it.value() == requestId) {
+            if (request.trial) {
+                cancelledTrials.insert(requestId);
+            }
+            it.key()->abort();
+            return;
+        }
+    }
 }
 
 /**
  * @brief Obsługuje zakończenie odpowiedzi sieciowej.
  * 
- * Sprawdza, czy odpowiedź nie zawiera błędu. Jeśli brak błędu, odczytuje dane, konwertuje je na QString 
- * i emituje sygnał resultReady. W przypadku błędu emituje sygnał errorOccurred z opisem błędu. 
+ * Odpowiedzi, które nie należą do żądań API (np. sondy monitora dostępności), są pomijane. Wynik każdego 
+ * żądania jest zgłaszany do `HealthMonitor`, który na tej podstawie pomija zbędne sondy, a jego zakończenie 
+ * do `RequestScheduler`, który zwalnia miejsce dla kolejnych żądań. Czasy etapów żądania są doliczane 
+ * do statystyk (`timingStatsChanged`). 
+ * Błąd przejściowy (`isTransient`) jest zapisywany w bezpieczniku rodziny punktów końcowych, a żądanie 
+ * jest ponawiane (`retryLater`) lub kończone (`fail`); każda inna odpowiedź zamyka bezpiecznik. 
+ * Odpowiedź 304 (Not Modified) przedłuża ważność wpisu pamięci podręcznej i przekazuje jego treść jako wynik. 
+ * Jeśli odpowiedź nie zawiera błędu, odczytuje dane, zapisuje je w pamięci podręcznej razem z nagłówkami 
+ * ETag i Last-Modified, konwertuje je na QString i przekazuje jako wynik (`deliver`). 
+ * W przypadku błędu przekazuje opis błędu. 
  * Następnie usuwa odpowiedź i jej mapowanie oraz emituje sygnał finished, jeśli nie ma więcej oczekujących odpowiedzi.
  * 
  * @param reply Wskaźnik na obiekt QNetworkReply zawierający odpowiedź sieciową.
  */
 void ApiWorker::onReplyFinished(QNetworkReply *reply)
 {
-    int requestId = replyToRequestId.value(reply, -1);
+    auto it = replyToRequestId.find(reply);
+    if (it == replyToRequestId.end()) {
+        return;
+    }
+    int requestId = it.value();
+    MJP_TRACE_ASYNC_END("network", requestId);
+    MJP_TRACE_SCOPE_ID("ApiWorker::onReplyFinished", requestId);
+    const RequestTiming::Phases phases = timing.finish(reply);
+    emit timingStatsChanged(timing.stats());
+    healthMonitor->reportReply(reply);
+    scheduler->requestFinished(reply->request().url());
+
+    const QUrl url = reply->request().url();
+    const QString family = CircuitBreaker::familyFor(url);
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    ResponseCache::Entry cached;
+
+    EndpointMetrics &metrics = metricsFor(family);
+    if (phases.total >= 0) {
+        metrics.latency->record(phases.total);
+    }
+    metrics.responses->add();
+    if (reply->error() != QNetworkReply::NoError) {
+        metrics.errors->add();
+    }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray bytes = reply->readAll();
-        QString response = QString::fromUtf8(bytes);
-        emit resultReady(response, requestId);
+    if (!pending.contains(requestId)) {
+        if (cancelledTrials.remove(requestId)) {
+            breaker.releaseTrial(family);
+        }
+        deliver(requestId, reply->errorString(), true);
+    } else if (isTransient(reply)) {
+        breaker.recordFailure(family);
+        if (!retryLater(requestId, reply)) {
+            fail(requestId, reply->errorString());
+        }
     } else {
-        emit errorOccurred(reply->errorString(), requestId);
+        breaker.recordSuccess(family);
+        pending.remove(requestId);
+
+        if (status == 304) {
+            if (cache.refresh(url, &cached)) {
+                static Metrics::Counter &revalidated = cacheLookups("revalidated");
+                revalidated.add();
+                cache.recordRevalidation(cached.body.size());
+                emit cacheStatsChanged(cache.stats());
+                deliver(requestId, QString::fromUtf8(cached.body), false);
+            } else {
+                deliver(requestId, "Brak odpowiedzi w pamięci podręcznej", true);
+            }
+        } else if (reply->error() == QNetworkReply::NoError) {
+            QByteArray bytes = reply->readAll();
+            static Metrics::Counter &misses = cacheLookups("miss");
+            misses.add();
+            downloadedBytes().add(bytes.size());
+            cache.store(url, bytes, reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"));
+            cache.recordMiss(bytes.size());
+            emit cacheStatsChanged(cache.stats());
+            QString response = QString::fromUtf8(bytes);
+            deliver(requestId, response, false);
+        } else {
+            deliver(requestId, reply->errorString(), true);
+        }
     }
 
     reply->deleteLater();
@@ -78,10 +487,96 @@ void ApiWorker::onReplyFinished(QNetworkReply *reply)
  * @brief Inicjalizuje obiekt ApiWorker.
  * 
  * Tworzy nowy obiekt QNetworkAccessManager i łączy sygnał finished z slotem onReplyFinished, 
- * umożliwiając obsługę odpowiedzi sieciowych. Wypisuje informację debugującą z identyfikatorem bieżącego wątku.
+ * umożliwiając obsługę odpowiedzi sieciowych. Tworzy kolejkę priorytetową żądań (`RequestScheduler`). Tworzy i uruchamia monitor dostępności API (`HealthMonitor`), 
+ * który wysyła sondy przez ten sam menedżer, a jego sygnał `connectivityChanged` przekazuje dalej. Sondy co 30 s 
+ * utrzymują połączenie z serwerem API w puli menedżera, a po każdym przejściu w tryb online połączenie jest 
+ * zestawiane z wyprzedzeniem (`warmUp`). Wypisuje informację debugującą z identyfikatorem bieżącego wątku.
  */
 void ApiWorker::init() {
     manager = new QNetworkAccessManager(this);
     connect(manager, &QNetworkAccessManager::finished, this, &ApiWorker::onReplyFinished);
+
+    scheduler = new RequestScheduler(this);
+    connect(scheduler, &RequestScheduler::ready, this, &ApiWorker::startRequest);
+    connect(scheduler, &RequestScheduler::statsChanged, this, &ApiWorker::schedulerStatsChanged);
+    connect(scheduler, &RequestScheduler::statsChanged, this, &ApiWorker::updateQueueMetrics);
+
+    healthMonitor = new HealthMonitor(manager, this);
+    connect(healthMonitor, &HealthMonitor::connectivityChanged, this, &ApiWorker::connectivityChanged);
+    connect(healthMonitor, &HealthMonitor::connectivityChanged, this, [this](bool online) {
+        if (online) {
+            warmUp();
+        }
+    });
+    healthMonitor->start();
+    warmUp();
     //qDebug() << "ApiWorker::init() — thread:" << QThread::currentThreadId();
 }
+
+/**
+ * @brief Zwraca metryki rodziny punktów końcowych, rejestrując je przy pierwszej odpowiedzi z tej rodziny.
+ * 
+ * Wskaźniki są zapamiętywane w `endpointMetrics` (używanym tylko w wątku roboczym), więc kolejne odpowiedzi 
+ * aktualizują metryki bez blokady rejestru.
+ * 
+ * @param family Rodzina punktów końcowych.
+ * @return EndpointMetrics& Metryki rodziny.
+ */
+ApiWorker::EndpointMetrics &ApiWorker::metricsFor(const QString &family)
+{
+    auto it = endpointMetrics.find(family);
+    if (it == endpointMetrics.end()) {
+        const QString labels = Metrics::label("endpoint", family);
+        EndpointMetrics metrics;
+        metrics.latency = &Metrics::histogram("mjp_http_request_duration_milliseconds", "Czas żądania API od wysłania do końca odpowiedzi", labels);
+        metrics.responses = &Metrics::counter("mjp_http_responses_total", "Zakończone odpowiedzi API (także błędy i ponowienia)", labels);
+        metrics.errors = &Metrics::counter("mjp_http_errors_total", "Odpowiedzi API zakończone błędem", labels);
+        it = endpointMetrics.insert(family, metrics);
+    }
+    return it.value();
+}
+
+/**
+ * @brief Aktualizuje metryki głębokości kolejki żądań dla każdej klasy priorytetu i liczby wysłanych żądań.
+ * 
+ * @param stats Bieżące statystyki kolejki.
+ */
+void ApiWorker::updateQueueMetrics(const RequestScheduler::Stats &stats)
+{
+    static const QVector<Metrics::Gauge *> queued = [] {
+        QVector<Metrics::Gauge *> gauges;
+        for (int priority = 0; priority < RequestScheduler::PriorityCount; ++priority) {
+            gauges.append(&Metrics::gauge("mjp_request_queue_depth", "Żądania oczekujące w kolejce",
+                                          Metrics::label("priority", PriorityLabels[priority])));
+        }
+        return gauges;
+    }();
+    static Metrics::Gauge &active = Metrics::gauge("mjp_requests_in_flight", "Żądania wysłane i oczekujące na odpowiedź");
+
+    for (int priority = 0; priority < RequestScheduler::PriorityCount; ++priority) {
+        queued.at(priority)->set(stats.queued[priority]);
+    }
+    active.set(stats.active);
+}
+
+/**
+ * @brief Zestawia z wyprzedzeniem szyfrowane połączenie z serwerem API.
+ * 
+ * Połączenie z hostem adresu bazowego API (`ApiEndpoints::baseUrl`) trafia do puli QNetworkAccessManager, 
+ * więc pierwsze żądanie użytkownika nie czeka na rozwiązanie nazwy, połączenie TCP i uzgodnienie TLS. 
+ * Konfiguracja TLS zgłasza w ALPN protokół HTTP/2, aby zestawione połączenie mogło zostać użyte przez 
+ * żądania HTTP/2. Dla adresu HTTP (np. lokalnego serwera testowego) zestawiane jest zwykłe połączenie TCP.
+ */
+void ApiWorker::warmUp()
+{
+    const QUrl base = ApiEndpoints::baseUrl();
+#ifndef QT_NO_SSL
+    if (base.scheme() == "https") {
+        QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+        configuration.setAllowedNextProtocols({QSslConfiguration::ALPNProtocolHTTP2, QSslConfiguration::NextProtocolHttp1_1});
+        manager->connectToHostEncrypted(base.host(), base.port(443), configuration);
+        return;
+    }
+#endif
+    manager->connectToHost(base.host(), base.port(80));
+}
\ No newline at end of file
@@ -9,14 +9,53 @@
 #include <QObject>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QHash>
 #include <QMap>
+#include <QSet>
+#include <QVector>
 #include <QThread>
+#include <QTimer>
+#include <atomic>
+#include "circuitbreaker.h"
+#include "metrics.h"
+#include "requestscheduler.h"
+#include "requesttiming.h"
+#include "responsecache.h"
+#include "spscqueue.h"
+
+class HealthMonitor;
 
 class ApiWorker : public QObject
 {
     Q_OBJECT
 
 public:
+    /**
+     * @brief Wynik żądania (odpowiedź lub opis błędu) przekazywany do wątku interfejsu.
+     *
+     * `stale` oznacza nieświeżą odpowiedź z pamięci podręcznej przekazaną zamiast błędu (API niedostępne).
+     */
+    struct Completion {
+        int requestId = -1;
+        bool error = false;
+        bool stale = false;
+        QString payload;
+    };
+
+    /**
+     * @brief Kanał wyników między wątkiem roboczym a wątkiem interfejsu.
+     *
+     * Wątek roboczy dodaje wyniki do kolejki `queue` i emituje sygnał `completionsAvailable` tylko wtedy,
+     * gdy ustawia flagę `wakePending` (pierwszy wynik od ostatniego opróżnienia kolejki); wątek interfejsu
+     * zeruje flagę przed opróżnieniem kolejki.
+     */
+    struct CompletionChannel {
+        explicit CompletionChannel(int capacity) : queue(capacity) {}
+
+        SpscQueue<Completion> queue;
+        std::atomic<bool> wakePending{false};
+    };
+
     /**
      * @brief Konstruktor klasy ApiWorker.
      * 
@@ -26,6 +65,15 @@ public:
      */
     explicit ApiWorker(QObject *parent = nullptr);
 
+    /**
+     * @brief Ustawia kanał, którym wyniki żądań są przekazywane zamiast sygnałów `resultReady` i `errorOccurred`.
+     * 
+     * Należy wywołać przed przeniesieniem obiektu do wątku roboczego; kanał musi istnieć dłużej niż ten wątek.
+     * 
+     * @param channel Wskaźnik na kanał wyników lub nullptr (wyniki przekazywane sygnałami).
+     */
+    void setCompletionChannel(CompletionChannel *channel);
+
     /**
      * @brief Destruktor klasy ApiWorker.
      * 
@@ -37,25 +85,93 @@ public slots:
     /**
      * @brief Przetwarza żądanie sieciowe dla podanego adresu URL.
      * 
-     * Wysyła żądanie GET dla podanego adresu URL i przechowuje identyfikator żądania.
+     * Zwraca świeżą odpowiedź z pamięci podręcznej bez połączenia z serwerem, a w przeciwnym razie 
+     * dodaje żądanie GET (warunkowe, jeśli odpowiedź jest w pamięci podręcznej) do kolejki `RequestScheduler`. 
+     * Żądanie ma limit czasu, a po błędzie przejściowym jest ponawiane z losowym, rosnącym opóźnieniem.
      * 
      * @param url Adres URL, z którego mają zostać pobrane dane.
      * @param requestId Identyfikator żądania.
+     * @param priority Klasa priorytetu żądania, domyślnie `RequestScheduler::Interactive`.
+     */
+    void processRequest(const QUrl &url, int requestId, RequestScheduler::Priority priority = RequestScheduler::Interactive);
+
+    /**
+     * @brief Przetwarza pakiet żądań sieciowych.
+     * 
+     * Przetwarza każdy adres URL z pakietu tak jak `processRequest`, z tą samą klasą priorytetu.
+     * 
+     * @param urls Adresy URL żądań.
+     * @param requestIds Identyfikatory żądań (w tej samej kolejności co `urls`).
+     * @param priority Klasa priorytetu żądań, domyślnie `RequestScheduler::Prefetch`.
+     */
+    void processBatch(const QVector<QUrl> &urls, const QVector<int> &requestIds, RequestScheduler::Priority priority = RequestScheduler::Prefetch);
+
+    /**
+     * @brief Przenosi oczekujące w kolejce żądanie do wyższej klasy priorytetu.
+     * 
+     * @param requestId Identyfikator żądania.
+     * @param priority Nowa klasa priorytetu.
      */
-    void processRequest(const QUrl &url, int requestId);
+    void promoteRequest(int requestId, RequestScheduler::Priority priority);
+
+    /**
+     * @brief Przerywa żądanie sieciowe o podanym identyfikatorze.
+     * 
+     * Żądanie oczekujące w kolejce lub na ponowienie jest usuwane, a wysłane kończy się błędem 
+     * OperationCanceledError, który `ApiClient` pomija.
+     * 
+     * @param requestId Identyfikator żądania.
+     */
+    void cancelRequest(int requestId);
 
     /**
      * @brief Inicjalizuje obiekt ApiWorker.
      * 
-     * Tworzy QNetworkAccessManager i konfiguruje połączenia sygnałów dla obsługi odpowiedzi sieciowych.
+     * Tworzy QNetworkAccessManager, konfiguruje połączenia sygnałów dla obsługi odpowiedzi sieciowych, 
+     * uruchamia monitor dostępności API (`HealthMonitor`) korzystający z tego samego menedżera 
+     * i zestawia z wyprzedzeniem połączenie z serwerem API.
      */
     void init();
 
 signals:
     void resultReady(const QString &result, int requestId);
+    void staleResultReady(const QString &result, int requestId);
     void errorOccurred(const QString &error, int requestId);
     void finished();
 
+    /**
+     * @brief Sygnał emitowany, gdy do pustego (opróżnionego) kanału wyników trafił pierwszy wynik.
+     */
+    void completionsAvailable();
+
+    /**
+     * @brief Sygnał emitowany po ustaleniu pierwszego stanu połączenia z API i przy każdej jego zmianie.
+     * 
+     * @param online Wartość true, jeśli API jest osiągalne.
+     */
+    void connectivityChanged(bool online);
+
+    /**
+     * @brief Sygnał emitowany po każdej odpowiedzi obsłużonej z udziałem pamięci podręcznej.
+     * 
+     * @param stats Bieżące statystyki pamięci podręcznej.
+     */
+    void cacheStatsChanged(const ResponseCache::Stats &stats);
+
+    /**
+     * @brief Sygnał emitowany po zmianie stanu kolejki żądań (najwyżej raz na klatkę interfejsu).
+     * 
+     * @param stats Bieżące statystyki kolejki (głębokość i czas oczekiwania dla każdej klasy priorytetu).
+     */
+    void schedulerStatsChanged(const RequestScheduler::Stats &stats);
+
+    /**
+     * @brief Sygnał emitowany po każdej zakończonej odpowiedzi sieciowej.
+     * 
+     * @param stats Bieżące statystyki czasu etapów żądań (połączenie, pierwszy bajt, transfer).
+     */
+    void timingStatsChanged(const RequestTiming::Stats &stats);
+
 private slots:
     /**
      * @brief Obsługuje zakończenie odpowiedzi sieciowej.
@@ -66,8 +182,55 @@ private slots:
      */
     void onReplyFinished(QNetworkReply *reply);
 
+    /**
+     * @brief Wysyła żądanie zwolnione z kolejki przez `RequestScheduler`.
+     * 
+     * @param request Żądanie sieciowe.
+     * @param requestId Identyfikator żądania.
+     */
+    void startRequest(const QNetworkRequest &request, int requestId);
+
 private:
+    /**
+     * @brief Żądanie, które nie otrzymało jeszcze ostatecznej odpowiedzi (także między ponowieniami).
+     */
+    struct PendingRequest {
+        QNetworkRequest request;
+        RequestScheduler::Priority priority = RequestScheduler::Interactive;
+        bool trial = false;
+        int attempt = 0;
+        int lastDelay = 0;
+        QTimer *retryTimer = nullptr;
+    };
+
+    /**
+     * @brief Metryki jednej rodziny punktów końcowych (`CircuitBreaker::familyFor`).
+     */
+    struct EndpointMetrics {
+        Metrics::Histogram *latency = nullptr;
+        Metrics::Counter *responses = nullptr;
+        Metrics::Counter *errors = nullptr;
+    };
+
+    void warmUp();
+    EndpointMetrics &metricsFor(const QString &family);
+    void updateQueueMetrics(const RequestScheduler::Stats &stats);
+    void dispatch(int requestId);
+    bool retryLater(int requestId, QNetworkReply *reply);
+    void fail(int requestId, const QString &error);
+    void deliver(int requestId, const QString &payload, bool error, bool stale = false);
+    static bool isTransient(QNetworkReply *reply);
+
     QNetworkAccessManager *manager;
+    HealthMonitor *healthMonitor;
+    CompletionChannel *completions;
+    ResponseCache cache;
+    RequestScheduler *scheduler;
+    CircuitBreaker breaker;
+    RequestTiming timing;
+    QHash<int, PendingRequest> pending;
+    QSet<int> cancelledTrials;
+    QHash<QString, EndpointMetrics> endpointMetrics;
     QMap<QNetworkReply*, int> replyToRequestId;
 };
 
@@ -0,0 +1,336 @@
+/**
+ * @file archivebackfill.cpp
+ * @brief Implementacja klasy ArchiveBackfill do stronicowanego pobierania archiwalnych danych pomiarowych.
+ */
+
+#include "archivebackfill.h"
+#include "apiclient.h"
+#include "apiendpoints.h"
+#include "datamanager.h"
+#include "taskexecutor.h"
+
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QUrl>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/** Długość okna zakresu dat w dniach; okna są wyrównane do stałej siatki dni, więc punkty kontrolne pasują także do przesuniętego zakresu. */
+constexpr int WindowDays = 30;
+
+/** Liczba pomiarów na stronie. */
+constexpr int PageSize = 500;
+
+/** Maksymalna liczba stron zleconych jednocześnie (dalsze ograniczenie nakłada kolejka `ApiWorker`). */
+constexpr int MaxInFlight = 8;
+
+}
+
+/**
+ * @brief Konstruktor klasy ArchiveBackfill.
+ *
+ * Łączy sygnały `batchItemReady` i `batchFinished` obiektu `ApiClient` ze slotami tej klasy.
+ * Wyniki pakietów, których nie zlecił ten obiekt, są ignorowane.
+ *
+ * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+ArchiveBackfill::ArchiveBackfill(ApiClient *apiClient, QObject *parent)
+    : QObject(parent)
+    , apiClient(apiClient)
+{
+    reset();
+    connect(apiClient, &ApiClient::batchItemReady, this, &ArchiveBackfill::onBatchItemReady);
+    connect(apiClient, &ApiClient::batchFinished, this, &ArchiveBackfill::onBatchFinished);
+}
+
+/**
+ * @brief Rozpoczyna pobieranie archiwalnych danych pomiarowych podanych czujników.
+ *
+ * Dla każdego czujnika wczytuje punkt kontrolny (`backfill_<id>.json`) i tworzy okna zakresu od najnowszego;
+ * okna zapisane w punkcie kontrolnym są pomijane. Do kolejki trafia pierwsza strona każdego okna,
+ * a kolejne strony są dodawane, gdy pierwsza strona poda ich liczbę.
+ *
+ * @param sensorIds Identyfikatory czujników.
+ * @param from Pierwszy dzień zakresu.
+ * @param to Ostatni dzień zakresu.
+ */
+void ArchiveBackfill::start(const QVector<int> &sensorIds, const QDate &from, const QDate &to) {
+    reset();
+    if (!from.isValid() || !to.isValid() || to < from) {
+        emit finished(0, 0);
+        return;
+    }
+
+    for (int sensorId : sensorIds) {
+        QSet<QString> &done = completed[sensorId];
+        const QJsonArray checkpoint = QJsonDocument::fromJson(DataManager::loadDataFromFile("backfill", sensorId))
+                                          .object()["done"].toArray();
+        for (const QJsonValue &value : checkpoint) {
+            done.insert(value.toString());
+        }
+
+        for (qint64 block = to.toJulianDay() / WindowDays; block >= from.toJulianDay() / WindowDays; --block) {
+            Window window;
+            window.sensorId = sensorId;
+            window.from = qMax(from, QDate::fromJulianDay(block * WindowDays));
+            window.to = qMin(to, QDate::fromJulianDay(block * WindowDays + WindowDays - 1));
+            window.pendingPages = 1;
+            windowsTotal++;
+            if (done.contains(windowKey(window.from, window.to))) {
+                windowsDone++;
+                continue;
+            }
+            windows.append(window);
+            queue.append({static_cast<int>(windows.size()) - 1, 0});
+        }
+    }
+
+    active = true;
+    emit progress(windowsDone, windowsTotal);
+    pump();
+}
+
+/**
+ * @brief Przerywa pobieranie.
+ *
+ * Strony zlecone wcześniej mogą jeszcze nadejść, ale są ignorowane; nie są też zapisywane
+ * punkty kontrolne niedokończonych okien.
+ */
+void ArchiveBackfill::stop() {
+    reset();
+}
+
+/**
+ * @brief Sprawdza, czy pobieranie jest w toku.
+ *
+ * @return bool Wartość true, jeśli oczekiwane są jeszcze strony.
+ */
+bool ArchiveBackfill::isRunning() const {
+    return active;
+}
+
+/**
+ * @brief Odczytuje stronę archiwalnych danych pomiarowych.
+ *
+ * Pomiary są przepisywane do formatu `{"date", "value"}` używanego przez `data/getData`, dzięki czemu
+ * zapisane strony odczytuje bez zmian `HistoryLoader`.
+ *
+ * @param data Odpowiedź API w formacie JSON.
+ * @return Page Odczytana strona; `valid` ma wartość false, jeśli odpowiedź nie jest stroną danych.
+ */
+ArchiveBackfill::Page ArchiveBackfill::parsePage(const QByteArray &data) {
+    Page page;
+    const QJsonObject obj = QJsonDocument::fromJson(data).object();
+    const QString archivalListKey = QStringLiteral("Lista archiwalnych wyników pomiarów");
+
+    QJsonArray entries;
+    QString dateKey;
+    QString valueKey;
+    if (obj.contains("values")) {
+        entries = obj["values"].toArray();
+        dateKey = "date";
+        valueKey = "value";
+    } else if (obj.contains(archivalListKey)) {
+        entries = obj[archivalListKey].toArray();
+        dateKey = "Data";
+        valueKey = QStringLiteral("Wartość");
+    } else {
+        return page;
+    }
+
+    page.valid = true;
+    page.key = obj["key"].toString();
+    page.totalPages = obj["totalPages"].toInt();
+    for (const QJsonValue &value : std::as_const(entries)) {
+        const QJsonObject entry = value.toObject();
+        QJsonObject measurement;
+        measurement["date"] = entry[dateKey];
+        measurement["value"] = entry[valueKey];
+        page.values.append(measurement);
+    }
+    return page;
+}
+
+/**
+ * @brief Obsługuje pobraną stronę.
+ *
+ * Zapisuje stronę, a dla pierwszej strony okna dodaje na początek kolejki pozostałe strony tego okna,
+ * dzięki czemu okna kończą się (i zapisują punkty kontrolne) po kolei, a nie wszystkie naraz pod koniec.
+ *
+ * @param batchId Identyfikator pakietu.
+ * @param index Pozycja żądania w pakiecie (zawsze 0 - każda strona jest osobnym pakietem).
+ * @param data Dane zwrócone w odpowiedzi na żądanie API.
+ */
+void ArchiveBackfill::onBatchItemReady(int batchId, int index, const QString &data) {
+    Q_UNUSED(index);
+    auto it = inFlight.find(batchId);
+    if (it == inFlight.end()) {
+        return;
+    }
+    const PageRequest request = it.value();
+    inFlight.erase(it);
+
+    Window &window = windows[request.window];
+    const Page page = parsePage(data.toUtf8());
+    if (!page.valid) {
+        window.failed = true;
+    } else {
+        if (request.page == 0) {
+            window.totalPages = qMax(1, page.totalPages);
+            for (int next = window.totalPages - 1; next >= 1; --next) {
+                queue.prepend({request.window, next});
+            }
+            window.pendingPages += window.totalPages - 1;
+        }
+        savePage(window, request.page, page);
+    }
+
+    if (--window.pendingPages == 0) {
+        finishWindow(window);
+    }
+    pump();
+}
+
+/**
+ * @brief Obsługuje zakończenie pakietu.
+ *
+ * Strona, której pakiet zakończył się bez wyniku (po wyczerpaniu ponowień w `ApiWorker`), oznacza okno
+ * jako nieudane; okno nie otrzymuje punktu kontrolnego, więc zostanie pobrane przy kolejnym uruchomieniu.
+ *
+ * @param batchId Identyfikator pakietu.
+ * @param failedCount Liczba żądań pakietu zakończonych błędem.
+ */
+void ArchiveBackfill::onBatchFinished(int batchId, int failedCount) {
+    Q_UNUSED(failedCount);
+    auto it = inFlight.find(batchId);
+    if (it == inFlight.end()) {
+        return;
+    }
+    Window &window = windows[it.value().window];
+    inFlight.erase(it);
+
+    window.failed = true;
+    if (--window.pendingPages == 0) {
+        finishWindow(window);
+    }
+    pump();
+}
+
+/**
+ * @brief Zwraca klucz okna w punkcie kontrolnym ("yyyy-MM-dd/yyyy-MM-dd").
+ *
+ * @param from Pierwszy dzień okna.
+ * @param to Ostatni dzień okna.
+ * @return QString Klucz okna.
+ */
+QString ArchiveBackfill::windowKey(const QDate &from, const QDate &to) {
+    return from.toString(Qt::ISODate) + '/' + to.toString(Qt::ISODate);
+}
+
+/**
+ * @brief Zleca strony z kolejki do wyczerpania limitu `MaxInFlight`; po obsłużeniu wszystkich stron emituje `finished`.
+ *
+ * Każda strona jest osobnym jednoelementowym pakietem, więc jej wynik można zapisać i zwolnić od razu.
+ */
+void ArchiveBackfill::pump() {
+    while (inFlight.size() < MaxInFlight && !queue.isEmpty()) {
+        const PageRequest request = queue.takeFirst();
+        const Window &window = windows.at(request.window);
+        const QUrl url = ApiEndpoints::archivalMeasurements(window.sensorId, QDateTime(window.from, QTime(0, 0)),
+                                                            QDateTime(window.to, QTime(23, 59)), request.page, PageSize);
+        inFlight.insert(apiClient->fetchBatch({url}, RequestScheduler::Backfill), request);
+    }
+
+    if (active && queue.isEmpty() && inFlight.isEmpty()) {
+        active = false;
+        emit finished(savedValues, failedWindows);
+    }
+}
+
+/**
+ * @brief Zapisuje stronę jako dane historyczne czujnika.
+ *
+ * Znacznikiem czasu pliku jest najpóźniejszy pomiar strony (nie później niż bieżąca chwila), więc plik
+ * nie ma daty zapisu późniejszej niż jego pomiary i nie wyprzedza plików z bieżącymi danymi, a ponowne
+ * pobranie okna nadpisuje jego pliki zamiast je powielać. Puste strony nie są zapisywane.
+ *
+ * @param window Okno, do którego należy strona.
+ * @param page Numer strony.
+ * @param data Odczytana strona.
+ */
+void ArchiveBackfill::savePage(const Window &window, int page, const Page &data) {
+    if (data.values.isEmpty()) {
+        return;
+    }
+    QDateTime newest;
+    for (const QJsonValue &value : data.values) {
+        const QDateTime date = QDateTime::fromString(value.toObject()["date"].toString(), "yyyy-MM-dd HH:mm:ss");
+        if (date.isValid() && (!newest.isValid() || date > newest)) {
+            newest = date;
+        }
+    }
+    if (!newest.isValid()) {
+        newest = QDateTime(window.to, QTime(23, 59)).addSecs(-page);
+    }
+    QJsonObject obj;
+    obj["key"] = data.key;
+    obj["values"] = data.values;
+    DataManager::saveHistoricalData("measurements", QJsonDocument(obj).toJson(QJsonDocument::Compact), window.sensorId,
+                                    qMin(newest, QDateTime::currentDateTime()));
+    savedValues += data.values.size();
+}
+
+/**
+ * @brief Kończy okno: udane dopisuje do punktu kontrolnego czujnika, nieudane zlicza.
+ *
+ * Punkt kontrolny jest scalany z zapisanym na dysku pod blokadą zapisu magazynu (`DataManager::WriteLock`),
+ * więc okna zakończone w tym samym czasie przez inny proces MJP nie są tracone. Blokada może czekać na inny
+ * proces, dlatego scalanie odbywa się we wspólnej puli wątków.
+ *
+ * @param window Zakończone okno.
+ */
+void ArchiveBackfill::finishWindow(Window &window) {
+    if (window.failed) {
+        failedWindows++;
+    } else {
+        QSet<QString> &done = completed[window.sensorId];
+        done.insert(windowKey(window.from, window.to));
+
+        const int sensorId = window.sensorId;
+        TaskExecutor::instance().submit([merged = done, sensorId]() mutable {
+            DataManager::WriteLock lock;
+            const QJsonArray stored = QJsonDocument::fromJson(DataManager::loadDataFromFile("backfill", sensorId))
+                                          .object()["done"].toArray();
+            for (const QJsonValue &value : stored) {
+                merged.insert(value.toString());
+            }
+            QStringList keys(merged.cbegin(), merged.cend());
+            std::sort(keys.begin(), keys.end());
+
+            QJsonObject checkpoint;
+            checkpoint["done"] = QJsonArray::fromStringList(keys);
+            DataManager::saveDataToFile("backfill", QJsonDocument(checkpoint).toJson(QJsonDocument::Compact), sensorId);
+        }, TaskExecutor::Low);
+    }
+    emit progress(++windowsDone, windowsTotal);
+}
+
+/**
+ * @brief Zeruje stan pobierania (wyniki wcześniej zleconych stron będą ignorowane).
+ */
+void ArchiveBackfill::reset() {
+    windows.clear();
+    queue.clear();
+    inFlight.clear();
+    completed.clear();
+    windowsDone = 0;
+    windowsTotal = 0;
+    savedValues = 0;
+    failedWindows = 0;
+    active = false;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+/**
+ * @file archivebackfill.h
+ * @brief Definicja klasy ArchiveBackfill do stronicowanego pobierania archiwalnych danych pomiarowych.
+ */
+
+#ifndef ARCHIVEBACKFILL_H
+#define ARCHIVEBACKFILL_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QDate>
+#include <QHash>
+#include <QJsonArray>
+#include <QList>
+#include <QSet>
+#include <QVector>
+
+class ApiClient;
+
+class ArchiveBackfill : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Strona archiwalnych danych pomiarowych.
+     *
+     * `values` zawiera pomiary w formacie `data/getData` (`{"date", "value"}`), a `totalPages`
+     * łączną liczbę stron zakresu (0, jeśli odpowiedź jej nie podaje).
+     */
+    struct Page {
+        bool valid = false;
+        QString key;
+        QJsonArray values;
+        int totalPages = 0;
+    };
+
+    /**
+     * @brief Konstruktor klasy ArchiveBackfill.
+     *
+     * Łączy sygnały pakietów `ApiClient` ze slotami obsługującymi pobrane strony.
+     *
+     * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit ArchiveBackfill(ApiClient *apiClient, QObject *parent = nullptr);
+
+    /**
+     * @brief Rozpoczyna pobieranie archiwalnych danych pomiarowych podanych czujników.
+     *
+     * Zakres dat jest dzielony na okna (po 30 dni), a okna na strony pobierane równolegle z klasą
+     * priorytetu `RequestScheduler::Backfill`. Każda strona jest od razu zapisywana lokalnie (`DataManager`),
+     * a po pobraniu wszystkich stron okna zapisywany jest punkt kontrolny, więc przerwane pobieranie
+     * wznawia się od pierwszego niepobranego okna. Wywołanie w trakcie trwającego pobierania zastępuje je nowym.
+     *
+     * @param sensorIds Identyfikatory czujników.
+     * @param from Pierwszy dzień zakresu.
+     * @param to Ostatni dzień zakresu.
+     */
+    void start(const QVector<int> &sensorIds, const QDate &from, const QDate &to);
+
+    /**
+     * @brief Przerywa pobieranie; strony oczekujące w kolejce nie są zlecane.
+     *
+     * Zapisane punkty kontrolne pozostają, więc kolejne `start` z tym samym zakresem wznawia pobieranie.
+     */
+    void stop();
+
+    /**
+     * @brief Sprawdza, czy pobieranie jest w toku.
+     *
+     * @return bool Wartość true, jeśli oczekiwane są jeszcze strony.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Odczytuje stronę archiwalnych danych pomiarowych.
+     *
+     * Obsługuje format z kluczami `values`/`date`/`value` oraz format API v1
+     * (`Lista archiwalnych wyników pomiarów`/`Data`/`Wartość`).
+     *
+     * @param data Odpowiedź API w formacie JSON.
+     * @return Page Odczytana strona; `valid` ma wartość false, jeśli odpowiedź nie jest stroną danych.
+     */
+    static Page parsePage(const QByteArray &data);
+
+signals:
+    /**
+     * @brief Sygnał emitowany po zakończeniu kolejnego okna.
+     *
+     * @param done Liczba zakończonych okien (także pominiętych dzięki punktom kontrolnym).
+     * @param total Łączna liczba okien.
+     */
+    void progress(int done, int total);
+
+    /**
+     * @brief Sygnał emitowany po zakończeniu pobierania.
+     *
+     * @param savedValues Liczba zapisanych pomiarów.
+     * @param failedWindows Liczba okien, których nie udało się pobrać w całości.
+     */
+    void finished(int savedValues, int failedWindows);
+
+private slots:
+    void onBatchItemReady(int batchId, int index, const QString &data);
+    void onBatchFinished(int batchId, int failedCount);
+
+private:
+    /**
+     * @brief Okno zakresu dat jednego czujnika.
+     */
+    struct Window {
+        int sensorId = -1;
+        QDate from;
+        QDate to;
+        int totalPages = 0;
+        int pendingPages = 0;
+        bool failed = false;
+    };
+
+    /**
+     * @brief Strona okna oczekująca w kolejce lub na odpowiedź.
+     */
+    struct PageRequest {
+        int window = -1;
+        int page = 0;
+    };
+
+    static QString windowKey(const QDate &from, const QDate &to);
+    void pump();
+    void savePage(const Window &window, int page, const Page &data);
+    void finishWindow(Window &window);
+    void reset();
+
+    ApiClient *apiClient;
+    QVector<Window> windows;
+    QList<PageRequest> queue;
+    QHash<int, PageRequest> inFlight;
+    QHash<int, QSet<QString>> completed;
+    int windowsDone;
+    int windowsTotal;
+    int savedValues;
+    int failedWindows;
+    bool active;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+/**
+ * @file benchmarkrunner.cpp
+ * @brief Implementacja klasy BenchmarkRunner - uruchamiania benchmarków i zapisu wyników w formacie JSON.
+ */
+
+#include "benchmarkrunner.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QXmlStreamReader>
+#include <QtTest>
+
+/**
+ * @brief Konstruktor klasy BenchmarkRunner.
+ *
+ * @param arguments Argumenty wiersza poleceń (z nazwą programu na początku).
+ */
+BenchmarkRunner::BenchmarkRunner(const QStringList &arguments) {
+    for (int i = 0; i < arguments.size(); ++i) {
+        if (arguments.at(i) == "-json" && i + 1 < arguments.size()) {
+            jsonPath = arguments.at(++i);
+        } else {
+            this->arguments.append(arguments.at(i));
+        }
+    }
+}
+
+/**
+ * @brief Uruchamia benchmarki klasy.
+ *
+ * Przy zapisie JSON do QtTest przekazywane są dwa dzienniki: tekstowy na standardowe wyjście
+ * i XML do pliku tymczasowego, z którego odczytywane są wyniki (QtTest nie ma dziennika JSON).
+ *
+ * @param benchmark Obiekt klasy benchmarków.
+ * @return int Liczba nieudanych funkcji (0 oznacza sukces).
+ */
+int BenchmarkRunner::run(QObject *benchmark) {
+    if (jsonPath.isEmpty()) {
+        return QTest::qExec(benchmark, arguments);
+    }
+
+    QTemporaryDir dir;
+    const QString xmlPath = dir.filePath("results.xml");
+    const int failures = QTest::qExec(benchmark, QStringList(arguments) << "-o" << xmlPath + ",xml" << "-o" << "-,txt");
+    appendXmlResults(xmlPath);
+    return failures;
+}
+
+/**
+ * @brief Zapisuje wyniki wszystkich uruchomionych klas do pliku podanego opcją `-json`.
+ *
+ * @return bool Wartość true, jeśli opcji nie podano lub plik został zapisany.
+ */
+bool BenchmarkRunner::writeJson() const {
+    if (jsonPath.isEmpty()) {
+        return true;
+    }
+
+    QJsonObject report;
+    report["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["qtVersion"] = QString(qVersion());
+    report["cpu"] = QSysInfo::currentCpuArchitecture();
+    report["os"] = QSysInfo::prettyProductName();
+    report["large"] = largeRuns();
+    report["results"] = results;
+
+    QFile file(jsonPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(report).toJson());
+    return true;
+}
+
+/**
+ * @brief Sprawdza, czy mają zostać uruchomione także największe warianty benchmarków.
+ *
+ * @return bool Wartość true, jeśli zmienna `MJP_BENCH_LARGE` jest ustawiona.
+ */
+bool BenchmarkRunner::largeRuns() {
+    return qEnvironmentVariableIsSet("MJP_BENCH_LARGE");
+}
+
+/**
+ * @brief Dołącza do wyników elementy `BenchmarkResult` z pliku XML QtTest.
+ *
+ * @param xmlPath Ścieżka pliku XML.
+ */
+void BenchmarkRunner::appendXmlResults(const QString &xmlPath) {
+    QFile file(xmlPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QXmlStreamReader xml(&file);
+    QString testCase;
+    QString function;
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement) {
+            continue;
+        }
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("TestCase")) {
+            testCase = attributes.value("name").toString();
+        } else if (xml.name() == QLatin1String("TestFunction")) {
+            function = attributes.value("name").toString();
+        } else if (xml.name() == QLatin1String("BenchmarkResult")) {
+            QJsonObject result;
+            result["benchmark"] = testCase;
+            result["function"] = function;
+            result["tag"] = attributes.value("tag").toString();
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toDouble();
+            result["iterations"] = attributes.value("iterations").toInt();
+            results.append(result);
+        }
+    }
+}
\ No newline at end of file
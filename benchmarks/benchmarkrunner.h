@@ -0,0 +1,66 @@
+/**
+ * @file benchmarkrunner.h
+ * @brief Definicja klasy BenchmarkRunner - uruchamiania benchmarków i zapisu wyników w formacie JSON.
+ */
+
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QJsonArray>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class BenchmarkRunner
+{
+public:
+    /**
+     * @brief Konstruktor klasy BenchmarkRunner.
+     *
+     * Usuwa z argumentów opcję `-json <plik>` (nieznaną dla QtTest); pozostałe argumenty
+     * (np. `-iterations`, `-minimumvalue`, nazwy funkcji) są przekazywane do każdej klasy benchmarków.
+     *
+     * @param arguments Argumenty wiersza poleceń (z nazwą programu na początku).
+     */
+    explicit BenchmarkRunner(const QStringList &arguments);
+
+    /**
+     * @brief Uruchamia benchmarki klasy.
+     *
+     * Jeśli podano opcję `-json`, wyniki są dodatkowo zapisywane w formacie XML QtTest do pliku
+     * tymczasowego i dołączane do wyników JSON.
+     *
+     * @param benchmark Obiekt klasy benchmarków.
+     * @return int Liczba nieudanych funkcji (0 oznacza sukces).
+     */
+    int run(QObject *benchmark);
+
+    /**
+     * @brief Zapisuje wyniki wszystkich uruchomionych klas do pliku podanego opcją `-json`.
+     *
+     * Każdy wynik zawiera klasę, funkcję, wiersz danych, metrykę, wartość na iterację i liczbę iteracji,
+     * więc wyniki dwóch uruchomień można porównać narzędziem do porównywania plików JSON.
+     *
+     * @return bool Wartość true, jeśli opcji nie podano lub plik został zapisany.
+     */
+    bool writeJson() const;
+
+    /**
+     * @brief Sprawdza, czy mają zostać uruchomione także największe warianty benchmarków.
+     *
+     * Największe warianty (np. 100 000 plików, 10 milionów pomiarów) wymagają dużo pamięci i miejsca
+     * na dysku, więc są włączane zmienną środowiskową `MJP_BENCH_LARGE`.
+     *
+     * @return bool Wartość true, jeśli zmienna `MJP_BENCH_LARGE` jest ustawiona.
+     */
+    static bool largeRuns();
+
+private:
+    void appendXmlResults(const QString &xmlPath);
+
+    QStringList arguments;
+    QString jsonPath;
+    QJsonArray results;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+QT += core gui widgets charts testlib
+TARGET = mjp_benchmarks
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    benchmarkrunner.cpp \
+    main.cpp \
+    measurementbenchmark.cpp \
+    payloadparsingbenchmark.cpp \
+    stationsearchbenchmark.cpp \
+    storagebenchmark.cpp \
+    syntheticgiosdata.cpp \
+    ../datamanager.cpp \
+    ../measurementdecoder.cpp \
+    ../measurementhandler.cpp \
+    ../metrics.cpp \
+    ../sensorhandler.cpp \
+    ../stationcatalog.cpp \
+    ../stationhandler.cpp \
+    ../stationlistmodel.cpp \
+    ../stationsearchindex.cpp \
+    ../taskexecutor.cpp \
+    ../textnormalizer.cpp \
+    ../tracing.cpp
+
+HEADERS += \
+    benchmarkrunner.h \
+    measurementbenchmark.h \
+    payloadparsingbenchmark.h \
+    stationsearchbenchmark.h \
+    storagebenchmark.h \
+    syntheticgiosdata.h \
+    ../datamanager.h \
+    ../measurementdecoder.h \
+    ../measurementhandler.h \
+    ../metrics.h \
+    ../sensorhandler.h \
+    ../stationcatalog.h \
+    ../stationhandler.h \
+    ../stationlistmodel.h \
+    ../stationsearchindex.h \
+    ../taskexecutor.h \
+    ../textnormalizer.h \
+    ../tracing.h
\ No newline at end of file
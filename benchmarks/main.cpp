@@ -0,0 +1,53 @@
+/**
+ * @file main.cpp
+ * @brief Plik główny programu z benchmarkami MJP.
+ */
+
+#include <QApplication>
+#include <QtTest>
+#include "benchmarkrunner.h"
+#include "measurementbenchmark.h"
+#include "payloadparsingbenchmark.h"
+#include "stationsearchbenchmark.h"
+#include "storagebenchmark.h"
+
+/**
+ * @brief Główna funkcja programu z benchmarkami.
+ *
+ * Uruchamia kolejno wszystkie klasy benchmarków, przekazując im argumenty wiersza poleceń
+ * (np. `-iterations`, `-minimumvalue`). Opcja `-json <plik>` zapisuje wyniki wszystkich klas do jednego
+ * pliku JSON, który można porównać z wynikami innego uruchomienia. Benchmarki listy stacji i wykresu
+ * korzystają z widżetów, więc bez ustawionej zmiennej `QT_QPA_PLATFORM` używana jest platforma `offscreen`.
+ * Zwraca liczbę nieudanych benchmarków.
+ *
+ * @param argc Liczba argumentów wiersza poleceń.
+ * @param argv Tablica argumentów wiersza poleceń.
+ * @return int Liczba nieudanych benchmarków (0 oznacza sukces).
+ */
+int main(int argc, char *argv[]) {
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("mjp_benchmarks");
+    BenchmarkRunner runner(app.arguments());
+    int failures = 0;
+
+    PayloadParsingBenchmark payloadParsing;
+    failures += runner.run(&payloadParsing);
+
+    StationSearchBenchmark stationSearch;
+    failures += runner.run(&stationSearch);
+
+    MeasurementBenchmark measurement;
+    failures += runner.run(&measurement);
+
+    StorageBenchmark storage;
+    failures += runner.run(&storage);
+
+    if (!runner.writeJson()) {
+        qCritical() << "Nie można zapisać wyników w formacie JSON";
+        failures++;
+    }
+    return failures;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+/**
+ * @file measurementbenchmark.cpp
+ * @brief Implementacja klasy MeasurementBenchmark - benchmarków statystyk i wykresu pomiarów.
+ */
+
+#include "measurementbenchmark.h"
+#include "benchmarkrunner.h"
+#include "measurementhandler.h"
+#include "syntheticgiosdata.h"
+
+#include <QtTest>
+
+namespace {
+void addCountRows(const QVector<int> &counts, int largeCount) {
+    QTest::addColumn<int>("count");
+    for (int count : counts) {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+    if (BenchmarkRunner::largeRuns()) {
+        QTest::newRow(qPrintable(QString::number(largeCount))) << largeCount;
+    }
+}
+}
+
+/**
+ * @brief Dane dla benchmarku statystyk - liczba pomiarów (1e3..1e6, 1e7 przy `MJP_BENCH_LARGE`).
+ */
+void MeasurementBenchmark::statistics_data() {
+    addCountRows({1000, 10000, 100000, 1000000}, 10000000);
+}
+
+/**
+ * @brief Mierzy czas obliczenia minimum, średniej, maksimum i trendu (`MeasurementHandler::computeStatistics`).
+ *
+ * Pomiar obejmuje kopię serii i jej sortowanie wewnątrz `computeStatistics`.
+ */
+void MeasurementBenchmark::statistics() {
+    QFETCH(int, count);
+    const QVector<QPair<QDateTime, double>> &data = seriesFor(count);
+
+    MeasurementHandler::Statistics stats;
+    QBENCHMARK {
+        stats = MeasurementHandler::computeStatistics(data);
+    }
+    QVERIFY(stats.count > 0);
+}
+
+/**
+ * @brief Dane dla benchmarku wykresu - liczba pomiarów (1e3..1e5, 1e6 przy `MJP_BENCH_LARGE`).
+ */
+void MeasurementBenchmark::updateChart_data() {
+    addCountRows({1000, 10000, 100000}, 1000000);
+}
+
+/**
+ * @brief Mierzy czas budowy wykresu z serią pomiarów (`MeasurementHandler::updateChart`).
+ *
+ * Widok wykresu nie jest wyświetlany, więc pomiar obejmuje budowę serii i osi oraz usunięcie poprzedniego
+ * wykresu (`deleteLater`), bez rysowania.
+ */
+void MeasurementBenchmark::updateChart() {
+    QFETCH(int, count);
+    const QVector<QPair<QDateTime, double>> &data = seriesFor(count);
+    QChartView chartView;
+
+    QBENCHMARK {
+        MeasurementHandler::updateChart(data, &chartView, "Warszawa", "ul. Marszałkowska", "pył zawieszony PM10");
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+}
+
+/**
+ * @brief Zwraca (generując przy pierwszym użyciu) serię pomiarów o podanej liczbie punktów.
+ *
+ * @param count Liczba pomiarów.
+ * @return const QVector<QPair<QDateTime, double>>& Seria pomiarów rosnąco według czasu.
+ */
+const QVector<QPair<QDateTime, double>> &MeasurementBenchmark::seriesFor(int count) {
+    auto it = series.find(count);
+    if (it == series.end()) {
+        it = series.insert(count, SyntheticGiosData::measurementSeries(count));
+    }
+    return it.value();
+}
\ No newline at end of file
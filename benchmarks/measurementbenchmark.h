@@ -0,0 +1,38 @@
+/**
+ * @file measurementbenchmark.h
+ * @brief Definicja klasy MeasurementBenchmark - benchmarków statystyk i wykresu pomiarów.
+ */
+
+#ifndef MEASUREMENTBENCHMARK_H
+#define MEASUREMENTBENCHMARK_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+class MeasurementBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Mierzy czas obliczenia minimum, średniej, maksimum i trendu (`MeasurementHandler::computeStatistics`).
+     */
+    void statistics_data();
+    void statistics();
+
+    /**
+     * @brief Mierzy czas budowy wykresu z serią pomiarów (`MeasurementHandler::updateChart`).
+     */
+    void updateChart_data();
+    void updateChart();
+
+private:
+    const QVector<QPair<QDateTime, double>> &seriesFor(int count);
+
+    QHash<int, QVector<QPair<QDateTime, double>>> series;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+ * @file payloadparsingbenchmark.cpp
+ * @brief Implementacja klasy PayloadParsingBenchmark - benchmarków odczytu odpowiedzi API GIOS.
+ */
+
+#include "payloadparsingbenchmark.h"
+#include "measurementdecoder.h"
+#include "measurementhandler.h"
+#include "sensorhandler.h"
+#include "stationcatalog.h"
+#include "syntheticgiosdata.h"
+
+#include <QJsonDocument>
+#include <QListWidget>
+#include <QtTest>
+
+/**
+ * @brief Dane dla benchmarku odczytu listy stacji - liczba stacji.
+ */
+void PayloadParsingBenchmark::stations_data() {
+    QTest::addColumn<int>("count");
+    for (int count : {300, 3000, 30000}) {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+/**
+ * @brief Mierzy czas odczytu listy stacji (`station/findAll`) do katalogu stacji.
+ *
+ * Pomiar obejmuje parsowanie JSON i `StationCatalog::loadFromJson` (sortowanie i pola pomocnicze).
+ */
+void PayloadParsingBenchmark::stations() {
+    QFETCH(int, count);
+    const QByteArray json = SyntheticGiosData::stationsJson(count);
+
+    QBENCHMARK {
+        StationCatalog catalog;
+        catalog.loadFromJson(QJsonDocument::fromJson(json).array());
+    }
+}
+
+/**
+ * @brief Dane dla benchmarku odczytu listy czujników - liczba czujników stacji.
+ */
+void PayloadParsingBenchmark::sensors_data() {
+    QTest::addColumn<int>("count");
+    for (int count : {6, 30, 99}) {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+/**
+ * @brief Mierzy czas odczytu listy czujników stacji i wypełnienia listy czujników (`SensorHandler`).
+ */
+void PayloadParsingBenchmark::sensors() {
+    QFETCH(int, count);
+    const QByteArray json = SyntheticGiosData::sensorsJson(1, count, 1);
+    QListWidget sensorList;
+    QVector<QPair<int, QString>> currentSensors;
+
+    QBENCHMARK {
+        SensorHandler::handleSensorsData(QJsonDocument::fromJson(json).array(), &sensorList, currentSensors);
+    }
+}
+
+/**
+ * @brief Dane dla benchmarku odczytu serii pomiarów - liczba godzin serii.
+ */
+void PayloadParsingBenchmark::measurements_data() {
+    QTest::addColumn<int>("hours");
+    for (int hours : {72, 720, 8760}) {
+        QTest::newRow(qPrintable(QString::number(hours))) << hours;
+    }
+}
+
+/**
+ * @brief Mierzy czas odczytu serii pomiarów (`data/getData`) przez `MeasurementHandler::parseMeasurements`.
+ */
+void PayloadParsingBenchmark::measurements() {
+    QFETCH(int, hours);
+    const QByteArray json = SyntheticGiosData::measurementsJson(101, hours, QDateTime(QDate(2025, 1, 1), QTime(0, 0), Qt::UTC));
+
+    QVector<QPair<QDateTime, double>> parsed;
+    QBENCHMARK {
+        parsed = MeasurementHandler::parseMeasurements(QJsonDocument::fromJson(json).object());
+    }
+    QVERIFY(!parsed.isEmpty());
+}
+
+/**
+ * @brief Dane dla benchmarku dekodera pomiarów - te same serie co dla `measurements`.
+ */
+void PayloadParsingBenchmark::measurementsDecoder_data() {
+    measurements_data();
+}
+
+/**
+ * @brief Mierzy czas odczytu serii pomiarów przez `MeasurementDecoder` (bez drzewa JSON).
+ *
+ * Seria jest używana ponownie w kolejnych iteracjach, jak przy wczytywaniu wielu plików, więc po pierwszej
+ * iteracji dekodowanie nie powinno alokować pamięci na stercie; sprawdza to ostatni wynik.
+ */
+void PayloadParsingBenchmark::measurementsDecoder() {
+    QFETCH(int, hours);
+    const QByteArray json = SyntheticGiosData::measurementsJson(101, hours, QDateTime(QDate(2025, 1, 1), QTime(0, 0), Qt::UTC));
+
+    MeasurementDecoder::Series series;
+    MeasurementDecoder::Result result;
+    QBENCHMARK {
+        series.resize(0);
+        result = MeasurementDecoder::decode(json, &series);
+    }
+    QVERIFY(result.valid);
+    QVERIFY(!series.isEmpty());
+    QCOMPARE(result.heapAllocations, 0);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**
+ * @file payloadparsingbenchmark.h
+ * @brief Definicja klasy PayloadParsingBenchmark - benchmarków odczytu odpowiedzi API GIOS.
+ */
+
+#ifndef PAYLOADPARSINGBENCHMARK_H
+#define PAYLOADPARSINGBENCHMARK_H
+
+#include <QObject>
+
+class PayloadParsingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Mierzy czas odczytu listy stacji (`station/findAll`) do katalogu stacji.
+     */
+    void stations_data();
+    void stations();
+
+    /**
+     * @brief Mierzy czas odczytu listy czujników stacji i wypełnienia listy czujników.
+     */
+    void sensors_data();
+    void sensors();
+
+    /**
+     * @brief Mierzy czas odczytu serii pomiarów (`data/getData`).
+     */
+    void measurements_data();
+    void measurements();
+
+    /**
+     * @brief Mierzy czas odczytu serii pomiarów (`data/getData`) przez `MeasurementDecoder` do zarezerwowanej serii.
+     */
+    void measurementsDecoder_data();
+    void measurementsDecoder();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+/**
+ * @file stationsearchbenchmark.cpp
+ * @brief Implementacja klasy StationSearchBenchmark - benchmarków wyszukiwania stacji.
+ */
+
+#include "stationsearchbenchmark.h"
+#include "stationcatalog.h"
+#include "stationhandler.h"
+#include "stationlistmodel.h"
+#include "syntheticgiosdata.h"
+
+#include <QJsonDocument>
+#include <QtTest>
+
+namespace {
+const int catalogSizes[] = {1000, 10000, 50000};
+
+void addQueryRows() {
+    QTest::addColumn<int>("size");
+    QTest::addColumn<QString>("query");
+
+    for (int size : catalogSizes) {
+        QTest::newRow(qPrintable(QString("%1/dokladne").arg(size))) << size << QString("Łódź");
+        QTest::newRow(qPrintable(QString("%1/bez-polskich-znakow").arg(size))) << size << QString("lodz");
+        QTest::newRow(qPrintable(QString("%1/literowka").arg(size))) << size << QString("krakw");
+        QTest::newRow(qPrintable(QString("%1/prefiksy-pol").arg(size))) << size << QString("miasto:warszawa ulica:kosciuszki");
+    }
+}
+}
+
+/**
+ * @brief Dane dla benchmarku budowy indeksu - wielkości katalogu.
+ */
+void StationSearchBenchmark::buildIndex_data() {
+    QTest::addColumn<int>("size");
+    for (int size : catalogSizes) {
+        QTest::newRow(qPrintable(QString::number(size))) << size;
+    }
+}
+
+/**
+ * @brief Mierzy czas budowy indeksu trigramowego dla katalogów o różnej wielkości.
+ */
+void StationSearchBenchmark::buildIndex() {
+    QFETCH(int, size);
+    const QVector<StationSearchIndex::Document> documents = SyntheticGiosData::stationDocuments(size);
+
+    QBENCHMARK {
+        StationSearchIndex index;
+        index.build(documents);
+    }
+}
+
+/**
+ * @brief Dane dla benchmarku zapytań do indeksu - wielkości katalogu i zapytania.
+ */
+void StationSearchBenchmark::indexSearch_data() {
+    addQueryRows();
+}
+
+/**
+ * @brief Mierzy czas zapytania do indeksu trigramowego (dokładne, z literówką, z prefiksami pól).
+ *
+ * Indeks jest budowany raz dla danej wielkości katalogu i nie wlicza się do pomiaru.
+ */
+void StationSearchBenchmark::indexSearch() {
+    QFETCH(int, size);
+    QFETCH(QString, query);
+    const StationSearchIndex &index = indexFor(size);
+
+    QVector<StationSearchIndex::Match> matches;
+    QBENCHMARK {
+        matches = index.search(query, 50);
+    }
+    Q_UNUSED(matches);
+}
+
+/**
+ * @brief Dane dla benchmarku przeszukiwania liniowego - wielkości katalogu i zapytania.
+ */
+void StationSearchBenchmark::linearScan_data() {
+    addQueryRows();
+}
+
+/**
+ * @brief Mierzy czas liniowego przeszukiwania z `toLower().contains()` (punkt odniesienia).
+ *
+ * Odpowiada dawnemu filtrowaniu w `StationHandler::updateStationList`, które nie obsługiwało
+ * literówek ani braku polskich znaków.
+ */
+void StationSearchBenchmark::linearScan() {
+    QFETCH(int, size);
+    QFETCH(QString, query);
+
+    QStringList displays;
+    for (const auto &document : SyntheticGiosData::stationDocuments(size)) {
+        displays.append(SyntheticGiosData::displayText(document));
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &display : std::as_const(displays)) {
+            if (display.toLower().contains(query.toLower())) ++found;
+        }
+    }
+    Q_UNUSED(found);
+}
+
+/**
+ * @brief Dane dla benchmarku filtrowania listy stacji - wielkości katalogu i zapytania.
+ */
+void StationSearchBenchmark::updateStationList_data() {
+    addQueryRows();
+}
+
+/**
+ * @brief Mierzy czas filtrowania listy stacji w interfejsie (`StationHandler::updateStationList`).
+ *
+ * Katalog, model i widok listy są przygotowywane tak jak po pobraniu listy stacji (`handleStationsData`);
+ * pomiar obejmuje filtrowanie modelu, zaznaczenie pierwszego wiersza i aktualizację licznika stacji.
+ */
+void StationSearchBenchmark::updateStationList() {
+    QFETCH(int, size);
+    QFETCH(QString, query);
+
+    StationCatalog catalog;
+    StationListModel model;
+    QListView stationList;
+    QLabel lblStationCount;
+    stationList.setModel(&model);
+    StationHandler::handleStationsData(QJsonDocument::fromJson(SyntheticGiosData::stationsJson(size)).array(),
+                                       &model, &stationList, &lblStationCount, catalog);
+
+    QBENCHMARK {
+        StationHandler::updateStationList(query, &model, &stationList, &lblStationCount);
+    }
+}
+
+/**
+ * @brief Zwraca (budując przy pierwszym użyciu) indeks dla katalogu o podanej wielkości.
+ *
+ * @param size Liczba stacji.
+ * @return const StationSearchIndex& Indeks katalogu.
+ */
+const StationSearchIndex &StationSearchBenchmark::indexFor(int size) {
+    auto it = indexes.find(size);
+    if (it == indexes.end()) {
+        StationSearchIndex index;
+        index.build(SyntheticGiosData::stationDocuments(size));
+        it = indexes.insert(size, index);
+    }
+    return it.value();
+}
\ No newline at end of file
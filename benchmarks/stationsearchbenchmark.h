@@ -0,0 +1,48 @@
+/**
+ * @file stationsearchbenchmark.h
+ * @brief Definicja klasy StationSearchBenchmark - benchmarków wyszukiwania stacji.
+ */
+
+#ifndef STATIONSEARCHBENCHMARK_H
+#define STATIONSEARCHBENCHMARK_H
+
+#include <QObject>
+#include <QHash>
+#include "stationsearchindex.h"
+
+class StationSearchBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Mierzy czas budowy indeksu trigramowego dla katalogów o różnej wielkości.
+     */
+    void buildIndex_data();
+    void buildIndex();
+
+    /**
+     * @brief Mierzy czas zapytania do indeksu trigramowego (dokładne, z literówką, z prefiksami pól).
+     */
+    void indexSearch_data();
+    void indexSearch();
+
+    /**
+     * @brief Mierzy czas liniowego przeszukiwania z `toLower().contains()` (punkt odniesienia).
+     */
+    void linearScan_data();
+    void linearScan();
+
+    /**
+     * @brief Mierzy czas filtrowania listy stacji w interfejsie (`StationHandler::updateStationList`).
+     */
+    void updateStationList_data();
+    void updateStationList();
+
+private:
+    const StationSearchIndex &indexFor(int size);
+
+    QHash<int, StationSearchIndex> indexes;
+};
+
+#endif
\ No newline at end of file
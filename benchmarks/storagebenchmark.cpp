@@ -0,0 +1,142 @@
+/**
+ * @file storagebenchmark.cpp
+ * @brief Implementacja klasy StorageBenchmark - benchmarków zapisu i odczytu danych historycznych (`DataManager`).
+ */
+
+#include "storagebenchmark.h"
+#include "benchmarkrunner.h"
+#include "datamanager.h"
+#include "syntheticgiosdata.h"
+
+#include <QtTest>
+
+namespace {
+
+/** Czujnik, do którego zapisują pliki benchmarki zapisu (jego pliki są usuwane przed każdym pomiarem). */
+constexpr int SaveSensorId = 1;
+
+/** Znacznik czasu najnowszego pliku; kolejne pliki są o godzinę starsze. */
+const QDateTime newestSnapshot(QDate(2025, 1, 1), QTime(0, 0));
+
+void removeSnapshots(int sensorId) {
+    const QStringList files = DataManager::historicalDataFiles("measurements", sensorId);
+    for (const QString &file : files) {
+        QFile::remove(file);
+    }
+}
+
+}
+
+/**
+ * @brief Przełącza `QStandardPaths` w tryb testowy i czyści katalog danych benchmarków.
+ *
+ * W trybie testowym `AppDataLocation` wskazuje katalog testowy zamiast katalogu danych aplikacji,
+ * więc benchmarki nie zmieniają danych użytkownika. Każdy plik zawiera dobę pomiarów jednego czujnika.
+ */
+void StorageBenchmark::initTestCase() {
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).removeRecursively();
+    snapshot = SyntheticGiosData::measurementsJson(101, 24, newestSnapshot);
+}
+
+/**
+ * @brief Usuwa pliki utworzone przez benchmarki.
+ */
+void StorageBenchmark::cleanupTestCase() {
+    QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).removeRecursively();
+}
+
+/**
+ * @brief Dane dla benchmarku zapisu - liczba plików.
+ */
+void StorageBenchmark::saveSnapshots_data() {
+    addCountRows();
+}
+
+/**
+ * @brief Mierzy czas zapisu plików pomiarów (`DataManager::saveHistoricalData`).
+ *
+ * Zapis jest mierzony jednokrotnie, bo każde powtórzenie zmieniałoby stan katalogu.
+ */
+void StorageBenchmark::saveSnapshots() {
+    QFETCH(int, count);
+    removeSnapshots(SaveSensorId);
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < count; ++i) {
+            DataManager::saveHistoricalData("measurements", snapshot, SaveSensorId, newestSnapshot.addSecs(-3600 * i));
+        }
+    }
+    removeSnapshots(SaveSensorId);
+}
+
+/**
+ * @brief Dane dla benchmarku wyszukania plików - liczba plików.
+ */
+void StorageBenchmark::listSnapshots_data() {
+    addCountRows();
+}
+
+/**
+ * @brief Mierzy czas wyszukania plików pomiarów czujnika (`DataManager::historicalDataFiles`).
+ */
+void StorageBenchmark::listSnapshots() {
+    QFETCH(int, count);
+    ensureSnapshots(count, count);
+
+    QStringList files;
+    QBENCHMARK {
+        files = DataManager::historicalDataFiles("measurements", count);
+    }
+    QCOMPARE(files.size(), count);
+}
+
+/**
+ * @brief Dane dla benchmarku wczytania plików - liczba plików.
+ */
+void StorageBenchmark::loadSnapshots_data() {
+    addCountRows();
+}
+
+/**
+ * @brief Mierzy czas wczytania wszystkich plików pomiarów czujnika (`DataManager::loadAllHistoricalData`).
+ */
+void StorageBenchmark::loadSnapshots() {
+    QFETCH(int, count);
+    ensureSnapshots(count, count);
+
+    QVector<QPair<QDateTime, QByteArray>> data;
+    QBENCHMARK {
+        data = DataManager::loadAllHistoricalData("measurements", count);
+    }
+    QCOMPARE(data.size(), count);
+}
+
+/**
+ * @brief Dodaje wiersze z liczbą plików: 1000 i 10 000 (oraz 100 000 przy `MJP_BENCH_LARGE`).
+ */
+void StorageBenchmark::addCountRows() {
+    QTest::addColumn<int>("count");
+    QVector<int> counts = {1000, 10000};
+    if (BenchmarkRunner::largeRuns()) {
+        counts.append(100000);
+    }
+    for (int count : std::as_const(counts)) {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+/**
+ * @brief Zapisuje pliki pomiarów czujnika, jeśli jest ich mniej niż podano (przygotowanie poza pomiarem).
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @param count Oczekiwana liczba plików.
+ */
+void StorageBenchmark::ensureSnapshots(int sensorId, int count) {
+    if (DataManager::historicalDataFiles("measurements", sensorId).size() >= count) {
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        DataManager::saveHistoricalData("measurements", snapshot, sensorId, newestSnapshot.addSecs(-3600 * i));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/**
+ * @file storagebenchmark.h
+ * @brief Definicja klasy StorageBenchmark - benchmarków zapisu i odczytu danych historycznych (`DataManager`).
+ */
+
+#ifndef STORAGEBENCHMARK_H
+#define STORAGEBENCHMARK_H
+
+#include <QObject>
+#include <QByteArray>
+
+class StorageBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Przełącza `QStandardPaths` w tryb testowy i czyści katalog danych benchmarków.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Usuwa pliki utworzone przez benchmarki.
+     */
+    void cleanupTestCase();
+
+    /**
+     * @brief Mierzy czas zapisu plików pomiarów (`DataManager::saveHistoricalData`).
+     */
+    void saveSnapshots_data();
+    void saveSnapshots();
+
+    /**
+     * @brief Mierzy czas wyszukania plików pomiarów czujnika (`DataManager::historicalDataFiles`).
+     */
+    void listSnapshots_data();
+    void listSnapshots();
+
+    /**
+     * @brief Mierzy czas wczytania wszystkich plików pomiarów czujnika (`DataManager::loadAllHistoricalData`).
+     */
+    void loadSnapshots_data();
+    void loadSnapshots();
+
+private:
+    void addCountRows();
+    void ensureSnapshots(int sensorId, int count);
+
+    QByteArray snapshot;
+};
+
+#endif
\ No newline at end of file
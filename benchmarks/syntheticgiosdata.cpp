@@ -0,0 +1,234 @@
+/**
+ * @file syntheticgiosdata.cpp
+ * @brief Implementacja klasy SyntheticGiosData - generatora syntetycznych danych w formacie API GIOS.
+ */
+
+#include "syntheticgiosdata.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QtMath>
+
+namespace {
+const QStringList bigCities = {
+    "Warszawa", "Kraków", "Łódź", "Wrocław", "Poznań", "Gdańsk", "Szczecin",
+    "Bydgoszcz", "Lublin", "Białystok", "Katowice", "Zielona Góra", "Bielsko-Biała"
+};
+
+const QStringList syllables = {
+    "Bo", "brze", "Chę", "ciny", "Dą", "bro", "wa", "Gó", "ra", "Ją", "kó", "Ło", "wicz",
+    "Mo", "gi", "no", "Pia", "se", "czno", "Rzą", "śnik", "Szy", "dło", "Tu", "chów", "Ży", "rar", "dów"
+};
+
+const QStringList patrons = {
+    "Kościuszki", "Mickiewicza", "Piłsudskiego", "Legionów", "Żeromskiego", "Słowackiego",
+    "Konopnickiej", "Sienkiewicza", "Wyszyńskiego", "Jagiellońska", "Świętokrzyska", "Źródlana"
+};
+
+const QStringList provinces = {
+    "DOLNOŚLĄSKIE", "KUJAWSKO-POMORSKIE", "LUBELSKIE", "LUBUSKIE", "ŁÓDZKIE", "MAŁOPOLSKIE",
+    "MAZOWIECKIE", "OPOLSKIE", "PODKARPACKIE", "PODLASKIE", "POMORSKIE", "ŚLĄSKIE",
+    "ŚWIĘTOKRZYSKIE", "WARMIŃSKO-MAZURSKIE", "WIELKOPOLSKIE", "ZACHODNIOPOMORSKIE"
+};
+
+/** Parametry czujników: nazwa, wzór, kod, identyfikator parametru i typowy poziom stężenia (µg/m3). */
+struct Parameter {
+    const char *name;
+    const char *formula;
+    const char *code;
+    int id;
+    double level;
+};
+
+const Parameter parameters[] = {
+    {"pył zawieszony PM10", "PM10", "PM10", 3, 30.0},
+    {"pył zawieszony PM2.5", "PM2.5", "PM2.5", 69, 20.0},
+    {"dwutlenek azotu", "NO2", "NO2", 6, 25.0},
+    {"ozon", "O3", "O3", 5, 60.0},
+    {"dwutlenek siarki", "SO2", "SO2", 1, 5.0},
+    {"tlenek węgla", "CO", "CO", 8, 400.0},
+    {"benzen", "C6H6", "C6H6", 10, 1.5}
+};
+constexpr int ParameterCount = sizeof(parameters) / sizeof(parameters[0]);
+
+QString randomCity(QRandomGenerator &random) {
+    if (random.bounded(10) == 0) {
+        return bigCities.at(random.bounded(bigCities.size()));
+    }
+    QString city;
+    const int parts = 2 + random.bounded(2);
+    for (int i = 0; i < parts; ++i) {
+        city += syllables.at(random.bounded(syllables.size()));
+    }
+    return city.left(1).toUpper() + city.mid(1).toLower();
+}
+}
+
+/**
+ * @brief Generuje syntetyczny katalog stacji w postaci dokumentów indeksu wyszukiwania.
+ *
+ * Około 10% stacji otrzymuje nazwę jednego z dużych miast, pozostałe nazwy powstają z losowych sylab.
+ * Co piąta stacja nie ma adresu (jak część stacji GIOS), a nazwa stacji ma postać "<miasto>, ul. <patron>".
+ *
+ * @param count Liczba stacji.
+ * @param seed Ziarno generatora liczb losowych.
+ * @return QVector<StationSearchIndex::Document> Dokumenty stacji.
+ */
+QVector<StationSearchIndex::Document> SyntheticGiosData::stationDocuments(int count, quint32 seed) {
+    QRandomGenerator random(seed);
+    QVector<StationSearchIndex::Document> documents;
+    documents.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const QString city = randomCity(random);
+        const QString street = QString("ul. %1 %2")
+                                   .arg(patrons.at(random.bounded(patrons.size())))
+                                   .arg(1 + random.bounded(200));
+        const QString name = QString("%1, %2").arg(city, street);
+        documents.append({city, random.bounded(5) == 0 ? QString() : street, name});
+    }
+    return documents;
+}
+
+/**
+ * @brief Zwraca tekst wyświetlany stacji w formacie "<miasto> | <adres lub nazwa stacji>".
+ *
+ * @param document Dokument stacji.
+ * @return QString Tekst wyświetlany na liście stacji.
+ */
+QString SyntheticGiosData::displayText(const StationSearchIndex::Document &document) {
+    const QString info = document.street.trimmed().isEmpty() ? document.name : document.street;
+    return info.isEmpty() ? document.city : document.city + " | " + info;
+}
+
+/**
+ * @brief Generuje listę stacji w formacie odpowiedzi `station/findAll`.
+ *
+ * @param count Liczba stacji.
+ * @param seed Ziarno generatora liczb losowych.
+ * @return QByteArray Tablica JSON stacji.
+ */
+QByteArray SyntheticGiosData::stationsJson(int count, quint32 seed) {
+    QRandomGenerator random(seed);
+    QJsonArray stations;
+
+    for (int i = 0; i < count; ++i) {
+        const QString city = randomCity(random);
+        const QString street = QString("ul. %1 %2")
+                                   .arg(patrons.at(random.bounded(patrons.size())))
+                                   .arg(1 + random.bounded(200));
+        const double latitude = 49.0 + random.generateDouble() * 5.8;
+        const double longitude = 14.1 + random.generateDouble() * 10.0;
+
+        QJsonObject commune;
+        commune["communeName"] = city;
+        commune["districtName"] = city;
+        commune["provinceName"] = provinces.at(random.bounded(provinces.size()));
+
+        QJsonObject cityObject;
+        cityObject["id"] = 1000 + i;
+        cityObject["name"] = city;
+        cityObject["commune"] = commune;
+
+        QJsonObject station;
+        station["id"] = i + 1;
+        station["stationName"] = QString("%1, %2").arg(city, street);
+        station["gegrLat"] = QString::number(latitude, 'f', 6);
+        station["gegrLon"] = QString::number(longitude, 'f', 6);
+        station["city"] = cityObject;
+        station["addressStreet"] = random.bounded(5) == 0 ? QJsonValue() : QJsonValue(street);
+        stations.append(station);
+    }
+    return QJsonDocument(stations).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Generuje listę czujników stacji w formacie odpowiedzi `station/sensors/<id>`.
+ *
+ * @param stationId Identyfikator stacji.
+ * @param sensorCount Liczba czujników stacji.
+ * @param firstSensorId Identyfikator pierwszego czujnika stacji.
+ * @return QByteArray Tablica JSON czujników.
+ */
+QByteArray SyntheticGiosData::sensorsJson(int stationId, int sensorCount, int firstSensorId) {
+    QJsonArray sensors;
+    for (int k = 0; k < sensorCount; ++k) {
+        const int sensorId = firstSensorId + k;
+        const Parameter &parameter = parameters[sensorId % ParameterCount];
+        QJsonObject param;
+        param["paramName"] = QString::fromUtf8(parameter.name);
+        param["paramFormula"] = parameter.formula;
+        param["paramCode"] = parameter.code;
+        param["idParam"] = parameter.id;
+
+        QJsonObject sensor;
+        sensor["id"] = sensorId;
+        sensor["stationId"] = stationId;
+        sensor["param"] = param;
+        sensors.append(sensor);
+    }
+    return QJsonDocument(sensors).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Generuje serię pomiarów godzinowych w formacie odpowiedzi `data/getData/<id>`.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @param hours Liczba godzin serii.
+ * @param end Godzina najnowszego pomiaru (zaokrąglana w dół do pełnej godziny).
+ * @param seed Ziarno generatora liczb losowych.
+ * @return QByteArray Obiekt JSON z kluczem parametru i tablicą wartości.
+ */
+QByteArray SyntheticGiosData::measurementsJson(int sensorId, int hours, const QDateTime &end, quint32 seed) {
+    const Parameter &parameter = parameters[sensorId % ParameterCount];
+    const qint64 endHour = end.toSecsSinceEpoch() / 3600;
+    QJsonArray values;
+
+    for (int i = 0; i < hours; ++i) {
+        const qint64 hour = endHour - i;
+        QRandomGenerator random(seed ^ static_cast<quint32>(sensorId * 2654435761u) ^ static_cast<quint32>(hour));
+        QJsonObject entry;
+        entry["date"] = QDateTime::fromSecsSinceEpoch(hour * 3600).toString("yyyy-MM-dd HH:mm:ss");
+        if (random.bounded(100) < 3) {
+            entry["value"] = QJsonValue();
+        } else {
+            const double daily = 1.0 + 0.4 * qSin(2.0 * M_PI * (hour % 24) / 24.0);
+            const double noise = 0.7 + 0.6 * random.generateDouble();
+            entry["value"] = qRound(parameter.level * daily * noise * 100.0) / 100.0;
+        }
+        values.append(entry);
+    }
+
+    QJsonObject data;
+    data["key"] = parameter.code;
+    data["values"] = values;
+    return QJsonDocument(data).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Generuje serię pomiarów godzinowych w postaci używanej przez `MeasurementHandler` i `HistoryLoader`.
+ *
+ * @param count Liczba pomiarów.
+ * @param seed Ziarno generatora liczb losowych.
+ * @return QVector<QPair<QDateTime, double>> Pary (czas, wartość), rosnąco według czasu.
+ */
+QVector<QPair<QDateTime, double>> SyntheticGiosData::measurementSeries(int count, quint32 seed) {
+    QRandomGenerator random(seed);
+    const qint64 endHour = QDateTime(QDate(2025, 1, 1), QTime(0, 0), Qt::UTC).toSecsSinceEpoch() / 3600;
+    QVector<QPair<QDateTime, double>> series;
+    series.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const qint64 hour = endHour - count + 1 + i;
+        double value = -1.0;
+        if (random.bounded(100) >= 3) {
+            const double daily = 1.0 + 0.4 * qSin(2.0 * M_PI * (hour % 24) / 24.0);
+            value = qRound(25.0 * daily * (0.7 + 0.6 * random.generateDouble()) * 100.0) / 100.0;
+        }
+        series.append(qMakePair(QDateTime::fromSecsSinceEpoch(hour * 3600, Qt::UTC), value));
+    }
+    return series;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file syntheticgiosdata.h
+ * @brief Definicja klasy SyntheticGiosData - generatora syntetycznych danych w formacie API GIOS.
+ */
+
+#ifndef SYNTHETICGIOSDATA_H
+#define SYNTHETICGIOSDATA_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QPair>
+#include <QVector>
+#include <QString>
+#include "stationsearchindex.h"
+
+class SyntheticGiosData
+{
+public:
+    /**
+     * @brief Generuje syntetyczny katalog stacji w postaci dokumentów indeksu wyszukiwania.
+     *
+     * Nazwy miast, ulic i stacji są budowane z polskich sylab i nazw patronów ulic (z polskimi znakami),
+     * a część miast to rzeczywiste duże miasta, dzięki czemu zapytania w benchmarkach mają trafienia.
+     * Dla tego samego ziarna wynik jest zawsze identyczny.
+     *
+     * @param count Liczba stacji.
+     * @param seed Ziarno generatora liczb losowych.
+     * @return QVector<StationSearchIndex::Document> Dokumenty stacji.
+     */
+    static QVector<StationSearchIndex::Document> stationDocuments(int count, quint32 seed = 2025);
+
+    /**
+     * @brief Zwraca tekst wyświetlany stacji w formacie "<miasto> | <adres lub nazwa stacji>".
+     *
+     * @param document Dokument stacji.
+     * @return QString Tekst wyświetlany na liście stacji.
+     */
+    static QString displayText(const StationSearchIndex::Document &document);
+
+    /**
+     * @brief Generuje listę stacji w formacie odpowiedzi `station/findAll`.
+     *
+     * Stacje mają identyfikatory 1..count, współrzędne w granicach Polski (zapisane jako tekst, jak w API GIOS)
+     * oraz miasto z gminą, powiatem i województwem. Dla tego samego ziarna wynik jest zawsze identyczny.
+     *
+     * @param count Liczba stacji.
+     * @param seed Ziarno generatora liczb losowych.
+     * @return QByteArray Tablica JSON stacji.
+     */
+    static QByteArray stationsJson(int count, quint32 seed = 2025);
+
+    /**
+     * @brief Generuje listę czujników stacji w formacie odpowiedzi `station/sensors/<id>`.
+     *
+     * Czujnik k (0..sensorCount-1) stacji ma identyfikator `firstSensorId + k`; wywołujący numeruje czujniki
+     * kolejnych stacji jednym licznikiem, więc identyfikatory nie powtarzają się niezależnie od liczby czujników.
+     * Rodzaj czujnika zależy tylko od jego identyfikatora (jak w `measurementsJson`).
+     *
+     * @param stationId Identyfikator stacji.
+     * @param sensorCount Liczba czujników stacji.
+     * @param firstSensorId Identyfikator pierwszego czujnika stacji.
+     * @return QByteArray Tablica JSON czujników.
+     */
+    static QByteArray sensorsJson(int stationId, int sensorCount, int firstSensorId);
+
+    /**
+     * @brief Generuje serię pomiarów godzinowych w formacie odpowiedzi `data/getData/<id>`.
+     *
+     * Wartości (od najnowszej, jak w API GIOS) mają przebieg dobowy z szumem, a około 3% z nich jest puste
+     * (null). Wartość dla danej godziny zależy tylko od czujnika, godziny i ziarna, więc kolejne odpowiedzi
+     * przesuniętych okien czasowych są ze sobą zgodne.
+     *
+     * @param sensorId Identyfikator czujnika.
+     * @param hours Liczba godzin serii.
+     * @param end Godzina najnowszego pomiaru (zaokrąglana w dół do pełnej godziny).
+     * @param seed Ziarno generatora liczb losowych.
+     * @return QByteArray Obiekt JSON z kluczem parametru i tablicą wartości.
+     */
+    static QByteArray measurementsJson(int sensorId, int hours, const QDateTime &end, quint32 seed = 2025);
+
+    /**
+     * @brief Generuje serię pomiarów godzinowych w postaci używanej przez `MeasurementHandler` i `HistoryLoader`.
+     *
+     * Pomiary są posortowane rosnąco według czasu i kończą się 1 stycznia 2025 (UTC); około 3% z nich ma
+     * wartość -1 (brak pomiaru). Dla tego samego ziarna wynik jest zawsze identyczny.
+     *
+     * @param count Liczba pomiarów.
+     * @param seed Ziarno generatora liczb losowych.
+     * @return QVector<QPair<QDateTime, double>> Pary (czas, wartość).
+     */
+    static QVector<QPair<QDateTime, double>> measurementSeries(int count, quint32 seed = 2025);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+/**
+ * @file circuitbreaker.cpp
+ * @brief Implementacja klasy CircuitBreaker - bezpiecznika żądań dla rodzin punktów końcowych API.
+ */
+
+#include "circuitbreaker.h"
+#include "apiendpoints.h"
+
+#include <QStringList>
+
+namespace {
+/** Liczba kolejnych błędów przejściowych, po której bezpiecznik się otwiera. */
+constexpr int FailureThreshold = 5;
+/** Czas pierwszego otwarcia bezpiecznika (ms), podwajany po każdym nieudanym żądaniu próbnym. */
+constexpr qint64 MinOpenDuration = 15000;
+/** Maksymalny czas otwarcia bezpiecznika (ms). */
+constexpr qint64 MaxOpenDuration = 300000;
+}
+
+/**
+ * @brief Konstruktor klasy CircuitBreaker.
+ *
+ * Uruchamia zegar monotoniczny, względem którego liczone są czasy otwarcia bezpieczników.
+ */
+CircuitBreaker::CircuitBreaker() {
+    clock.start();
+}
+
+/**
+ * @brief Zwraca rodzinę punktów końcowych, do której należy adres URL.
+ *
+ * @param url Adres URL żądania.
+ * @return QString Nazwa rodziny punktów końcowych.
+ */
+QString CircuitBreaker::familyFor(const QUrl &url) {
+    const QString basePath = ApiEndpoints::baseUrl().path();
+    QString path = url.path();
+    if (path.startsWith(basePath)) {
+        path = path.mid(basePath.size());
+    }
+    const QStringList segments = path.split('/', Qt::SkipEmptyParts);
+    return url.host() + '/' + segments.mid(0, 2).join('/');
+}
+
+/**
+ * @brief Sprawdza, czy żądanie z danej rodziny może zostać wysłane.
+ *
+ * Otwarty bezpiecznik, którego czas otwarcia minął, przechodzi w stan `HalfOpen`, a bieżące żądanie
+ * staje się żądaniem próbnym.
+ *
+ * @param family Rodzina punktów końcowych.
+ * @return bool Wartość true, jeśli żądanie może zostać wysłane.
+ */
+bool CircuitBreaker::allowRequest(const QString &family) {
+    auto it = families.find(family);
+    if (it == families.end() || it->state == Closed) {
+        return true;
+    }
+    if (it->state == Open) {
+        if (clock.elapsed() < it->openUntil) {
+            return false;
+        }
+        it->state = HalfOpen;
+    }
+    if (it->trialInFlight) {
+        return false;
+    }
+    it->trialInFlight = true;
+    return true;
+}
+
+/**
+ * @brief Zapisuje udane żądanie (zamyka bezpiecznik i zeruje licznik błędów).
+ *
+ * @param family Rodzina punktów końcowych.
+ */
+void CircuitBreaker::recordSuccess(const QString &family) {
+    families.remove(family);
+}
+
+/**
+ * @brief Zapisuje żądanie zakończone błędem przejściowym.
+ *
+ * @param family Rodzina punktów końcowych.
+ */
+void CircuitBreaker::recordFailure(const QString &family) {
+    Family &entry = families[family];
+    entry.failures++;
+    entry.trialInFlight = false;
+
+    if (entry.state == HalfOpen || (entry.state == Closed && entry.failures >= FailureThreshold)) {
+        entry.openDuration = entry.openDuration == 0 ? MinOpenDuration : qMin(entry.openDuration * 2, MaxOpenDuration);
+        entry.openUntil = clock.elapsed() + entry.openDuration;
+        entry.state = Open;
+    }
+}
+
+/**
+ * @brief Zwalnia żądanie próbne, które zostało anulowane (bez wyniku).
+ *
+ * @param family Rodzina punktów końcowych.
+ */
+void CircuitBreaker::releaseTrial(const QString &family) {
+    auto it = families.find(family);
+    if (it != families.end()) {
+        it->trialInFlight = false;
+    }
+}
+
+/**
+ * @brief Zwraca stan bezpiecznika rodziny punktów końcowych.
+ *
+ * @param family Rodzina punktów końcowych.
+ * @return State Stan bezpiecznika.
+ */
+CircuitBreaker::State CircuitBreaker::state(const QString &family) const {
+    auto it = families.constFind(family);
+    if (it == families.constEnd()) {
+        return Closed;
+    }
+    if (it->state == Open && clock.elapsed() >= it->openUntil) {
+        return HalfOpen;
+    }
+    return it->state;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * @file circuitbreaker.h
+ * @brief Definicja klasy CircuitBreaker - bezpiecznika żądań dla rodzin punktów końcowych API.
+ */
+
+#ifndef CIRCUITBREAKER_H
+#define CIRCUITBREAKER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QUrl>
+
+class CircuitBreaker
+{
+public:
+    /**
+     * @brief Stan bezpiecznika rodziny punktów końcowych.
+     *
+     * `Closed` - żądania są wysyłane; `Open` - żądania są odrzucane bez połączenia z serwerem;
+     * `HalfOpen` - po upływie czasu otwarcia przepuszczane jest jedno żądanie próbne.
+     */
+    enum State {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    /**
+     * @brief Konstruktor klasy CircuitBreaker.
+     */
+    CircuitBreaker();
+
+    /**
+     * @brief Zwraca rodzinę punktów końcowych, do której należy adres URL.
+     *
+     * Rodziną jest host i dwa pierwsze segmenty ścieżki względem adresu bazowego API (np. `station/sensors`
+     * dla `.../rest/station/sensors/114`), więc awaria jednego typu zapytań nie blokuje pozostałych.
+     *
+     * @param url Adres URL żądania.
+     * @return QString Nazwa rodziny punktów końcowych.
+     */
+    static QString familyFor(const QUrl &url);
+
+    /**
+     * @brief Sprawdza, czy żądanie z danej rodziny może zostać wysłane.
+     *
+     * W stanie `HalfOpen` zezwala tylko na jedno żądanie próbne naraz.
+     *
+     * @param family Rodzina punktów końcowych.
+     * @return bool Wartość true, jeśli żądanie może zostać wysłane.
+     */
+    bool allowRequest(const QString &family);
+
+    /**
+     * @brief Zapisuje udane żądanie (zamyka bezpiecznik i zeruje licznik błędów).
+     *
+     * @param family Rodzina punktów końcowych.
+     */
+    void recordSuccess(const QString &family);
+
+    /**
+     * @brief Zapisuje żądanie zakończone błędem przejściowym.
+     *
+     * Po serii kolejnych błędów lub nieudanym żądaniu próbnym otwiera bezpiecznik; każde kolejne otwarcie
+     * bez udanego żądania pomiędzy trwa dwa razy dłużej.
+     *
+     * @param family Rodzina punktów końcowych.
+     */
+    void recordFailure(const QString &family);
+
+    /**
+     * @brief Zwalnia żądanie próbne, które zostało anulowane (bez wyniku).
+     *
+     * @param family Rodzina punktów końcowych.
+     */
+    void releaseTrial(const QString &family);
+
+    /**
+     * @brief Zwraca stan bezpiecznika rodziny punktów końcowych.
+     *
+     * @param family Rodzina punktów końcowych.
+     * @return State Stan bezpiecznika.
+     */
+    State state(const QString &family) const;
+
+private:
+    struct Family {
+        State state = Closed;
+        int failures = 0;
+        qint64 openUntil = 0;
+        qint64 openDuration = 0;
+        bool trialInFlight = false;
+    };
+
+    QHash<QString, Family> families;
+    QElapsedTimer clock;
+};
+
+#endif
\ No newline at end of file
@@ -7,6 +7,12 @@
 #include "apiclient.h"
 #include "datamanager.h"
 #include "stationhandler.h"
+#include "stationlistmodel.h"
+
+namespace {
+/** Odstęp (ms), po którym ponawiane jest nieudane pobranie listy stacji w trybie online. */
+constexpr int StationsRetryInterval = 5000;
+}
 
 /**
  * @brief Konstruktor klasy ConnectionManager.
@@ -16,55 +22,98 @@
  * 
  * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
  */
-ConnectionManager::ConnectionManager(QObject *parent) : QObject(parent) {}
+ConnectionManager::ConnectionManager(QObject *parent) : QObject(parent) {
+    stationsRetryTimer.setSingleShot(true);
+    stationsRetryTimer.setInterval(StationsRetryInterval);
+}
 
 /**
- * @brief Sprawdza połączenie internetowe i ładuje dane stacji.
+ * @brief Śledzi stan połączenia z API i ładuje dane stacji.
  * 
- * Wykonuje żądanie sieciowe do adresu URL (http://www.google.com) w celu sprawdzenia dostępności połączenia internetowego.
- * W zależności od wyniku:
- * - Jeśli połączenie jest dostępne (`NoError`), ustawia status na "Połączono", zmienia kolor etykiety na zielony 
- *   i, jeśli lista stacji jest pusta, wysyła żądanie do API w celu pobrania danych wszystkich stacji.
- * - Jeśli brak połączenia, ustawia status na "Brak połączenia - wczytano dane lokalne", zmienia kolor etykiety na czerwony
- *   i, jeśli lista stacji jest pusta, próbuje wczytać dane stacji z lokalnego pliku JSON.
- * Po zakończeniu operacji zwalnia zasoby (`rep` i `mgr`).
+ * Ustawia tryb offline do czasu ustalenia pierwszego stanu połączenia, a następnie przy każdej zmianie 
+ * zgłoszonej sygnałem `ApiClient::connectivityChanged` wywołuje `applyConnectionState`. Sprawdzaniem 
+ * dostępności zajmuje się `HealthMonitor` w wątku roboczym (sondy HEAD do serwera API, wydłużane odstępy 
+ * w trybie offline, pomijanie sond przy udanych żądaniach), więc nie jest tu potrzebny ani timer sprawdzania 
+ * połączenia, ani osobny QNetworkAccessManager. 
+ * Jeśli pobranie listy stacji w trybie online zakończy się błędem (także gdy zamiast niej wyświetlono dane 
+ * lokalne lub nieświeżą odpowiedź z pamięci podręcznej), jest ponawiane co `StationsRetryInterval`, 
+ * dopóki nie zostanie pobrana aktualna lista - stan połączenia może się przy tym nie zmieniać. W trybie offline 
+ * ponowienie czeka na powrót połączenia (`applyConnectionState`).
  * 
  * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
- * @param stationList Wskaźnik na QListWidget, w którym wyświetlane są nazwy stacji.
+ * @param stationModel Wskaźnik na model listy stacji.
+ * @param stationList Wskaźnik na QListView, w którym wyświetlane są nazwy stacji.
  * @param lblStatus Wskaźnik na QLabel wyświetlający status połączenia.
  * @param lblStationCount Wskaźnik na QLabel wyświetlający liczbę stacji.
  * @param isOffline Referencja do flagi wskazującej, czy aplikacja działa w trybie offline.
- * @param allStations Referencja do wektora przechowującego dane wszystkich stacji (nazwa i obiekt JSON).
+ * @param catalog Referencja do katalogu stacji.
  */
-void ConnectionManager::checkConnectionAndReloadStations(ApiClient *apiClient, QListWidget *stationList, QLabel *lblStatus, QLabel *lblStationCount, bool &isOffline, QVector<QPair<QString, QJsonObject>> &allStations) {
-    QNetworkAccessManager *mgr = new QNetworkAccessManager(this);
-    QNetworkRequest req(QUrl("http://www.google.com"));
-    QNetworkReply *rep = mgr->get(req);
+void ConnectionManager::watchConnection(ApiClient *apiClient, StationListModel *stationModel, QListView *stationList, QLabel *lblStatus, QLabel *lblStationCount, bool &isOffline, StationCatalog &catalog) {
+    isOffline = true;
+    connect(apiClient, &ApiClient::connectivityChanged, this, [=, &isOffline, &catalog](bool online) {
+        applyConnectionState(online, apiClient, stationModel, stationList, lblStatus, lblStationCount, isOffline, catalog);
+    });
 
-    connect(rep, &QNetworkReply::finished, [apiClient, stationList, lblStatus, lblStationCount, &isOffline, &allStations, rep, mgr]() {
-        if (rep->error() == QNetworkReply::NoError) {
-            isOffline = false;
-            lblStatus->setText("Połączono");
-            lblStatus->setStyleSheet("color: green;");
-            if (stationList->count() == 0) {
-                apiClient->fetchData(QUrl("https://api.gios.gov.pl/pjp-api/rest/station/findAll"));
-            }
+    auto retryStations = [this](const QString &, ApiClient::RequestKind kind, int) {
+        if (kind == ApiClient::Stations) {
+            stationsRetryTimer.start();
+        }
+    };
+    connect(apiClient, &ApiClient::errorOccurred, this, retryStations);
+    connect(apiClient, &ApiClient::staleDataReady, this, retryStations);
+    connect(apiClient, &ApiClient::dataReady, this, [this](const QString &, ApiClient::RequestKind kind, int) {
+        if (kind == ApiClient::Stations) {
+            stationsRetryTimer.stop();
+        }
+    });
+    connect(&stationsRetryTimer, &QTimer::timeout, this, [this, apiClient, &isOffline]() {
+        if (isOffline) {
+            stationsRetryTimer.start();
         } else {
-            isOffline = true;
-            lblStatus->setText("Brak połączenia - wczytano dane lokalne");
-            lblStatus->setStyleSheet("color: red;");
-            if (stationList->count() == 0) {
-                QByteArray stationsData = DataManager::loadDataFromFile("stations");
-                if (!stationsData.isEmpty()) {
-                    QJsonDocument doc = QJsonDocument::fromJson(stationsData);
-                    if (doc.isArray()) {
-                        QList<QPair<QString, QJsonObject>> allStations;
-                        StationHandler::handleStationsData(doc.array(), stationList, lblStationCount, allStations);
-                    }
+            apiClient->fetchStations();
+        }
+    });
+}
+
+/**
+ * @brief Ustawia tryb online lub offline i ładuje dane stacji.
+ * 
+ * - Jeśli API jest osiągalne, ustawia status na "Połączono", zmienia kolor etykiety na zielony 
+ *   i, jeśli lista stacji jest pusta lub poprzednie pobranie się nie powiodło, wysyła żądanie do API w celu 
+ *   pobrania danych wszystkich stacji.
+ * - Jeśli API jest nieosiągalne, ustawia status na "Brak połączenia - wczytano dane lokalne", zmienia kolor etykiety na czerwony
+ *   i, jeśli lista stacji jest pusta, próbuje wczytać dane stacji z lokalnego pliku JSON.
+ * 
+ * @param online Wartość true, jeśli API jest osiągalne.
+ * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
+ * @param stationModel Wskaźnik na model listy stacji.
+ * @param stationList Wskaźnik na QListView, w którym wyświetlane są nazwy stacji.
+ * @param lblStatus Wskaźnik na QLabel wyświetlający status połączenia.
+ * @param lblStationCount Wskaźnik na QLabel wyświetlający liczbę stacji.
+ * @param isOffline Referencja do flagi wskazującej, czy aplikacja działa w trybie offline.
+ * @param catalog Referencja do katalogu stacji.
+ */
+void ConnectionManager::applyConnectionState(bool online, ApiClient *apiClient, StationListModel *stationModel, QListView *stationList, QLabel *lblStatus, QLabel *lblStationCount, bool &isOffline, StationCatalog &catalog) {
+    if (online) {
+        isOffline = false;
+        lblStatus->setText("Połączono");
+        lblStatus->setStyleSheet("color: green;");
+        if (stationModel->totalCount() == 0 || stationsRetryTimer.isActive()) {
+            stationsRetryTimer.stop();
+            apiClient->fetchStations();
+        }
+    } else {
+        isOffline = true;
+        lblStatus->setText("Brak połączenia - wczytano dane lokalne");
+        lblStatus->setStyleSheet("color: red;");
+        if (stationModel->totalCount() == 0) {
+            QByteArray stationsData = DataManager::loadDataFromFile("stations");
+            if (!stationsData.isEmpty()) {
+                QJsonDocument doc = QJsonDocument::fromJson(stationsData);
+                if (doc.isArray()) {
+                    StationHandler::handleStationsData(doc.array(), stationModel, stationList, lblStationCount, catalog);
                 }
             }
         }
-        rep->deleteLater();
-        mgr->deleteLater();
-    });
+    }
 }
\ No newline at end of file
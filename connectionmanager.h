@@ -7,14 +7,14 @@
 #define CONNECTIONMANAGER_H
 
 #include <QObject>
-#include <QListWidget>
+#include <QListView>
 #include <QLabel>
-#include <QNetworkAccessManager>
-#include <QNetworkRequest>
-#include <QNetworkReply>
 #include <QJsonDocument>
+#include <QTimer>
 
 class ApiClient;
+class StationCatalog;
+class StationListModel;
 
 class ConnectionManager : public QObject
 {
@@ -31,20 +31,32 @@ public:
     explicit ConnectionManager(QObject *parent = nullptr);
 
     /**
-     * @brief Sprawdza połączenie internetowe i ładuje dane stacji.
+     * @brief Śledzi stan połączenia z API i ładuje dane stacji.
      * 
-     * Sprawdza dostępność połączenia internetowego i w zależności od wyniku ładuje dane stacji 
-     * z API (jeśli online) lub z lokalnego pliku (jeśli offline). Aktualizuje status połączenia 
-     * i listę stacji w interfejsie użytkownika.
+     * Reaguje na sygnał `ApiClient::connectivityChanged` (zgłaszany przez monitor dostępności API działający 
+     * w wątku roboczym) i w zależności od stanu ładuje dane stacji z API (jeśli online) lub z lokalnego pliku 
+     * (jeśli offline). Aktualizuje status połączenia i listę stacji w interfejsie użytkownika. Do czasu 
+     * ustalenia pierwszego stanu aplikacja działa w trybie offline.
      * 
      * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
-     * @param stationList Wskaźnik na QListWidget, w którym wyświetlane są nazwy stacji.
+     * @param stationModel Wskaźnik na model listy stacji.
+     * @param stationList Wskaźnik na QListView, w którym wyświetlane są nazwy stacji.
      * @param lblStatus Wskaźnik na QLabel wyświetlający status połączenia.
      * @param lblStationCount Wskaźnik na QLabel wyświetlający liczbę stacji.
      * @param isOffline Referencja do flagi wskazującej, czy aplikacja działa w trybie offline.
-     * @param allStations Referencja do wektora przechowującego dane wszystkich stacji (nazwa i obiekt JSON).
+     * @param catalog Referencja do katalogu stacji.
      */
-    void checkConnectionAndReloadStations(ApiClient *apiClient, QListWidget *stationList, QLabel *lblStatus, QLabel *lblStationCount, bool &isOffline, QVector<QPair<QString, QJsonObject>> &allStations);
+    void watchConnection(ApiClient *apiClient, StationListModel *stationModel, QListView *stationList, QLabel *lblStatus, QLabel *lblStationCount, bool &isOffline, StationCatalog &catalog);
+
+private:
+    /**
+     * @brief Ustawia tryb online lub offline i ładuje dane stacji.
+     * 
+     * @param online Wartość true, jeśli API jest osiągalne.
+     */
+    void applyConnectionState(bool online, ApiClient *apiClient, StationListModel *stationModel, QListView *stationList, QLabel *lblStatus, QLabel *lblStationCount, bool &isOffline, StationCatalog &catalog);
+
+    QTimer stationsRetryTimer; ///< Ponawia pobieranie listy stacji, dopóki nie zostanie pobrana aktualna lista.
 };
 
 #endif
\ No newline at end of file
@@ -4,6 +4,243 @@
  */
 
 #include "datamanager.h"
+#include "metrics.h"
+#include "taskexecutor.h"
+#include "tracing.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <atomic>
+
+#ifdef Q_OS_WIN
+#include <qt_windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/** Nazwa pliku blokady zapisu w katalogu danych aplikacji. */
+const char *const LockFileName = "store.lock";
+/** Maksymalny czas oczekiwania na blokadę zapisu innego procesu poza wątkiem interfejsu (ms). */
+constexpr int LockTimeout = 5000;
+/** Odstęp (ms) między kolejnymi próbami założenia blokady zapisu zajętej przez inny proces. */
+constexpr int LockPollInterval = 10;
+/** Liczba prób opublikowania pliku (zamiany nazwy), np. gdy w systemie Windows plik jest chwilowo otwarty. */
+constexpr int CommitAttempts = 3;
+/** Opóźnienie między próbami opublikowania pliku (ms). */
+constexpr int CommitRetryDelay = 20;
+
+/** Ostatnio ustalony rozmiar magazynu danych w bajtach (-1 przed pierwszym wyznaczeniem). */
+std::atomic<qint64> knownStoreSize{-1};
+/** Wartość true, gdy wyznaczanie rozmiaru magazynu danych jest w toku. */
+std::atomic<bool> storeScanRunning{false};
+
+/**
+ * @brief Plik blokady zapisu wspólny dla procesów, otwarty przez cały czas działania procesu.
+ * 
+ * Blokada jest doradcza (`flock`, w systemie Windows `LockFileEx`) i zakładana bez czekania, więc plik nie jest 
+ * tworzony ani usuwany przy każdym zapisie, a po awarii procesu system operacyjny zwalnia blokadę sam.
+ */
+class StoreLockFile
+{
+public:
+    ~StoreLockFile() {
+#ifdef Q_OS_WIN
+        if (handle != INVALID_HANDLE_VALUE) CloseHandle(handle);
+#else
+        if (fd >= 0) ::close(fd);
+#endif
+    }
+
+    /**
+     * @brief Próbuje założyć blokadę bez czekania.
+     * 
+     * @return bool Wartość true, jeśli blokada została założona.
+     */
+    bool tryLock() {
+        if (!open()) {
+            return false;
+        }
+#ifdef Q_OS_WIN
+        OVERLAPPED overlapped = {};
+        return LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &overlapped);
+#else
+        return ::flock(fd, LOCK_EX | LOCK_NB) == 0;
+#endif
+    }
+
+    /**
+     * @brief Zwalnia blokadę (plik pozostaje otwarty).
+     */
+    void unlock() {
+#ifdef Q_OS_WIN
+        OVERLAPPED overlapped = {};
+        UnlockFileEx(handle, 0, 1, 0, &overlapped);
+#else
+        ::flock(fd, LOCK_UN);
+#endif
+    }
+
+private:
+    bool open() {
+#ifdef Q_OS_WIN
+        if (handle != INVALID_HANDLE_VALUE) {
+            return true;
+        }
+#else
+        if (fd >= 0) {
+            return true;
+        }
+#endif
+        const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        QDir().mkpath(dataDir);
+        const QString path = QDir(dataDir).filePath(LockFileName);
+#ifdef Q_OS_WIN
+        handle = CreateFileW(reinterpret_cast<const wchar_t *>(QDir::toNativeSeparators(path).utf16()), GENERIC_READ | GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        return handle != INVALID_HANDLE_VALUE;
+#else
+        fd = ::open(QFile::encodeName(path).constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        return fd >= 0;
+#endif
+    }
+
+#ifdef Q_OS_WIN
+    HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+    int fd = -1;
+#endif
+};
+
+/**
+ * @brief Stan blokady zapisu w bieżącym procesie.
+ * 
+ * Muteks rekurencyjny szereguje zapisy wątków procesu i pozwala zagnieżdżać `WriteLock`; plik blokady 
+ * jest blokowany tylko przez najbardziej zewnętrzną blokadę. Zapisy odłożone przez wątek interfejsu 
+ * (`deferred`, najnowsza zawartość dla każdej ścieżki) są chronione osobnym muteksem, bo wątek interfejsu 
+ * dodaje je bez blokady zapisu.
+ */
+struct WriterState {
+    QRecursiveMutex mutex;
+    int depth = 0;
+    bool fileLocked = false;
+    StoreLockFile lockFile;
+    QMutex deferredMutex;
+    QHash<QString, QByteArray> deferred;
+    bool flushScheduled = false;
+};
+
+WriterState &writerState() {
+    static WriterState state;
+    return state;
+}
+
+/**
+ * @brief Sprawdza, czy bieżący wątek jest wątkiem interfejsu (głównym wątkiem aplikacji).
+ */
+bool isGuiThread() {
+    const QCoreApplication *app = QCoreApplication::instance();
+    return app && QThread::currentThread() == app->thread();
+}
+
+/**
+ * @brief Zapisuje w metrykach zapis pliku: liczbę plików, bajty i czas zapisu.
+ * 
+ * @param bytes Liczba zapisanych bajtów.
+ * @param timer Zegar uruchomiony przed otwarciem pliku.
+ */
+void recordWrite(qint64 bytes, const QElapsedTimer &timer) {
+    static Metrics::Counter &files = Metrics::counter("mjp_store_writes_total", "Pliki zapisane w magazynie danych");
+    static Metrics::Counter &written = Metrics::counter("mjp_store_written_bytes_total", "Bajty zapisane w magazynie danych");
+    static Metrics::Histogram &duration = Metrics::histogram("mjp_store_write_duration_microseconds", "Czas zapisu pliku w magazynie danych");
+    files.add();
+    written.add(static_cast<quint64>(bytes));
+    duration.record(timer.nsecsElapsed() / 1000);
+}
+
+/**
+ * @brief Zapisuje w metrykach odczyt pliku.
+ * 
+ * @param bytes Liczba odczytanych bajtów.
+ */
+void recordRead(qint64 bytes) {
+    static Metrics::Counter &read = Metrics::counter("mjp_store_read_bytes_total", "Bajty odczytane z magazynu danych");
+    read.add(static_cast<quint64>(bytes));
+}
+}
+
+/**
+ * @brief Zakłada blokadę zapisu magazynu danych.
+ * 
+ * Najbardziej zewnętrzna blokada w procesie blokuje plik blokady (`StoreLockFile`) w katalogu danych aplikacji. 
+ * W trybie `Wait` ponawia próby co `LockPollInterval` ms przez najwyżej `LockTimeout` ms; jeśli inny proces 
+ * nie zwolni blokady w tym czasie, zapis jest kontynuowany bez niej: dzięki publikacji przez zamianę nazwy 
+ * czytelnicy nadal widzą kompletne pliki, a ryzykiem jest jedynie utrata zmian równoległej sekwencji 
+ * odczyt-zmiana-zapis. W trybie `TryOnly` blokada jest zakładana tylko wtedy, gdy ani inny wątek, ani inny 
+ * proces jej nie trzyma (`isLocked`).
+ * 
+ * @param mode Tryb zakładania blokady.
+ */
+DataManager::WriteLock::WriteLock(Mode mode)
+    : locked(false)
+{
+    static Metrics::Histogram &wait = Metrics::histogram("mjp_store_lock_wait_microseconds", "Czas oczekiwania na blokadę zapisu magazynu danych");
+    WriterState &state = writerState();
+    if (mode == TryOnly) {
+        if (!state.mutex.tryLock()) {
+            return;
+        }
+    } else {
+        state.mutex.lock();
+    }
+    if (state.depth > 0) {
+        state.depth++;
+        locked = true;
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    state.fileLocked = state.lockFile.tryLock();
+    if (!state.fileLocked && mode == TryOnly) {
+        state.mutex.unlock();
+        return;
+    }
+    while (!state.fileLocked && timer.elapsed() < LockTimeout) {
+        QThread::msleep(LockPollInterval);
+        state.fileLocked = state.lockFile.tryLock();
+    }
+    if (!state.fileLocked) {
+        qWarning() << "Nie można założyć blokady zapisu magazynu danych w ciągu" << LockTimeout << "ms";
+    }
+    wait.record(timer.nsecsElapsed() / 1000);
+    state.depth = 1;
+    locked = true;
+}
+
+/**
+ * @brief Zwalnia blokadę zapisu; najbardziej zewnętrzna blokada odblokowuje plik blokady.
+ */
+DataManager::WriteLock::~WriteLock() {
+    if (!locked) {
+        return;
+    }
+    WriterState &state = writerState();
+    if (--state.depth == 0 && state.fileLocked) {
+        state.lockFile.unlock();
+        state.fileLocked = false;
+    }
+    state.mutex.unlock();
+}
 
 /**
  * @brief Generuje ścieżkę do pliku danych na podstawie nazwy i identyfikatora.
@@ -31,21 +268,19 @@ QString DataManager::getDataFilePath(const QString &baseFileName, int id) {
 /**
  * @brief Zapisuje dane do pliku JSON.
  * 
- * Otwiera plik w trybie zapisu i zapisuje podane dane (QByteArray) w katalogu danych aplikacji. 
+ * Zapisuje podane dane (QByteArray) w katalogu danych aplikacji przez `writeFile`, więc inne procesy 
+ * odczytują poprzednią albo nową zawartość pliku, nigdy częściowo zapisaną. W wątku interfejsu zapis 
+ * nie czeka na blokadę zapisu zajętą przez inny proces - jest wtedy odkładany do wspólnej puli wątków. 
  * Ścieżka pliku jest generowana za pomocą getDataFilePath.
  * 
  * @param baseFileName Bazowa nazwa pliku (np. "stations").
  * @param data Dane do zapisania w formacie QByteArray.
  * @param id Identyfikator, domyślnie -1 (brak identyfikatora w nazwie pliku).
- * @note Jeśli plik nie może zostać otwarty, dane nie zostaną zapisane.
+ * @note Jeśli plik nie może zostać zapisany, poprzednia zawartość pozostaje bez zmian.
  */
 void DataManager::saveDataToFile(const QString &baseFileName, const QByteArray &data, int id) {
-    QString path = getDataFilePath(baseFileName, id);
-    QFile file(path);
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(data);
-        file.close();
-    }
+    MJP_TRACE_SCOPE("DataManager::saveDataToFile");
+    writeFile(getDataFilePath(baseFileName, id), data);
 }
 
 /**
@@ -57,13 +292,17 @@ void DataManager::saveDataToFile(const QString &baseFileName, const QByteArray &
  * @param baseFileName Bazowa nazwa pliku (np. "stations").
  * @param id Identyfikator, domyślnie -1 (brak identyfikatora w nazwie pliku).
  * @return QByteArray Zawartość pliku lub pusty QByteArray w przypadku błędu.
+ * @note Odczyt nie czeka na blokadę zapisu: pliki są publikowane przez zamianę nazwy, więc zawsze mają 
+ *       kompletną zawartość, nawet gdy inny proces właśnie zapisuje ten sam plik.
  */
 QByteArray DataManager::loadDataFromFile(const QString &baseFileName, int id) {
+    MJP_TRACE_SCOPE("DataManager::loadDataFromFile");
     QString path = getDataFilePath(baseFileName, id);
     QFile file(path);
     if (file.open(QIODevice::ReadOnly)) {
         QByteArray data = file.readAll();
         file.close();
+        recordRead(data.size());
         return data;
     }
     return QByteArray();
@@ -75,15 +314,19 @@ QByteArray DataManager::loadDataFromFile(const QString &baseFileName, int id) {
  * Zapisuje dane historyczne do pliku w katalogu danych aplikacji. Nazwa pliku zależy od typu danych:
  * - Dla "stations": "stations.json".
  * - Dla "sensors": "<type>_<id>.json".
- * - Dla "measurements": "<type>_<id>_<timestamp>.json" z bieżącym znacznikiem czasu.
- * Jeśli katalog nie istnieje, tworzy go.
+ * - Dla "measurements": "<type>_<id>_<timestamp>.json" z podanym (domyślnie bieżącym) znacznikiem czasu. 
+ *   Plik z tym samym znacznikiem czasu jest nadpisywany, więc ponowny zapis tych samych danych archiwalnych 
+ *   nie tworzy duplikatów.
+ * Jeśli katalog nie istnieje, tworzy go. Plik jest publikowany atomowo (`writeFile`).
  * 
  * @param type Typ danych ("stations", "sensors", "measurements").
  * @param data Dane do zapisania w formacie QByteArray.
  * @param id Identyfikator, domyślnie -1 (używany dla czujników i pomiarów).
- * @note Jeśli plik nie może zostać otwarty, dane nie zostaną zapisane.
+ * @param timestamp Znacznik czasu w nazwie pliku pomiarów; niepoprawny oznacza bieżący czas.
+ * @note Jeśli plik nie może zostać zapisany, poprzednia zawartość pozostaje bez zmian.
  */
-void DataManager::saveHistoricalData(const QString &type, const QByteArray &data, int id) {
+void DataManager::saveHistoricalData(const QString &type, const QByteArray &data, int id, const QDateTime &timestamp) {
+    MJP_TRACE_SCOPE("DataManager::saveHistoricalData");
     QString fileName;
 
     if (type == "stations") {
@@ -91,19 +334,15 @@ void DataManager::saveHistoricalData(const QString &type, const QByteArray &data
     } else if (type == "sensors") {
         fileName = QString("%1_%2.json").arg(type).arg(id);
     } else {
-        QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
-        fileName = QString("%1_%2_%3.json").arg(type).arg(id).arg(timestamp);
+        const QDateTime time = timestamp.isValid() ? timestamp : QDateTime::currentDateTime();
+        fileName = QString("%1_%2_%3.json").arg(type).arg(id).arg(time.toString("yyyyMMdd_HHmmss"));
     }
 
     QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir dir(path);
     if (!dir.exists()) dir.mkpath(".");
 
-    QFile file(dir.filePath(fileName));
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(data);
-        file.close();
-    }
+    writeFile(dir.filePath(fileName), data);
 }
 
 /**
@@ -119,6 +358,7 @@ void DataManager::saveHistoricalData(const QString &type, const QByteArray &data
  * @note Funkcja przetwarza tylko pliki zgodne z wzorcem nazwy dla typu "measurements".
  */
 QVector<QPair<QDateTime, QByteArray>> DataManager::loadAllHistoricalData(const QString &type, int id) {
+    MJP_TRACE_SCOPE("DataManager::loadAllHistoricalData");
     QVector<QPair<QDateTime, QByteArray>> result;
     QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir dir(path);
@@ -135,10 +375,167 @@ QVector<QPair<QDateTime, QByteArray>> DataManager::loadAllHistoricalData(const Q
                     QString timestampStr = parts[2] + "_" + parts[3].left(6);
                     QDateTime dt = QDateTime::fromString(timestampStr, "yyyyMMdd_HHmmss");
                     result.append(qMakePair(dt, f.readAll()));
+                    recordRead(result.last().second.size());
                 }
                 f.close();
             }
         }
     }
     return result;
+}
+
+/**
+ * @brief Zwraca listę plików z danymi historycznymi dla danego identyfikatora.
+ * 
+ * Wyszukuje pliki w formacie "<type>_<id>_<timestamp>.json" w katalogu danych aplikacji. Znacznik czasu 
+ * w nazwie ma stałą szerokość, więc sortowanie po nazwie porządkuje pliki od najstarszego do najnowszego.
+ * 
+ * @param type Typ danych ("measurements").
+ * @param id Identyfikator czujnika.
+ * @return QStringList Pełne ścieżki plików, od najstarszego do najnowszego.
+ * @note Funkcja nie odczytuje zawartości plików.
+ */
+QStringList DataManager::historicalDataFiles(const QString &type, int id) {
+    MJP_TRACE_SCOPE("DataManager::historicalDataFiles");
+    QStringList result;
+    QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir dir(path);
+
+    QString filter = QString("%1_%2_*.json").arg(type).arg(id);
+    const QStringList files = dir.entryList(QStringList() << filter, QDir::Files, QDir::Name);
+    result.reserve(files.size());
+    for (const QString &file : files) {
+        result.append(dir.filePath(file));
+    }
+    return result;
+}
+
+/**
+ * @brief Zwraca łączny rozmiar plików w katalogu danych aplikacji.
+ * 
+ * Przechodzi rekurencyjnie przez katalog danych (`QStandardPaths::AppDataLocation`) i sumuje rozmiary plików.
+ * 
+ * @return qint64 Rozmiar magazynu danych w bajtach.
+ * @note Funkcja odczytuje tylko metadane plików, ale jej koszt rośnie z liczbą plików.
+ */
+qint64 DataManager::storeSize() {
+    MJP_TRACE_SCOPE("DataManager::storeSize");
+    qint64 size = 0;
+    QDirIterator it(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+    return size;
+}
+
+/**
+ * @brief Zwraca ostatnio ustalony rozmiar magazynu danych bez przechodzenia przez katalog.
+ * 
+ * @return qint64 Rozmiar magazynu danych w bajtach lub -1, jeśli nie został jeszcze wyznaczony.
+ */
+qint64 DataManager::cachedStoreSize() {
+    return knownStoreSize.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Zleca ponowne wyznaczenie rozmiaru magazynu danych we wspólnej puli wątków (z niskim priorytetem).
+ * 
+ * Między kolejnymi wyznaczeniami rozmiar jest aktualizowany przy zapisach tego procesu (`writeFile`), 
+ * a ponowne wyznaczenie uwzględnia także pliki zapisane lub usunięte przez inne procesy.
+ */
+void DataManager::refreshStoreSize() {
+    if (storeScanRunning.exchange(true)) {
+        return;
+    }
+    TaskExecutor::instance().submit([]() {
+        knownStoreSize.store(storeSize(), std::memory_order_relaxed);
+        storeScanRunning.store(false);
+    }, TaskExecutor::Low);
+}
+
+/**
+ * @brief Zapisuje plik magazynu danych pod blokadą zapisu.
+ * 
+ * Poza wątkiem interfejsu czeka na blokadę `WriteLock` i zapisuje plik od razu. Wątek interfejsu nie czeka: 
+ * jeśli blokadę trzyma inny wątek lub proces, zawartość jest odkładana (`deferred`, nowsza zawartość tej samej 
+ * ścieżki zastępuje starszą) i zapisywana we wspólnej puli wątków (`flushDeferredWrites`). Zapis wykonany 
+ * od razu usuwa odłożoną, starszą zawartość tej samej ścieżki.
+ * 
+ * @param path Ścieżka pliku docelowego.
+ * @param data Dane do zapisania.
+ * @return bool Wartość true, jeśli plik został opublikowany lub jego zapis odłożony.
+ */
+bool DataManager::writeFile(const QString &path, const QByteArray &data) {
+    WriterState &state = writerState();
+    WriteLock lock(isGuiThread() ? WriteLock::TryOnly : WriteLock::Wait);
+    if (!lock.isLocked()) {
+        QMutexLocker locker(&state.deferredMutex);
+        state.deferred.insert(path, data);
+        if (!state.flushScheduled) {
+            state.flushScheduled = true;
+            TaskExecutor::instance().submit(&DataManager::flushDeferredWrites, TaskExecutor::Low);
+        }
+        return true;
+    }
+    {
+        QMutexLocker locker(&state.deferredMutex);
+        state.deferred.remove(path);
+    }
+    return commitFile(path, data);
+}
+
+/**
+ * @brief Zapisuje odłożone przez wątek interfejsu pliki pod jedną blokadą zapisu.
+ * 
+ * Odłożone zapisy są pobierane dopiero po założeniu blokady, więc zapis wykonany w międzyczasie od razu 
+ * nie zostanie nadpisany starszą zawartością.
+ */
+void DataManager::flushDeferredWrites() {
+    WriterState &state = writerState();
+    WriteLock lock;
+    QHash<QString, QByteArray> writes;
+    {
+        QMutexLocker locker(&state.deferredMutex);
+        writes.swap(state.deferred);
+        state.flushScheduled = false;
+    }
+    for (auto it = writes.cbegin(); it != writes.cend(); ++it) {
+        commitFile(it.key(), it.value());
+    }
+}
+
+/**
+ * @brief Publikuje plik magazynu danych atomowo.
+ * 
+ * Dane trafiają do pliku tymczasowego w tym samym katalogu (`QSaveFile`), który po zapisaniu na dysk 
+ * zastępuje plik docelowy przez zamianę nazwy. Czytelnicy (także w innych procesach) nie zakładają blokady: 
+ * otwarty plik ma zawsze kompletną zawartość - poprzednią albo nową. Wywoływana pod blokadą `WriteLock`, 
+ * więc w danej chwili pisze tylko jeden proces. Nieudana zamiana nazwy (np. w systemie Windows, gdy plik 
+ * docelowy jest chwilowo otwarty bez prawa usunięcia) jest ponawiana `CommitAttempts` razy. 
+ * Po zapisie znany rozmiar magazynu (`cachedStoreSize`) jest zwiększany o różnicę rozmiarów pliku.
+ * 
+ * @param path Ścieżka pliku docelowego.
+ * @param data Dane do zapisania.
+ * @return bool Wartość true, jeśli plik został opublikowany.
+ */
+bool DataManager::commitFile(const QString &path, const QByteArray &data) {
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 previousSize = QFileInfo(path).size();
+    for (int attempt = 1; ; ++attempt) {
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly) && file.write(data) == data.size() && file.commit()) {
+            qint64 known = knownStoreSize.load(std::memory_order_relaxed);
+            while (known >= 0 && !knownStoreSize.compare_exchange_weak(known, known + data.size() - previousSize)) {
+            }
+            recordWrite(data.size(), timer);
+            return true;
+        }
+        if (attempt == CommitAttempts) {
+            qWarning().noquote() << "Nie można zapisać pliku" << path << ":" << file.errorString();
+            return false;
+        }
+        QThread::msleep(CommitRetryDelay);
+    }
 }
\ No newline at end of file
@@ -21,6 +21,41 @@
 class DataManager
 {
 public:
+    /**
+     * @brief Blokada zapisu magazynu danych, wspólna dla wszystkich procesów MJP (plik "store.lock").
+     * 
+     * Zapisy (`saveDataToFile`, `saveHistoricalData`) zakładają ją same; jawnie należy ją założyć tylko 
+     * na czas sekwencji odczyt-zmiana-zapis (np. scalania punktu kontrolnego), aby inny proces nie nadpisał 
+     * zmian. W jednym procesie blokada może być zakładana wielokrotnie (także zagnieżdżona), a odczyty 
+     * nigdy na nią nie czekają. Blokada w trybie `Wait` może czekać na inny proces, więc nie należy jej 
+     * zakładać w wątku interfejsu.
+     */
+    class WriteLock
+    {
+    public:
+        /**
+         * @brief Tryb zakładania blokady.
+         */
+        enum Mode {
+            Wait,    ///< Czeka na zwolnienie blokady przez inny wątek lub proces (najwyżej kilka sekund).
+            TryOnly  ///< Nie czeka; `isLocked` zwraca false, jeśli blokada jest zajęta.
+        };
+
+        explicit WriteLock(Mode mode = Wait);
+        ~WriteLock();
+
+        WriteLock(const WriteLock &) = delete;
+        WriteLock &operator=(const WriteLock &) = delete;
+
+        /**
+         * @brief Sprawdza, czy blokada została założona (w trybie `Wait` zawsze true).
+         */
+        bool isLocked() const { return locked; }
+
+    private:
+        bool locked;
+    };
+
     /**
      * @brief Generuje ścieżkę do pliku danych na podstawie nazwy i identyfikatora.
      * 
@@ -66,8 +101,9 @@ public:
      * @param type Typ danych ("stations", "sensors", "measurements").
      * @param data Dane do zapisania w formacie QByteArray.
      * @param id Identyfikator, domyślnie -1 (używany dla czujników i pomiarów).
+     * @param timestamp Znacznik czasu w nazwie pliku pomiarów; niepoprawny (domyślnie) oznacza bieżący czas.
      */
-    static void saveHistoricalData(const QString &type, const QByteArray &data, int id = -1);
+    static void saveHistoricalData(const QString &type, const QByteArray &data, int id = -1, const QDateTime &timestamp = QDateTime());
 
     /**
      * @brief Wczytuje wszystkie historyczne dane pomiarów dla danego identyfikatora.
@@ -81,6 +117,49 @@ public:
      * @return QVector<QPair<QDateTime, QByteArray>> Wektor par zawierających czas i dane.
      */
     static QVector<QPair<QDateTime, QByteArray>> loadAllHistoricalData(const QString &type, int id);
+
+    /**
+     * @brief Zwraca listę plików z danymi historycznymi dla danego identyfikatora.
+     * 
+     * Pozwala wczytywać pliki pojedynczo (np. w wątku roboczym, z możliwością przerwania), 
+     * zamiast wczytywać wszystkie naraz do pamięci.
+     * 
+     * @param type Typ danych ("measurements").
+     * @param id Identyfikator czujnika.
+     * @return QStringList Pełne ścieżki plików, od najstarszego do najnowszego.
+     */
+    static QStringList historicalDataFiles(const QString &type, int id);
+
+    /**
+     * @brief Zwraca łączny rozmiar plików w katalogu danych aplikacji.
+     * 
+     * Przechodzi przez cały katalog danych, więc nie należy jej wywoływać w wątku interfejsu; metryka rozmiaru 
+     * magazynu danych korzysta z `cachedStoreSize` i `refreshStoreSize`.
+     * 
+     * @return qint64 Rozmiar magazynu danych w bajtach.
+     */
+    static qint64 storeSize();
+
+    /**
+     * @brief Zwraca ostatnio ustalony rozmiar magazynu danych bez przechodzenia przez katalog.
+     * 
+     * Wartość jest wyznaczana przez `refreshStoreSize` i aktualizowana przy każdym zapisie pliku przez `DataManager`.
+     * 
+     * @return qint64 Rozmiar magazynu danych w bajtach lub -1, jeśli nie został jeszcze wyznaczony.
+     */
+    static qint64 cachedStoreSize();
+
+    /**
+     * @brief Zleca ponowne wyznaczenie rozmiaru magazynu danych (`storeSize`) we wspólnej puli wątków.
+     * 
+     * Nie czeka na wynik; jeśli wyznaczanie jest już w toku, nie zleca kolejnego.
+     */
+    static void refreshStoreSize();
+
+private:
+    static bool writeFile(const QString &path, const QByteArray &data);
+    static void flushDeferredWrites();
+    static bool commitFile(const QString &path, const QByteArray &data);
 };
 
 #endif
\ No newline at end of file
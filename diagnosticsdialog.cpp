@@ -0,0 +1,136 @@
+/**
+ * @file diagnosticsdialog.cpp
+ * @brief Implementacja klasy DiagnosticsDialog - panelu diagnostycznego z bieżącymi metrykami aplikacji.
+ */
+
+#include "diagnosticsdialog.h"
+#include "metrics.h"
+
+#include <QHeaderView>
+#include <QLabel>
+#include <QLocale>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+namespace {
+/** Odstęp odświeżania panelu (ms). */
+constexpr int RefreshInterval = 1000;
+
+enum Column {
+    NameColumn,
+    LabelsColumn,
+    ValueColumn,
+    P50Column,
+    P90Column,
+    P99Column,
+    ColumnCount
+};
+
+/**
+ * @brief Ustawia tekst komórki, tworząc ją przy pierwszym użyciu.
+ */
+void setCell(QTableWidget *table, int row, int column, const QString &text) {
+    QTableWidgetItem *item = table->item(row, column);
+    if (!item) {
+        item = new QTableWidgetItem;
+        if (column >= ValueColumn) {
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        table->setItem(row, column, item);
+    }
+    if (item->text() != text) {
+        item->setText(text);
+    }
+}
+}
+
+/**
+ * @brief Konstruktor klasy DiagnosticsDialog.
+ *
+ * Tabela ma kolumny: metryka, etykiety, wartość (dla histogramów - liczba pomiarów) oraz kwantyle
+ * p50/p90/p99 histogramów. Opis metryki jest wyświetlany w podpowiedzi wiersza. Pod tabelą wyświetlany jest
+ * współczynnik trafień pamięci podręcznej wyliczony z liczników `mjp_cache_lookups_total`.
+ *
+ * @param parent Wskaźnik na widżet nadrzędny.
+ */
+DiagnosticsDialog::DiagnosticsDialog(QWidget *parent)
+    : QDialog(parent)
+    , table(new QTableWidget(0, ColumnCount, this))
+    , lblSummary(new QLabel(this))
+    , refreshTimer(new QTimer(this))
+{
+    setWindowTitle("Diagnostyka");
+    resize(820, 480);
+
+    table->setHorizontalHeaderLabels({"Metryka", "Etykiety", "Wartość", "p50", "p90", "p99"});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->verticalHeader()->hide();
+    table->horizontalHeader()->setSectionResizeMode(LabelsColumn, QHeaderView::Stretch);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(table);
+    layout->addWidget(lblSummary);
+
+    refreshTimer->setInterval(RefreshInterval);
+    connect(refreshTimer, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+}
+
+/**
+ * @brief Odświeża tabelę i uruchamia cykliczne odświeżanie po wyświetleniu panelu.
+ */
+void DiagnosticsDialog::showEvent(QShowEvent *event) {
+    QDialog::showEvent(event);
+    refresh();
+    refreshTimer->start();
+}
+
+/**
+ * @brief Zatrzymuje odświeżanie ukrytego panelu.
+ */
+void DiagnosticsDialog::hideEvent(QHideEvent *event) {
+    refreshTimer->stop();
+    QDialog::hideEvent(event);
+}
+
+/**
+ * @brief Odczytuje bieżące metryki i aktualizuje tabelę.
+ *
+ * Istniejące komórki są aktualizowane w miejscu (tylko przy zmianie tekstu), więc zaznaczenie i przewinięcie
+ * tabeli są zachowywane między odświeżeniami.
+ */
+void DiagnosticsDialog::refresh() {
+    const QVector<Metrics::Sample> samples = Metrics::snapshot();
+    const QLocale locale;
+    double hits = 0;
+    double lookups = 0;
+
+    table->setRowCount(samples.size());
+    for (int row = 0; row < samples.size(); ++row) {
+        const Metrics::Sample &sample = samples.at(row);
+        setCell(table, row, NameColumn, sample.name);
+        setCell(table, row, LabelsColumn, sample.labels);
+        setCell(table, row, ValueColumn, locale.toString(sample.value, 'f', 0));
+        const bool histogram = sample.type == Metrics::HistogramType;
+        setCell(table, row, P50Column, histogram ? locale.toString(sample.p50) : QString());
+        setCell(table, row, P90Column, histogram ? locale.toString(sample.p90) : QString());
+        setCell(table, row, P99Column, histogram ? locale.toString(sample.p99) : QString());
+        table->item(row, NameColumn)->setToolTip(sample.help);
+
+        if (sample.name == "mjp_cache_lookups_total") {
+            lookups += sample.value;
+            if (sample.labels != Metrics::label("result", "miss")) {
+                hits += sample.value;
+            }
+        }
+    }
+    table->resizeColumnToContents(NameColumn);
+
+    lblSummary->setText(lookups > 0
+                            ? QString("Trafienia pamięci podręcznej: %1% (%2 z %3 odpowiedzi)")
+                                  .arg(locale.toString(100.0 * hits / lookups, 'f', 1))
+                                  .arg(hits)
+                                  .arg(lookups)
+                            : QString("Trafienia pamięci podręcznej: brak danych"));
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+/**
+ * @file diagnosticsdialog.h
+ * @brief Definicja klasy DiagnosticsDialog - panelu diagnostycznego z bieżącymi metrykami aplikacji.
+ */
+
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+
+class QLabel;
+class QTableWidget;
+class QTimer;
+
+class DiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy DiagnosticsDialog.
+     *
+     * Tworzy tabelę metryk (`Metrics::snapshot`), odświeżaną co sekundę, gdy panel jest widoczny.
+     *
+     * @param parent Wskaźnik na widżet nadrzędny, domyślnie nullptr.
+     */
+    explicit DiagnosticsDialog(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    /**
+     * @brief Odczytuje bieżące metryki i aktualizuje tabelę.
+     */
+    void refresh();
+
+private:
+    QTableWidget *table;
+    QLabel *lblSummary;
+    QTimer *refreshTimer;
+};
+
+#endif
\ No newline at end of file
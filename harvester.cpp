@@ -0,0 +1,115 @@
+/**
+ * @file harvester.cpp
+ * @brief Implementacja klasy Harvester do cyklicznego pobierania danych w trybie bez interfejsu graficznego.
+ */
+
+#include "harvester.h"
+#include "apiclient.h"
+#include "stationdatasync.h"
+
+#include <QRandomGenerator>
+#include <QtDebug>
+
+/**
+ * @brief Konstruktor klasy Harvester.
+ *
+ * Tworzy własny obiekt `ApiClient` (z wątkiem roboczym, pamięcią podręczną i kolejką żądań) oraz obiekt
+ * `StationDataSync`, który zapisuje pobrane dane lokalnie. Timer jest jednorazowy i zgrubny
+ * (`Qt::VeryCoarseTimer`), więc między pobieraniami proces nie wybudza się niepotrzebnie.
+ *
+ * @param sensorIds Identyfikatory czujników do pobierania; pusta lista oznacza wszystkie stacje i czujniki.
+ * @param minuteOffset Minuta każdej godziny (0-59), w której rozpoczyna się pobieranie.
+ * @param jitterSeconds Maksymalne losowe opóźnienie pobierania w sekundach.
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+Harvester::Harvester(const QVector<int> &sensorIds, int minuteOffset, int jitterSeconds, QObject *parent)
+    : QObject(parent)
+    , apiClient(new ApiClient(this))
+    , sync(new StationDataSync(apiClient, this))
+    , sensorIds(sensorIds)
+    , minuteOffset(qBound(0, minuteOffset, 59))
+    , jitterSeconds(qMax(0, jitterSeconds))
+{
+    timer.setSingleShot(true);
+    timer.setTimerType(Qt::VeryCoarseTimer);
+    connect(&timer, &QTimer::timeout, this, &Harvester::poll);
+    connect(sync, &StationDataSync::finished, this, &Harvester::onSyncFinished);
+}
+
+/**
+ * @brief Rozpoczyna cykliczne pobieranie.
+ *
+ * @param runNow Wartość true, jeśli pierwsze pobieranie ma się rozpocząć od razu, a nie o najbliższym terminie.
+ */
+void Harvester::start(bool runNow) {
+    if (runNow) {
+        poll();
+    } else {
+        scheduleNext();
+    }
+}
+
+/**
+ * @brief Wyznacza najbliższy termin pobierania po podanej chwili.
+ *
+ * @param now Chwila odniesienia.
+ * @param minuteOffset Minuta każdej godziny (0-59).
+ * @return QDateTime Najbliższy termin (UTC) późniejszy niż `now`.
+ */
+QDateTime Harvester::nextRunAfter(const QDateTime &now, int minuteOffset) {
+    const QDateTime utc = now.toUTC();
+    QDateTime next(utc.date(), QTime(utc.time().hour(), minuteOffset), Qt::UTC);
+    if (next <= utc) {
+        next = next.addSecs(3600);
+    }
+    return next;
+}
+
+/**
+ * @brief Rozpoczyna pobieranie danych.
+ *
+ * Jeśli poprzednie pobieranie jeszcze trwa (np. przy wolnym łączu), bieżący termin jest pomijany.
+ * Przy pustej liście czujników pobierana jest lista stacji, czujniki i najnowsze dane wszystkich stacji,
+ * w przeciwnym razie - tylko najnowsze dane podanych czujników.
+ */
+void Harvester::poll() {
+    if (sync->isRunning()) {
+        qWarning() << "Poprzednie pobieranie jeszcze trwa, pomijam termin";
+        scheduleNext();
+        return;
+    }
+
+    qInfo() << "Pobieranie danych" << QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    if (sensorIds.isEmpty()) {
+        sync->syncAll();
+    } else {
+        sync->syncSensors(sensorIds, RequestScheduler::Backfill);
+    }
+}
+
+/**
+ * @brief Zapisuje w dzienniku wynik pobierania i planuje kolejne.
+ *
+ * @param stationCount Liczba stacji, dla których pobrano czujniki.
+ * @param sensorCount Liczba czujników, dla których pobrano dane pomiarowe.
+ * @param failedCount Liczba żądań zakończonych błędem.
+ */
+void Harvester::onSyncFinished(int stationCount, int sensorCount, int failedCount) {
+    qInfo().noquote() << QString("Zapisano dane %1 stacji (%2 czujników, błędy: %3)")
+                             .arg(stationCount).arg(sensorCount).arg(failedCount);
+    scheduleNext();
+}
+
+/**
+ * @brief Planuje kolejne pobieranie na najbliższy termin z losowym opóźnieniem.
+ *
+ * Losowe opóźnienie (0..`jitterSeconds` s) rozkłada w czasie żądania wielu instancji uruchomionych
+ * z tym samym harmonogramem.
+ */
+void Harvester::scheduleNext() {
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QDateTime next = nextRunAfter(now, minuteOffset)
+                               .addSecs(QRandomGenerator::global()->bounded(jitterSeconds + 1));
+    timer.start(static_cast<int>(now.msecsTo(next)));
+    qInfo() << "Następne pobieranie" << next.toString(Qt::ISODate);
+}
\ No newline at end of file
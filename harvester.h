@@ -0,0 +1,66 @@
+/**
+ * @file harvester.h
+ * @brief Definicja klasy Harvester do cyklicznego pobierania danych w trybie bez interfejsu graficznego.
+ */
+
+#ifndef HARVESTER_H
+#define HARVESTER_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QTimer>
+#include <QVector>
+
+class ApiClient;
+class StationDataSync;
+
+class Harvester : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy Harvester.
+     *
+     * @param sensorIds Identyfikatory czujników do pobierania; pusta lista oznacza wszystkie stacje i czujniki.
+     * @param minuteOffset Minuta każdej godziny (0-59), w której rozpoczyna się pobieranie.
+     * @param jitterSeconds Maksymalne losowe opóźnienie pobierania w sekundach.
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    Harvester(const QVector<int> &sensorIds, int minuteOffset, int jitterSeconds, QObject *parent = nullptr);
+
+    /**
+     * @brief Rozpoczyna cykliczne pobieranie.
+     *
+     * @param runNow Wartość true, jeśli pierwsze pobieranie ma się rozpocząć od razu, a nie o najbliższym terminie.
+     */
+    void start(bool runNow);
+
+    /**
+     * @brief Wyznacza najbliższy termin pobierania po podanej chwili.
+     *
+     * GIOS publikuje pomiary co godzinę, więc pobieranie odbywa się raz na godzinę, `minuteOffset` minut
+     * po pełnej godzinie (UTC).
+     *
+     * @param now Chwila odniesienia.
+     * @param minuteOffset Minuta każdej godziny (0-59).
+     * @return QDateTime Najbliższy termin (UTC) późniejszy niż `now`.
+     */
+    static QDateTime nextRunAfter(const QDateTime &now, int minuteOffset);
+
+private slots:
+    void poll();
+    void onSyncFinished(int stationCount, int sensorCount, int failedCount);
+
+private:
+    void scheduleNext();
+
+    ApiClient *apiClient;
+    StationDataSync *sync;
+    QTimer timer;
+    QVector<int> sensorIds;
+    int minuteOffset;
+    int jitterSeconds;
+};
+
+#endif
\ No newline at end of file
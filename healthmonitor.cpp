@@ -0,0 +1,174 @@
+/**
+ * @file healthmonitor.cpp
+ * @brief Implementacja klasy HealthMonitor do monitorowania dostępności API GIOS.
+ */
+
+#include "healthmonitor.h"
+#include "apiendpoints.h"
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+namespace {
+/** Odstęp między sondami w trybie online (ms). */
+constexpr int OnlineInterval = 30000;
+/** Pierwszy odstęp między sondami w trybie offline (ms), podwajany po każdej nieudanej sondzie. */
+constexpr int MinOfflineInterval = 2000;
+/** Maksymalny odstęp między sondami w trybie offline (ms). */
+constexpr int MaxOfflineInterval = 60000;
+/** Maksymalny czas oczekiwania na odpowiedź sondy (ms). */
+constexpr int ProbeTimeout = 5000;
+}
+
+/**
+ * @brief Konstruktor klasy HealthMonitor.
+ *
+ * Sondy są wysyłane przez przekazany QNetworkAccessManager, więc korzystają z jego puli połączeń
+ * (zestawione połączenie TLS z serwerem API jest używane ponownie) i nie wymagają tworzenia nowego
+ * menedżera przy każdym sprawdzeniu.
+ *
+ * @param manager Wskaźnik na QNetworkAccessManager używany do wysyłania sond (współdzielony z ApiWorker).
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+HealthMonitor::HealthMonitor(QNetworkAccessManager *manager, QObject *parent)
+    : QObject(parent)
+    , manager(manager)
+    , probeUrl(ApiEndpoints::stations())
+    , pendingProbe(nullptr)
+    , known(false)
+    , online(false)
+    , offlineInterval(MinOfflineInterval)
+{
+    probeTimer.setSingleShot(true);
+    connect(&probeTimer, &QTimer::timeout, this, &HealthMonitor::probe);
+}
+
+/**
+ * @brief Rozpoczyna monitorowanie, wysyłając od razu pierwszą sondę.
+ */
+void HealthMonitor::start() {
+    probe();
+}
+
+/**
+ * @brief Zgłasza wynik zwykłego żądania API (pasywne wnioskowanie o dostępności).
+ *
+ * Każda odpowiedź serwera odświeża czas ostatniej potwierdzonej dostępności - dopóki żądania aplikacji
+ * kończą się powodzeniem, aktywne sondy nie są wysyłane. W trybie offline odpowiedź serwera od razu
+ * przywraca tryb online. Błąd sieciowy w trybie online nie zmienia stanu od razu, lecz wywołuje sondę,
+ * która go potwierdza lub wyklucza.
+ *
+ * @param reply Wskaźnik na zakończoną odpowiedź.
+ */
+void HealthMonitor::reportReply(QNetworkReply *reply) {
+    if (isReachable(reply)) {
+        lastReachable.start();
+        setOnline(true);
+        scheduleProbe();
+    } else if (online && reply->error() != QNetworkReply::OperationCanceledError && !pendingProbe) {
+        probeTimer.stop();
+        probe();
+    }
+}
+
+/**
+ * @brief Sprawdza, czy odpowiedź dotarła od serwera (niezależnie od kodu HTTP).
+ *
+ * @param reply Wskaźnik na zakończoną odpowiedź.
+ * @return bool Wartość true, jeśli odpowiedź zawiera kod statusu HTTP.
+ */
+bool HealthMonitor::isReachable(QNetworkReply *reply) {
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid();
+}
+
+/**
+ * @brief Zwraca ostatnio ustalony stan połączenia.
+ *
+ * @return bool Wartość true, jeśli API jest osiągalne.
+ */
+bool HealthMonitor::isOnline() const {
+    return online;
+}
+
+/**
+ * @brief Wysyła sondę dostępności API.
+ *
+ * Sonda to żądanie HEAD do serwera API - odpowiedź nie zawiera treści, więc koszt sprawdzenia ogranicza się
+ * do nagłówków. Jeśli od ostatniej potwierdzonej dostępności (np. udanego żądania aplikacji) nie minął
+ * jeszcze odstęp trybu online, sonda jest pomijana i planowana ponownie.
+ */
+void HealthMonitor::probe() {
+    if (pendingProbe) {
+        return;
+    }
+    if (online && lastReachable.isValid() && lastReachable.elapsed() < OnlineInterval) {
+        scheduleProbe();
+        return;
+    }
+
+    QNetworkRequest request(probeUrl);
+    request.setHeader(QNetworkRequest::UserAgentHeader, "MJP");
+    request.setTransferTimeout(ProbeTimeout);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    pendingProbe = manager->head(request);
+    connect(pendingProbe, &QNetworkReply::finished, this, &HealthMonitor::onProbeFinished);
+}
+
+/**
+ * @brief Obsługuje zakończenie sondy.
+ *
+ * Po udanej sondzie przywraca odstęp trybu online, a po nieudanej planuje kolejną sondę po bieżącym
+ * odstępie trybu offline i dopiero potem go podwaja (do `MaxOfflineInterval`), więc pierwsza sonda w trybie
+ * offline jest wysyłana po `MinOfflineInterval`, a kolejne coraz rzadziej.
+ */
+void HealthMonitor::onProbeFinished() {
+    QNetworkReply *reply = pendingProbe;
+    pendingProbe = nullptr;
+    if (!reply) {
+        return;
+    }
+
+    const bool reachable = isReachable(reply);
+    reply->deleteLater();
+
+    if (reachable) {
+        lastReachable.start();
+        setOnline(true);
+        scheduleProbe();
+    } else {
+        setOnline(false);
+        scheduleProbe();
+        offlineInterval = qMin(offlineInterval * 2, MaxOfflineInterval);
+    }
+}
+
+/**
+ * @brief Ustawia stan połączenia i emituje `connectivityChanged` przy jego zmianie.
+ */
+void HealthMonitor::setOnline(bool online) {
+    if (online) {
+        offlineInterval = MinOfflineInterval;
+    }
+    if (known && this->online == online) {
+        return;
+    }
+    known = true;
+    this->online = online;
+    emit connectivityChanged(online);
+}
+
+/**
+ * @brief Planuje kolejną sondę zgodnie z bieżącym stanem połączenia.
+ *
+ * W trybie online sonda jest planowana na `OnlineInterval` od ostatniej potwierdzonej dostępności,
+ * a w trybie offline - po bieżącym odstępie trybu offline.
+ */
+void HealthMonitor::scheduleProbe() {
+    int interval = offlineInterval;
+    if (online) {
+        const qint64 elapsed = lastReachable.isValid() ? lastReachable.elapsed() : 0;
+        interval = static_cast<int>(qMax<qint64>(0, OnlineInterval - elapsed));
+    }
+    probeTimer.start(interval);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+/**
+ * @file healthmonitor.h
+ * @brief Definicja klasy HealthMonitor do monitorowania dostępności API GIOS.
+ */
+
+#ifndef HEALTHMONITOR_H
+#define HEALTHMONITOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QUrl>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+class HealthMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy HealthMonitor.
+     *
+     * @param manager Wskaźnik na QNetworkAccessManager używany do wysyłania sond (współdzielony z ApiWorker).
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit HealthMonitor(QNetworkAccessManager *manager, QObject *parent = nullptr);
+
+    /**
+     * @brief Rozpoczyna monitorowanie, wysyłając od razu pierwszą sondę.
+     */
+    void start();
+
+    /**
+     * @brief Zgłasza wynik zwykłego żądania API (pasywne wnioskowanie o dostępności).
+     *
+     * Odpowiedź HTTP (nawet z kodem błędu) oznacza, że serwer jest osiągalny, więc kolejna sonda zostaje
+     * odłożona. Błąd sieciowy w trybie online powoduje natychmiastowe wysłanie sondy potwierdzającej.
+     *
+     * @param reply Wskaźnik na zakończoną odpowiedź.
+     */
+    void reportReply(QNetworkReply *reply);
+
+    /**
+     * @brief Sprawdza, czy odpowiedź dotarła od serwera (niezależnie od kodu HTTP).
+     *
+     * @param reply Wskaźnik na zakończoną odpowiedź.
+     * @return bool Wartość true, jeśli odpowiedź zawiera kod statusu HTTP.
+     */
+    static bool isReachable(QNetworkReply *reply);
+
+    /**
+     * @brief Zwraca ostatnio ustalony stan połączenia.
+     *
+     * @return bool Wartość true, jeśli API jest osiągalne.
+     */
+    bool isOnline() const;
+
+signals:
+    /**
+     * @brief Sygnał emitowany po ustaleniu pierwszego stanu połączenia i przy każdej jego zmianie.
+     *
+     * @param online Wartość true, jeśli API jest osiągalne.
+     */
+    void connectivityChanged(bool online);
+
+private slots:
+    void probe();
+    void onProbeFinished();
+
+private:
+    void setOnline(bool online);
+    void scheduleProbe();
+
+    QNetworkAccessManager *manager;
+    QTimer probeTimer;
+    QElapsedTimer lastReachable;
+    QUrl probeUrl;
+    QNetworkReply *pendingProbe;
+    bool known;
+    bool online;
+    int offlineInterval;
+};
+
+#endif
\ No newline at end of file
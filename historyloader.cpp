@@ -0,0 +1,211 @@
+/**
+ * @file historyloader.cpp
+ * @brief Implementacja klasy HistoryLoader do wczytywania danych historycznych w tle.
+ */
+
+#include "historyloader.h"
+#include "datamanager.h"
+#include "measurementdecoder.h"
+#include "tracing.h"
+
+#include <QFile>
+#include <atomic>
+#include <utility>
+
+namespace {
+/** Liczba plików wczytywanych przez jedno zadanie wspólnej puli wątków (fragment pracy dla podkradania). */
+constexpr int FilesPerTask = 4;
+}
+
+/**
+ * @brief Konstruktor klasy HistoryLoader.
+ *
+ * Łączy sygnały wewnętrzne emitowane z wątków roboczych wspólnej puli (`TaskExecutor`) ze slotami
+ * wykonywanymi w wątku obiektu.
+ *
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+HistoryLoader::HistoryLoader(QObject *parent)
+    : QObject(parent)
+    , tasks(TaskExecutor::Normal)
+    , currentJobId(0)
+    , running(false)
+{
+    qRegisterMetaType<QVector<QPair<QDateTime, double>>>("QVector<QPair<QDateTime,double>>");
+    connect(this, &HistoryLoader::jobProgress, this, &HistoryLoader::onJobProgress, Qt::QueuedConnection);
+    connect(this, &HistoryLoader::jobFinished, this, &HistoryLoader::onJobFinished, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Destruktor klasy HistoryLoader.
+ *
+ * Anuluje bieżące zadanie i czeka na zakończenie jego zadań we wspólnej puli wątków, aby nie emitowały
+ * one sygnałów usuniętego obiektu.
+ */
+HistoryLoader::~HistoryLoader() {
+    cancel();
+    tasks.wait();
+}
+
+/**
+ * @brief Rozpoczyna w tle wczytywanie i agregację danych historycznych czujnika.
+ *
+ * Ustawia flagę anulowania poprzedniego zadania, nadaje nowemu zadaniu kolejny identyfikator i zleca
+ * je wspólnej puli wątków. Wyniki zadań o innym identyfikatorze niż bieżący są odrzucane w `onJobFinished`.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @param days Liczba ostatnich dni do wczytania; wartość 0 oznacza wszystkie dane.
+ * @return int Identyfikator zadania.
+ */
+int HistoryLoader::load(int sensorId, int days) {
+    cancel();
+
+    const int jobId = ++currentJobId;
+    const TaskExecutor::CancellationToken cancellation;
+    currentCancellation = cancellation;
+    running = true;
+
+    tasks.run([this, jobId, sensorId, days, cancellation]() {
+        run(jobId, sensorId, days, cancellation);
+    });
+    return jobId;
+}
+
+/**
+ * @brief Anuluje bieżące zadanie (jeśli jest w toku).
+ *
+ * Wątki robocze sprawdzają znacznik anulowania przed każdym plikiem, a wyniki anulowanego zadania
+ * nie są przekazywane.
+ */
+void HistoryLoader::cancel() {
+    currentCancellation.cancel();
+    running = false;
+}
+
+/**
+ * @brief Sprawdza, czy zadanie jest w toku.
+ *
+ * @return bool Wartość true, jeśli wyniki bieżącego zadania nie zostały jeszcze przekazane.
+ */
+bool HistoryLoader::isRunning() const {
+    return running;
+}
+
+/**
+ * @brief Dołącza pomiary z dokumentu JSON (`{"values": [...]}`) do posortowanej mapy.
+ *
+ * Wspólna dla wszystkich ścieżek wczytywania danych historycznych. Mapa usuwa duplikaty pomiarów
+ * zapisanych w kilku plikach (nowsza wartość zastępuje starszą) i utrzymuje je posortowane według czasu.
+ * Dokument jest odczytywany przez `MeasurementDecoder` do serii pomocniczej wątku, której pojemność jest
+ * zachowywana między plikami, więc przy wczytywaniu wielu plików odczyt nie alokuje pamięci dla pomiarów.
+ *
+ * @param json Dane pomiarowe w formacie JSON.
+ * @param cutoff Najstarsza uwzględniana data (niepoprawna data oznacza brak ograniczenia).
+ * @param aggregatedData Mapa (czas → wartość), do której dołączane są pomiary.
+ * @return bool Wartość true, jeśli dokument był poprawnym obiektem JSON.
+ */
+bool HistoryLoader::appendMeasurements(const QByteArray &json, const QDateTime &cutoff, QMap<QDateTime, double> &aggregatedData) {
+    thread_local MeasurementDecoder::Series series;
+    series.resize(0);
+    if (!MeasurementDecoder::decode(json, &series, cutoff).valid) {
+        return false;
+    }
+    for (const auto &point : std::as_const(series)) {
+        aggregatedData.insert(point.first, point.second);
+    }
+    return true;
+}
+
+/**
+ * @brief Przekazuje postęp bieżącego zadania (wykonywane w wątku obiektu).
+ */
+void HistoryLoader::onJobProgress(int jobId, int done, int total) {
+    if (jobId == currentJobId && running) {
+        emit progress(done, total);
+    }
+}
+
+/**
+ * @brief Przekazuje wyniki bieżącego zadania (wykonywane w wątku obiektu).
+ *
+ * Wyniki zadań zastąpionych nowszym zadaniem lub anulowanych są odrzucane.
+ */
+void HistoryLoader::onJobFinished(int jobId, int sensorId, int days, int fileCount, const QVector<QPair<QDateTime, double>> &measurements) {
+    if (jobId != currentJobId || !running) {
+        return;
+    }
+    running = false;
+    emit finished(sensorId, days, fileCount, measurements);
+}
+
+/**
+ * @brief Treść zadania wykonywana w wątku roboczym.
+ *
+ * Pobiera listę plików z danymi historycznymi czujnika i wczytuje je równolegle (`TaskExecutor::parallelFor`)
+ * we fragmentach po `FilesPerTask` plików; każdy fragment dołącza pomiary do własnej mapy, a mapy są następnie
+ * łączone w kolejności plików, więc tak jak przy wczytywaniu kolejnym nowsza wartość zastępuje starszą.
+ * Znacznik anulowania jest sprawdzany przed każdym plikiem. Postęp jest zgłaszany co najwyżej raz
+ * na każdy procent.
+ *
+ * @param jobId Identyfikator zadania.
+ * @param sensorId Identyfikator czujnika.
+ * @param days Liczba ostatnich dni do wczytania; wartość 0 oznacza wszystkie dane.
+ * @param cancellation Znacznik anulowania zadania.
+ */
+void HistoryLoader::run(int jobId, int sensorId, int days, const TaskExecutor::CancellationToken &cancellation) {
+    MJP_TRACE_SCOPE_ID("HistoryLoader::run", jobId);
+    const QStringList files = DataManager::historicalDataFiles("measurements", sensorId);
+    const QDateTime cutoff = days > 0 ? QDateTime::currentDateTime().addDays(-days) : QDateTime();
+    QVector<QMap<QDateTime, double>> partialData((files.size() + FilesPerTask - 1) / FilesPerTask);
+    QMap<QDateTime, double> *partial = partialData.data();
+    std::atomic<int> filesDone{0};
+    std::atomic<int> lastPercent{-1};
+
+    TaskExecutor::parallelFor(0, files.size(), FilesPerTask, [&](int begin, int end) {
+        MJP_TRACE_SCOPE_ID("HistoryLoader::readFiles", jobId);
+        QMap<QDateTime, double> &aggregatedData = partial[begin / FilesPerTask];
+        for (int i = begin; i < end; ++i) {
+            if (cancellation.isCancelled()) {
+                return;
+            }
+
+            QFile file(files.at(i));
+            if (file.open(QIODevice::ReadOnly)) {
+                appendMeasurements(file.readAll(), cutoff, aggregatedData);
+                file.close();
+            }
+
+            const int done = filesDone.fetch_add(1) + 1;
+            const int percent = done * 100 / files.size();
+            int previous = lastPercent.load();
+            while (percent > previous) {
+                if (lastPercent.compare_exchange_weak(previous, percent)) {
+                    emit jobProgress(jobId, done, files.size(), QPrivateSignal());
+                    break;
+                }
+            }
+        }
+    }, TaskExecutor::Normal, cancellation);
+
+    if (cancellation.isCancelled()) {
+        return;
+    }
+
+    QMap<QDateTime, double> aggregatedData;
+    for (const QMap<QDateTime, double> &chunk : std::as_const(partialData)) {
+        if (aggregatedData.isEmpty()) {
+            aggregatedData = chunk;
+            continue;
+        }
+        for (auto it = chunk.constBegin(); it != chunk.constEnd(); ++it) {
+            aggregatedData.insert(it.key(), it.value());
+        }
+    }
+
+    QVector<QPair<QDateTime, double>> measurements;
+    measurements.reserve(aggregatedData.size());
+    for (auto it = aggregatedData.constBegin(); it != aggregatedData.constEnd(); ++it) {
+        measurements.append(qMakePair(it.key(), it.value()));
+    }
+    emit jobFinished(jobId, sensorId, days, files.size(), measurements, QPrivateSignal());
+}
\ No newline at end of file
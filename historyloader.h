@@ -0,0 +1,108 @@
+/**
+ * @file historyloader.h
+ * @brief Definicja klasy HistoryLoader do wczytywania danych historycznych w tle.
+ */
+
+#ifndef HISTORYLOADER_H
+#define HISTORYLOADER_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QMap>
+#include <QVector>
+#include <QPair>
+#include "taskexecutor.h"
+
+class HistoryLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy HistoryLoader.
+     *
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit HistoryLoader(QObject *parent = nullptr);
+
+    /**
+     * @brief Destruktor klasy HistoryLoader.
+     *
+     * Anuluje bieżące zadanie i czeka na zakończenie jego zadań we wspólnej puli wątków.
+     */
+    ~HistoryLoader();
+
+    /**
+     * @brief Rozpoczyna w tle wczytywanie i agregację danych historycznych czujnika.
+     *
+     * Anuluje poprzednie zadanie - jego wyniki nie zostaną przekazane.
+     *
+     * @param sensorId Identyfikator czujnika.
+     * @param days Liczba ostatnich dni do wczytania; wartość 0 oznacza wszystkie dane.
+     * @return int Identyfikator zadania.
+     */
+    int load(int sensorId, int days = 0);
+
+    /**
+     * @brief Anuluje bieżące zadanie (jeśli jest w toku).
+     */
+    void cancel();
+
+    /**
+     * @brief Sprawdza, czy zadanie jest w toku.
+     *
+     * @return bool Wartość true, jeśli wyniki bieżącego zadania nie zostały jeszcze przekazane.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Dołącza pomiary z dokumentu JSON (`{"values": [...]}`) do posortowanej mapy.
+     *
+     * Pomija wartości puste lub ujemne, niepoprawne daty oraz pomiary starsze niż `cutoff`.
+     *
+     * @param json Dane pomiarowe w formacie JSON.
+     * @param cutoff Najstarsza uwzględniana data (niepoprawna data oznacza brak ograniczenia).
+     * @param aggregatedData Mapa (czas → wartość), do której dołączane są pomiary.
+     * @return bool Wartość true, jeśli dokument był poprawnym obiektem JSON.
+     */
+    static bool appendMeasurements(const QByteArray &json, const QDateTime &cutoff, QMap<QDateTime, double> &aggregatedData);
+
+signals:
+    /**
+     * @brief Sygnał emitowany po wczytaniu kolejnego pliku bieżącego zadania.
+     *
+     * @param done Liczba wczytanych plików.
+     * @param total Liczba wszystkich plików.
+     */
+    void progress(int done, int total);
+
+    /**
+     * @brief Sygnał emitowany po zakończeniu bieżącego zadania.
+     *
+     * @param sensorId Identyfikator czujnika.
+     * @param days Zakres dni zadania (0 oznacza wszystkie dane).
+     * @param fileCount Liczba plików z danymi historycznymi czujnika.
+     * @param measurements Posortowane rosnąco według czasu pomiary.
+     */
+    void finished(int sensorId, int days, int fileCount, const QVector<QPair<QDateTime, double>> &measurements);
+
+    /**
+     * @brief Sygnały wewnętrzne emitowane z wątku roboczego i przekazywane do wątku obiektu.
+     */
+    void jobProgress(int jobId, int done, int total, QPrivateSignal);
+    void jobFinished(int jobId, int sensorId, int days, int fileCount, const QVector<QPair<QDateTime, double>> &measurements, QPrivateSignal);
+
+private slots:
+    void onJobProgress(int jobId, int done, int total);
+    void onJobFinished(int jobId, int sensorId, int days, int fileCount, const QVector<QPair<QDateTime, double>> &measurements);
+
+private:
+    void run(int jobId, int sensorId, int days, const TaskExecutor::CancellationToken &cancellation);
+
+    TaskExecutor::TaskGroup tasks;
+    int currentJobId;
+    bool running;
+    TaskExecutor::CancellationToken currentCancellation;
+};
+
+#endif
\ No newline at end of file
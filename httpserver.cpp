@@ -0,0 +1,272 @@
+/**
+ * @file httpserver.cpp
+ * @brief Implementacja klasy HttpServer - minimalnego serwera HTTP/1.1 opartego na QTcpServer.
+ */
+
+#include "httpserver.h"
+
+#include <QPointer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrl>
+#include <memory>
+#include <utility>
+
+namespace {
+/** Maksymalny rozmiar nagłówków żądania (bajty); większe żądanie zamyka połączenie. */
+constexpr int MaxHeaderSize = 16 * 1024;
+/** Nazwa właściwości gniazda oznaczającej, że jego żądanie jest właśnie obsługiwane. */
+const char *const BusyProperty = "httpServerBusy";
+/** Liczba bajtów oczekujących w buforze gniazda, powyżej której odpowiedź strumieniowa wstrzymuje tworzenie treści. */
+constexpr qint64 StreamBufferSize = 64 * 1024;
+}
+
+/**
+ * @brief Konstruktor klasy HttpServer.
+ *
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+HttpServer::HttpServer(QObject *parent)
+    : QObject(parent)
+{
+    connect(&server, &QTcpServer::newConnection, this, &HttpServer::onNewConnection);
+}
+
+/**
+ * @brief Rejestruje obsługę żądań, których ścieżka zaczyna się od podanego prefiksu.
+ *
+ * @param prefix Prefiks ścieżki (np. "/metrics").
+ * @param handler Funkcja tworząca odpowiedź.
+ */
+void HttpServer::route(const QString &prefix, Handler handler) {
+    routes.append(qMakePair(prefix, std::move(handler)));
+}
+
+/**
+ * @brief Rozpoczyna nasłuchiwanie.
+ *
+ * @param address Adres, na którym serwer nasłuchuje.
+ * @param port Port; 0 oznacza dowolny wolny port.
+ * @return bool Wartość true, jeśli serwer nasłuchuje.
+ */
+bool HttpServer::listen(const QHostAddress &address, quint16 port) {
+    return server.listen(address, port);
+}
+
+/**
+ * @brief Zwraca port, na którym serwer nasłuchuje.
+ */
+quint16 HttpServer::port() const {
+    return server.serverPort();
+}
+
+/**
+ * @brief Zwraca opis ostatniego błędu serwera.
+ */
+QString HttpServer::errorString() const {
+    return server.errorString();
+}
+
+/**
+ * @brief Zwraca standardowy opis kodu odpowiedzi HTTP.
+ *
+ * @param status Kod odpowiedzi.
+ * @return QByteArray Opis (np. "Not Found").
+ */
+QByteArray HttpServer::reasonPhrase(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "Unknown";
+    }
+}
+
+/**
+ * @brief Przyjmuje nowe połączenia i łączy ich sygnały odczytu i zamknięcia.
+ */
+void HttpServer::onNewConnection() {
+    while (QTcpSocket *socket = server.nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { processBuffer(socket); });
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+/**
+ * @brief Odczytuje z gniazda kolejne kompletne żądanie i przekazuje je do obsługi.
+ *
+ * Połączenia są trwałe (HTTP/1.1 keep-alive), a żądania jednego połączenia są obsługiwane po kolei:
+ * następne jest odczytywane dopiero po wysłaniu odpowiedzi na poprzednie. Treść żądania (jeśli jest)
+ * jest pomijana.
+ *
+ * @param socket Wskaźnik na gniazdo połączenia.
+ */
+void HttpServer::processBuffer(QTcpSocket *socket) {
+    if (socket->property(BusyProperty).toBool()) {
+        return;
+    }
+    const QByteArray pending = socket->peek(socket->bytesAvailable());
+    const int headerEnd = pending.indexOf("\r\n\r\n");
+    if (headerEnd == -1) {
+        if (pending.size() > MaxHeaderSize) {
+            socket->disconnectFromHost();
+        }
+        return;
+    }
+
+    const QList<QByteArray> lines = pending.left(headerEnd).split('\n');
+    const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+    Request request;
+    for (int i = 1; i < lines.size(); ++i) {
+        const int colon = lines.at(i).indexOf(':');
+        if (colon > 0) {
+            request.headers.insert(lines.at(i).left(colon).trimmed().toLower(), lines.at(i).mid(colon + 1).trimmed());
+        }
+    }
+    const qint64 contentLength = request.headers.value("content-length").toLongLong();
+    if (pending.size() < headerEnd + 4 + contentLength) {
+        return;
+    }
+    socket->read(headerEnd + 4 + contentLength);
+
+    Response response;
+    const bool keepAlive = request.headers.value("connection").toLower() != "close";
+    if (requestLine.size() < 3) {
+        response.status = 400;
+        respond(socket, request, response, false);
+        return;
+    }
+    request.method = requestLine.at(0);
+    const QUrl target(QString::fromLatin1(requestLine.at(1)));
+    request.path = target.path();
+    request.query = QUrlQuery(target);
+
+    const Handler *handler = nullptr;
+    int matched = -1;
+    for (const auto &route : std::as_const(routes)) {
+        if (request.path.startsWith(route.first) && route.first.size() > matched) {
+            handler = &route.second;
+            matched = route.first.size();
+        }
+    }
+
+    if (request.method != "GET" && request.method != "HEAD") {
+        response.status = 405;
+    } else if (!handler) {
+        response.status = 404;
+    } else {
+        response = (*handler)(request);
+    }
+    respond(socket, request, response, keepAlive);
+}
+
+/**
+ * @brief Wysyła odpowiedź (po opóźnieniu `delayMs`) i przechodzi do następnego żądania połączenia.
+ *
+ * Odpowiedź z funkcją `deferred` jest wysyłana dopiero po wywołaniu przekazanej jej funkcji `reply`;
+ * połączenie pozostaje do tego czasu zajęte, a zamknięte w tym czasie połączenie jest pomijane.
+ * Odpowiedź z funkcją `stream` ma nagłówek Transfer-Encoding: chunked zamiast Content-Length, a jej treść
+ * wysyła `streamBody`. Odpowiedzi na żądania HEAD i odpowiedzi 304 nie mają treści.
+ *
+ * @param socket Wskaźnik na gniazdo połączenia.
+ * @param request Obsłużone żądanie.
+ * @param response Odpowiedź.
+ * @param keepAlive Wartość false, jeśli po odpowiedzi połączenie ma zostać zamknięte.
+ */
+void HttpServer::respond(QTcpSocket *socket, const Request &request, const Response &response, bool keepAlive) {
+    socket->setProperty(BusyProperty, true);
+    QPointer<QTcpSocket> guard(socket);
+
+    if (response.deferred) {
+        response.deferred([this, guard, request, keepAlive](const Response &result) {
+            if (guard) {
+                respond(guard, request, result, keepAlive);
+            }
+        });
+        return;
+    }
+
+    auto send = [this, guard, request, response, keepAlive]() {
+        if (!guard) {
+            return;
+        }
+        const bool streamed = static_cast<bool>(response.stream);
+        QByteArray head = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+        head += "Content-Type: " + response.contentType + "\r\n";
+        if (streamed) {
+            head += "Transfer-Encoding: chunked\r\n";
+        } else {
+            head += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+        }
+        head += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+        for (const auto &header : response.headers) {
+            head += header.first + ": " + header.second + "\r\n";
+        }
+        head += "\r\n";
+        guard->write(head);
+        if (request.method != "HEAD" && response.status != 304) {
+            if (streamed) {
+                streamBody(guard, response.stream, keepAlive);
+                return;
+            }
+            guard->write(response.body);
+        }
+        finish(guard, keepAlive);
+    };
+
+    if (response.delayMs > 0) {
+        QTimer::singleShot(response.delayMs, socket, send);
+    } else {
+        send();
+    }
+}
+
+/**
+ * @brief Wysyła treść odpowiedzi strumieniowej w częściach (chunked transfer encoding).
+ *
+ * Kolejne części są tworzone tylko wtedy, gdy w buforze gniazda jest mniej niż `StreamBufferSize` bajtów
+ * (po każdym sygnale bytesWritten), więc wolny klient nie powoduje gromadzenia całej odpowiedzi w pamięci.
+ * Zamknięcie połączenia przerywa wysyłanie (połączenie sygnału znika razem z gniazdem).
+ *
+ * @param socket Wskaźnik na gniazdo połączenia.
+ * @param next Funkcja zwracająca kolejną część treści (pusta tablica kończy odpowiedź).
+ * @param keepAlive Wartość false, jeśli po odpowiedzi połączenie ma zostać zamknięte.
+ */
+void HttpServer::streamBody(QTcpSocket *socket, std::function<QByteArray()> next, bool keepAlive) {
+    auto generator = std::make_shared<std::function<QByteArray()>>(std::move(next));
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    auto pump = [this, socket, generator, connection, keepAlive]() {
+        while (socket->bytesToWrite() < StreamBufferSize) {
+            const QByteArray chunk = (*generator)();
+            if (chunk.isEmpty()) {
+                disconnect(*connection);
+                socket->write("0\r\n\r\n");
+                finish(socket, keepAlive);
+                return;
+            }
+            socket->write(QByteArray::number(chunk.size(), 16) + "\r\n" + chunk + "\r\n");
+        }
+    };
+    *connection = connect(socket, &QTcpSocket::bytesWritten, socket, pump);
+    pump();
+}
+
+/**
+ * @brief Kończy obsługę żądania: zamyka połączenie lub przechodzi do następnego żądania w buforze.
+ *
+ * @param socket Wskaźnik na gniazdo połączenia.
+ * @param keepAlive Wartość false, jeśli połączenie ma zostać zamknięte.
+ */
+void HttpServer::finish(QTcpSocket *socket, bool keepAlive) {
+    socket->setProperty(BusyProperty, false);
+    if (!keepAlive) {
+        socket->disconnectFromHost();
+    } else if (socket->bytesAvailable() > 0) {
+        processBuffer(socket);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/**
+ * @file httpserver.h
+ * @brief Definicja klasy HttpServer - minimalnego serwera HTTP/1.1 opartego na QTcpServer.
+ */
+
+#ifndef HTTPSERVER_H
+#define HTTPSERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QPair>
+#include <QTcpServer>
+#include <QUrlQuery>
+#include <QVector>
+#include <functional>
+
+class QTcpSocket;
+
+class HttpServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Żądanie HTTP (nagłówki mają nazwy zapisane małymi literami).
+     */
+    struct Request {
+        QByteArray method;
+        QString path;
+        QUrlQuery query;
+        QHash<QByteArray, QByteArray> headers;
+    };
+
+    /**
+     * @brief Odpowiedź HTTP.
+     *
+     * `delayMs` opóźnia wysłanie odpowiedzi (symulacja opóźnienia serwera) bez blokowania innych połączeń.
+     * Jeśli ustawiona jest funkcja `stream`, treść jest wysyłana w częściach (Transfer-Encoding: chunked)
+     * zamiast `body`: funkcja jest wywoływana, gdy w buforze gniazda jest miejsce, i zwraca kolejną część
+     * treści, a pusta tablica kończy odpowiedź. Funkcja jest wywoływana zawsze na tej samej kopii, więc może
+     * przechowywać swój stan (np. jako lambda z modyfikatorem mutable).
+     * Jeśli ustawiona jest funkcja `deferred`, pozostałe pola są pomijane, a właściwa odpowiedź powstaje
+     * asynchronicznie (np. w puli wątków): funkcja otrzymuje funkcję `reply`, którą należy wywołać w wątku
+     * serwera z gotową odpowiedzią. Do tego czasu połączenie czeka, a inne połączenia są obsługiwane.
+     */
+    struct Response {
+        int status = 200;
+        QByteArray contentType = "application/json; charset=utf-8";
+        QByteArray body;
+        QList<QPair<QByteArray, QByteArray>> headers;
+        int delayMs = 0;
+        std::function<QByteArray()> stream;
+        std::function<void(const std::function<void(const Response &)> &reply)> deferred;
+    };
+
+    using Handler = std::function<Response(const Request &)>;
+
+    /**
+     * @brief Konstruktor klasy HttpServer.
+     *
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit HttpServer(QObject *parent = nullptr);
+
+    /**
+     * @brief Rejestruje obsługę żądań, których ścieżka zaczyna się od podanego prefiksu.
+     *
+     * Przy kilku pasujących prefiksach wybierany jest najdłuższy.
+     *
+     * @param prefix Prefiks ścieżki (np. "/metrics").
+     * @param handler Funkcja tworząca odpowiedź.
+     */
+    void route(const QString &prefix, Handler handler);
+
+    /**
+     * @brief Rozpoczyna nasłuchiwanie.
+     *
+     * @param address Adres, na którym serwer nasłuchuje (domyślnie tylko lokalnie).
+     * @param port Port; 0 oznacza dowolny wolny port.
+     * @return bool Wartość true, jeśli serwer nasłuchuje.
+     */
+    bool listen(const QHostAddress &address = QHostAddress::LocalHost, quint16 port = 0);
+
+    /**
+     * @brief Zwraca port, na którym serwer nasłuchuje.
+     */
+    quint16 port() const;
+
+    /**
+     * @brief Zwraca opis ostatniego błędu serwera.
+     */
+    QString errorString() const;
+
+    /**
+     * @brief Zwraca standardowy opis kodu odpowiedzi HTTP.
+     *
+     * @param status Kod odpowiedzi.
+     * @return QByteArray Opis (np. "Not Found").
+     */
+    static QByteArray reasonPhrase(int status);
+
+private slots:
+    void onNewConnection();
+
+private:
+    void processBuffer(QTcpSocket *socket);
+    void respond(QTcpSocket *socket, const Request &request, const Response &response, bool keepAlive);
+    void streamBody(QTcpSocket *socket, std::function<QByteArray()> next, bool keepAlive);
+    void finish(QTcpSocket *socket, bool keepAlive);
+
+    QTcpServer server;
+    QVector<QPair<QString, Handler>> routes;
+};
+
+#endif
\ No newline at end of file
@@ -1,15 +1,191 @@
 /**
  * @file main.cpp
- * @brief Plik główny aplikacji, uruchamiający interfejs użytkownika.
+ * @brief Plik główny aplikacji, uruchamiający interfejs użytkownika lub tryb bez interfejsu graficznego.
  */
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <cstring>
+#include "apiclient.h"
+#include "apiendpoints.h"
+#include "archivebackfill.h"
+#include "datamanager.h"
+#include "harvester.h"
+#include "httpserver.h"
 #include "mainwindow.h"
+#include "metrics.h"
+#include "queryserver.h"
+#include "tracing.h"
+
+/**
+ * @brief Rejestruje metrykę rozmiaru lokalnego magazynu danych (`mjp_store_size_bytes`).
+ * 
+ * Odczyt metryk podaje rozmiar znany w `DataManager` (aktualizowany przy każdym zapisie pliku) i nie częściej 
+ * niż co 30 s zleca jego ponowne wyznaczenie w puli wątków (`DataManager::refreshStoreSize`), bo przy dużym 
+ * archiwum przejście przez katalog danych trwa długo i nie może blokować wątku interfejsu.
+ */
+static void registerStoreMetrics() {
+    Metrics::addCollector([]() {
+        static Metrics::Gauge &size = Metrics::gauge("mjp_store_size_bytes", "Rozmiar lokalnego magazynu danych");
+        static QElapsedTimer sinceScan;
+        if (!sinceScan.isValid() || sinceScan.hasExpired(30000)) {
+            DataManager::refreshStoreSize();
+            sinceScan.start();
+        }
+        const qint64 known = DataManager::cachedStoreSize();
+        if (known >= 0) {
+            size.set(known);
+        }
+    });
+}
+
+/**
+ * @brief Uruchamia lokalny punkt końcowy `/metrics` w formacie tekstowym Prometheus.
+ * 
+ * Serwer (`HttpServer`) nasłuchuje tylko na adresie 127.0.0.1 i udostępnia wyłącznie metryki.
+ * 
+ * @param port Port serwera.
+ * @param parent Obiekt nadrzędny serwera.
+ * @return bool Wartość true, jeśli serwer nasłuchuje.
+ */
+static bool startMetricsServer(quint16 port, QObject *parent) {
+    HttpServer *server = new HttpServer(parent);
+    server->route("/metrics", [](const HttpServer::Request &) {
+        HttpServer::Response response;
+        response.contentType = "text/plain; version=0.0.4; charset=utf-8";
+        response.body = Metrics::prometheusText();
+        return response;
+    });
+    if (!server->listen(QHostAddress::LocalHost, port)) {
+        qCritical().noquote() << "Nie można uruchomić punktu końcowego /metrics:" << server->errorString();
+        delete server;
+        return false;
+    }
+    qInfo().noquote() << QString("Metryki: http://127.0.0.1:%1/metrics").arg(server->port());
+    return true;
+}
+
+/**
+ * @brief Uruchamia lokalny serwer zapytań (`QueryServer`) udostępniający dane z magazynu innym klientom.
+ * 
+ * @param address Adres, na którym serwer nasłuchuje.
+ * @param port Port serwera.
+ * @param parent Obiekt nadrzędny serwera.
+ * @return bool Wartość true, jeśli serwer nasłuchuje.
+ */
+static bool startQueryServer(const QHostAddress &address, quint16 port, QObject *parent) {
+    QueryServer *server = new QueryServer(parent);
+    if (!server->listen(address, port)) {
+        qCritical().noquote() << "Nie można uruchomić serwera zapytań:" << server->errorString();
+        delete server;
+        return false;
+    }
+    qInfo().noquote() << QString("Serwer zapytań: http://%1:%2/api/").arg(address.toString()).arg(server->port());
+    return true;
+}
+
+/**
+ * @brief Uruchamia aplikację w trybie bez interfejsu graficznego (`--headless`).
+ * 
+ * Tworzy `QCoreApplication` (nie wymaga ekranu), odczytuje opcje harmonogramu i uruchamia obiekt 
+ * `Harvester`, który co godzinę zapisuje najnowsze dane pomiarowe w lokalnym magazynie danych. 
+ * Z opcją `--backfill <dni>` jednorazowo pobiera dane archiwalne podanych czujników (`ArchiveBackfill`) 
+ * i kończy działanie; ponowne uruchomienie po przerwaniu wznawia pobieranie od punktu kontrolnego. 
+ * Opcja `--trace <plik>` włącza śledzenie i co minutę (oraz przy zakończeniu) zapisuje ślad w formacie Chrome. 
+ * Opcja `--metrics-port <port>` udostępnia metryki (`Metrics`) pod adresem `http://127.0.0.1:<port>/metrics`, 
+ * a `--serve-port <port>` (z opcjonalnym `--serve-address`) udostępnia dane z lokalnego magazynu innym 
+ * klientom przez serwer zapytań (`QueryServer`).
+ * 
+ * @param argc Liczba argumentów wiersza poleceń.
+ * @param argv Tablica argumentów wiersza poleceń.
+ * @return int Kod wyjścia aplikacji (0 oznacza sukces).
+ */
+static int runHeadless(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Cykliczne pobieranie danych pomiarowych GIOS do lokalnego archiwum.");
+    parser.addHelpOption();
+    parser.addOption({"headless", "Tryb bez interfejsu graficznego."});
+    parser.addOption({"sensors", "Identyfikatory czujników oddzielone przecinkami (domyślnie wszystkie).", "lista"});
+    parser.addOption({"minute", "Minuta każdej godziny (UTC), w której rozpoczyna się pobieranie (domyślnie 20).", "minuta", "20"});
+    parser.addOption({"jitter", "Maksymalne losowe opóźnienie pobierania w sekundach (domyślnie 120).", "sekundy", "120"});
+    parser.addOption({"now", "Pierwsze pobieranie od razu po uruchomieniu."});
+    parser.addOption({"api-url", "Adres bazowy API (np. lokalnego serwera testowego).", "adres"});
+    parser.addOption({"backfill", "Jednorazowe pobranie danych archiwalnych podanych czujników z ostatnich dni.", "dni"});
+    parser.addOption({"trace", "Zapis śladu wykonania (format Chrome/Perfetto) do pliku co minutę i przy zakończeniu.", "plik"});
+    parser.addOption({"metrics-port", "Port lokalnego punktu końcowego /metrics (format Prometheus).", "port"});
+    parser.addOption({"serve-port", "Port serwera zapytań udostępniającego dane z lokalnego magazynu (/api/).", "port"});
+    parser.addOption({"serve-address", "Adres serwera zapytań (domyślnie 127.0.0.1).", "adres", "127.0.0.1"});
+    parser.process(app);
+
+    if (parser.isSet("metrics-port") && !startMetricsServer(parser.value("metrics-port").toUShort(), &app)) {
+        return 1;
+    }
+    if (parser.isSet("serve-port")
+        && !startQueryServer(QHostAddress(parser.value("serve-address")), parser.value("serve-port").toUShort(), &app)) {
+        return 1;
+    }
+
+    QTimer traceTimer;
+    const QString tracePath = parser.value("trace");
+    if (!tracePath.isEmpty()) {
+        Tracing::setEnabled(true);
+        const auto writeTrace = [tracePath]() { Tracing::writeChromeTrace(tracePath); };
+        QObject::connect(&traceTimer, &QTimer::timeout, writeTrace);
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, writeTrace);
+        traceTimer.start(60000);
+    }
+
+    QVector<int> sensorIds;
+    const QStringList sensorList = parser.value("sensors").split(',', Qt::SkipEmptyParts);
+    for (const QString &value : sensorList) {
+        bool ok = false;
+        const int sensorId = value.trimmed().toInt(&ok);
+        if (!ok) {
+            qCritical().noquote() << "Niepoprawny identyfikator czujnika:" << value;
+            return 1;
+        }
+        sensorIds.append(sensorId);
+    }
+
+    if (parser.isSet("backfill")) {
+        const int days = parser.value("backfill").toInt();
+        if (days <= 0 || sensorIds.isEmpty()) {
+            qCritical() << "Opcja --backfill wymaga dodatniej liczby dni i listy czujników (--sensors)";
+            return 1;
+        }
+        ApiClient apiClient;
+        ArchiveBackfill backfill(&apiClient);
+        QObject::connect(&backfill, &ArchiveBackfill::progress, [](int done, int total) {
+            qInfo().noquote() << QString("Okna danych archiwalnych: %1/%2").arg(done).arg(total);
+        });
+        QObject::connect(&backfill, &ArchiveBackfill::finished, &app, [](int savedValues, int failedWindows) {
+            qInfo().noquote() << QString("Zapisano %1 pomiarów archiwalnych (nieudane okna: %2)").arg(savedValues).arg(failedWindows);
+            QCoreApplication::exit(failedWindows == 0 ? 0 : 2);
+        }, Qt::QueuedConnection);
+        const QDate today = QDate::currentDate();
+        backfill.start(sensorIds, today.addDays(-days + 1), today);
+        return app.exec();
+    }
+
+    Harvester harvester(sensorIds, parser.value("minute").toInt(), parser.value("jitter").toInt());
+    harvester.start(parser.isSet("now"));
+    return app.exec();
+}
 
 /**
  * @brief Główna funkcja aplikacji.
  * 
- * Inicjalizuje aplikację Qt, tworzy główne okno aplikacji (`MainWindow`) i uruchamia pętlę zdarzeń. 
+ * Opcja `--api-url <adres>` (lub zmienna środowiskowa `MJP_API_BASE_URL`) zmienia adres bazowy API, 
+ * np. na lokalny serwer testowy (`mockserver`). Zmienna środowiskowa `MJP_TRACE` włącza śledzenie czasu 
+ * wykonania (`Tracing`) od uruchomienia, a zmienna `MJP_METRICS_PORT` uruchamia w oknie aplikacji 
+ * lokalny punkt końcowy `/metrics` (w trybie bez interfejsu służy do tego opcja `--metrics-port`), 
+ * a zmienna `MJP_SERVE_PORT` - lokalny serwer zapytań (`--serve-port`). 
+ * Z opcją `--headless` uruchamia tryb bez interfejsu graficznego (`runHeadless`). W przeciwnym razie 
+ * inicjalizuje aplikację Qt, tworzy główne okno aplikacji (`MainWindow`) i uruchamia pętlę zdarzeń. 
  * Zwraca kod wyjścia aplikacji po jej zamknięciu.
  * 
  * @param argc Liczba argumentów wiersza poleceń.
@@ -17,7 +193,30 @@
  * @return int Kod wyjścia aplikacji (0 oznacza sukces).
  */
 int main(int argc, char *argv[]) {
+    Tracing::setEnabled(qEnvironmentVariableIsSet("MJP_TRACE"));
+    registerStoreMetrics();
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--api-url") == 0 && i + 1 < argc) {
+            if (!ApiEndpoints::setBaseUrl(QUrl::fromUserInput(QString::fromLocal8Bit(argv[++i])))) {
+                qCritical() << "Niepoprawny adres API:" << argv[i];
+                return 1;
+            }
+        }
+    }
+    if (headless) {
+        return runHeadless(argc, argv);
+    }
+
     QApplication a(argc, argv);
+    if (qEnvironmentVariableIsSet("MJP_METRICS_PORT")) {
+        startMetricsServer(static_cast<quint16>(qEnvironmentVariableIntValue("MJP_METRICS_PORT")), &a);
+    }
+    if (qEnvironmentVariableIsSet("MJP_SERVE_PORT")) {
+        startQueryServer(QHostAddress::LocalHost, static_cast<quint16>(qEnvironmentVariableIntValue("MJP_SERVE_PORT")), &a);
+    }
     MainWindow w;
     w.show();
     return a.exec();
@@ -8,16 +8,36 @@
 #include "apiclient.h"
 #include "connectionmanager.h"
 #include "stationhandler.h"
+#include "stationlistmodel.h"
+#include "stationdatasync.h"
+#include "archivebackfill.h"
+#include "historyloader.h"
 #include "sensorhandler.h"
 #include "measurementhandler.h"
+#include "measurementpipeline.h"
+#include "prefetcher.h"
 #include "datamanager.h"
+#include "diagnosticsdialog.h"
+#include "tracing.h"
+
+namespace {
+/** Komunikat statusu po wyświetleniu nieświeżych danych z pamięci podręcznej odpowiedzi API. */
+const char *const StaleDataStatus = "API niedostępne - wyświetlono dane z pamięci podręcznej";
+}
 
 /**
  * @brief Konstruktor klasy MainWindow.
  * 
  * Inicjalizuje główne okno aplikacji, konfiguruje interfejs użytkownika, ustawia tytuł okna, ikonę 
- * i tworzy obiekty `ApiClient` oraz `ConnectionManager`. Inicjalizuje timery dla zegara 
- * (aktualizacja co 100 ms) i sprawdzania połączenia (co 10 sekund). Konfiguruje połączenia sygnałów 
+ * i tworzy obiekty `ApiClient`, `ConnectionManager` oraz model listy stacji. `ConnectionManager` śledzi stan 
+ * połączenia zgłaszany przez monitor dostępności API. Inicjalizuje timery dla zegara 
+ * (aktualizacja co 100 ms) oraz opóźnienia filtrowania listy stacji 
+ * (filtr jest stosowany dopiero po 150 ms bez kolejnego naciśnięcia klawisza). Dodaje do listy stacji akcję 
+ * kontekstową "Pokaż najbliższe stacje" (Ctrl+N), do listy czujników akcję pobierania danych archiwalnych, 
+ * do okna akcję zapisu śladu wykonania (Ctrl+Shift+T) i łączy postęp wczytywania danych historycznych w tle 
+ * z etykietą statusu, a statystyki pamięci podręcznej odpowiedzi API z jej podpowiedzią. Podświetlenie wiersza 
+ * list stacji i czujników (strzałkami lub kursorem) zleca pobranie danych z wyprzedzeniem (`Prefetcher`), 
+ * a przejście w tryb offline anuluje te żądania. Konfiguruje połączenia sygnałów 
  * i slotów, ustala kolejność fokusu dla elementów interfejsu, instaluje filtry zdarzeń dla przycisków 
  * oraz włącza antyaliasing dla wykresu.
  * 
@@ -28,34 +48,116 @@ MainWindow::MainWindow(QWidget *parent)
     , ui(new Ui::MainWindow)
     , apiClient(new ApiClient())
     , connectionManager(new ConnectionManager(this))
+    , stationModel(new StationListModel(this))
+    , nearbySync(new StationDataSync(apiClient, this))
+    , fullSync(new StationDataSync(apiClient, this))
+    , archiveBackfill(new ArchiveBackfill(apiClient, this))
+    , historyLoader(new HistoryLoader(this))
+    , measurementPipeline(new MeasurementPipeline(apiClient, this))
+    , prefetcher(new Prefetcher(apiClient, this))
+    , diagnosticsDialog(nullptr)
     , currentStationId(-1)
     , currentSensorId(-1)
+    , spatialIndexRevision(0)
 {
     ui->setupUi(this);
     this->setWindowTitle("Made by Miłosz Kurpisz");
     this->setWindowIcon(QIcon(":/icons/icon.ico"));
+    ui->stationList->setModel(stationModel);
 
     //qDebug() << "Main UI - thread:" << QThread::currentThreadId();
 
-    isOffline = true;
-    connectionManager->checkConnectionAndReloadStations(apiClient, ui->stationList, ui->lblStatus, ui->lblStationCount, isOffline, allStations);;
+    connectionManager->watchConnection(apiClient, stationModel, ui->stationList, ui->lblStatus, ui->lblStationCount, isOffline, stationCatalog);
 
     connect(apiClient, &ApiClient::dataReady, this, &MainWindow::onDataReady);
     connect(apiClient, &ApiClient::errorOccurred, this, &MainWindow::onErrorOccurred);
+    connect(apiClient, &ApiClient::staleDataReady, this, &MainWindow::onStaleDataReady);
 
     clockTimer = new QTimer(this);
     connect(clockTimer, &QTimer::timeout, this, &MainWindow::updateClock);
     clockTimer->start(100);
 
-    connectionCheckTimer = new QTimer(this);
-    connect(connectionCheckTimer, &QTimer::timeout, [=]() {
-        connectionManager->checkConnectionAndReloadStations(apiClient, ui->stationList, ui->lblStatus, ui->lblStationCount, isOffline, allStations);
+    searchDebounceTimer = new QTimer(this);
+    searchDebounceTimer->setSingleShot(true);
+    searchDebounceTimer->setInterval(150);
+    connect(searchDebounceTimer, &QTimer::timeout, [=]() {
+        StationHandler::updateStationList(ui->stationSearch->text(), stationModel, ui->stationList, ui->lblStationCount);
+    });
+    connect(ui->stationSearch, &QLineEdit::textChanged, searchDebounceTimer, QOverload<>::of(&QTimer::start));
+    actionNearestStations = new QAction("Pokaż najbliższe stacje", this);
+    actionNearestStations->setShortcut(QKeySequence("Ctrl+N"));
+    actionNearestStations->setShortcutContext(Qt::WidgetWithChildrenShortcut);
+    ui->stationList->addAction(actionNearestStations);
+    ui->stationList->setContextMenuPolicy(Qt::ActionsContextMenu);
+    connect(actionNearestStations, &QAction::triggered, this, &MainWindow::showNearestStations);
+    actionSyncAll = new QAction("Pobierz dane wszystkich stacji", this);
+    ui->stationList->addAction(actionSyncAll);
+    connect(actionSyncAll, &QAction::triggered, this, &MainWindow::syncAllStations);
+    actionBackfill = new QAction("Pobierz dane archiwalne czujnika...", this);
+    ui->sensorList->addAction(actionBackfill);
+    ui->sensorList->setContextMenuPolicy(Qt::ActionsContextMenu);
+    connect(actionBackfill, &QAction::triggered, this, &MainWindow::backfillSensor);
+    actionTrace = new QAction("Zapisz ślad wykonania", this);
+    actionTrace->setShortcut(QKeySequence("Ctrl+Shift+T"));
+    addAction(actionTrace);
+    connect(actionTrace, &QAction::triggered, this, &MainWindow::saveTrace);
+    actionDiagnostics = new QAction("Diagnostyka", this);
+    actionDiagnostics->setShortcut(QKeySequence("Ctrl+Shift+D"));
+    addAction(actionDiagnostics);
+    connect(actionDiagnostics, &QAction::triggered, this, &MainWindow::showDiagnostics);
+
+    connect(nearbySync, &StationDataSync::progress, [this](const QString &stage, int done, int total) {
+        lblStatus->setText(QString("Pobieranie najbliższych stacji: %1 %2/%3").arg(stage).arg(done).arg(total));
+        lblStatus->setStyleSheet("color: orange;");
+    });
+    connect(nearbySync, &StationDataSync::finished, [this](int stationCount, int sensorCount, int failedCount) {
+        lblStatus->setText(QString("Zapisano dane %1 stacji (%2 czujników)").arg(stationCount).arg(sensorCount));
+        lblStatus->setStyleSheet(failedCount == 0 ? "color: green;" : "color: orange;");
+    });
+    connect(fullSync, &StationDataSync::progress, [this](const QString &stage, int done, int total) {
+        lblStatus->setText(QString("Pobieranie wszystkich stacji: %1 %2/%3").arg(stage).arg(done).arg(total));
+        lblStatus->setStyleSheet("color: orange;");
+    });
+    connect(fullSync, &StationDataSync::finished, [this](int stationCount, int sensorCount, int failedCount) {
+        actionSyncAll->setEnabled(true);
+        lblStatus->setText(QString("Zapisano dane %1 stacji (%2 czujników, błędy: %3)").arg(stationCount).arg(sensorCount).arg(failedCount));
+        lblStatus->setStyleSheet(failedCount == 0 ? "color: green;" : "color: orange;");
+    });
+    connect(archiveBackfill, &ArchiveBackfill::progress, [this](int done, int total) {
+        lblStatus->setText(QString("Pobieranie danych archiwalnych: %1/%2 okien").arg(done).arg(total));
+        lblStatus->setStyleSheet("color: orange;");
+    });
+    connect(archiveBackfill, &ArchiveBackfill::finished, [this](int savedValues, int failedWindows) {
+        actionBackfill->setEnabled(true);
+        lblStatus->setText(QString("Zapisano %1 pomiarów archiwalnych (nieudane okna: %2)").arg(savedValues).arg(failedWindows));
+        lblStatus->setStyleSheet(failedWindows == 0 ? "color: green;" : "color: orange;");
+    });
+
+    connect(apiClient, &ApiClient::connectivityChanged, prefetcher, [this](bool online) {
+        if (!online) {
+            prefetcher->clear();
+        }
+    });
+    connect(apiClient, &ApiClient::cacheStatsChanged, this, &MainWindow::updateNetworkToolTip);
+    connect(apiClient, &ApiClient::timingStatsChanged, this, &MainWindow::updateNetworkToolTip);
+    connect(historyLoader, &HistoryLoader::progress, [this](int done, int total) {
+        lblStatus->setText(QString("Wczytywanie danych historycznych: %1/%2 plików").arg(done).arg(total));
+        lblStatus->setStyleSheet("color: orange;");
     });
-    connectionCheckTimer->start(5000);
+    connect(historyLoader, &HistoryLoader::finished, this, &MainWindow::onHistoryLoaded);
+    connect(measurementPipeline, &MeasurementPipeline::finished, this, &MainWindow::onMeasurementsReady);
 
-    connect(ui->stationSearch, &QLineEdit::textChanged, [=](const QString &text) {
-        StationHandler::updateStationList(text, ui->stationList, ui->lblStationCount, allStations);
+    ui->stationList->setMouseTracking(true);
+    ui->sensorList->setMouseTracking(true);
+    connect(ui->stationList->selectionModel(), &QItemSelectionModel::currentChanged, this, [this](const QModelIndex &current) {
+        prefetchStations(current);
+    });
+    connect(ui->stationList, &QAbstractItemView::entered, this, &MainWindow::prefetchStations);
+    connect(ui->sensorList, &QListWidget::currentItemChanged, this, [this](QListWidgetItem *current) {
+        prefetchSensor(current);
     });
+    connect(ui->sensorList, &QListWidget::itemEntered, this, &MainWindow::prefetchSensor);
+
     connect(ui->btnHistory, &QPushButton::clicked, this, &MainWindow::on_btnHistory_clicked);
     connect(ui->btnLast7Days, &QPushButton::clicked, [this]() { loadHistoricalData(7); });
     connect(ui->btnLast14Days, &QPushButton::clicked, [this]() { loadHistoricalData(14); });
@@ -89,46 +191,65 @@ MainWindow::~MainWindow() {
 /**
  * @brief Obsługuje dane zwrócone przez ApiClient.
  * 
- * Parsuje dane JSON i w zależności od ich typu (stacje, czujniki, pomiary) zapisuje je jako dane historyczne 
- * za pomocą `DataManager`. Aktualizuje listy stacji lub czujników, statystyki lub wykres w interfejsie użytkownika. 
- * W przypadku błędnych danych lub braku danych online wyświetla odpowiedni komunikat.
+ * W zależności od rodzaju żądania (stacje, czujniki) zapisuje dane jako dane historyczne 
+ * za pomocą `DataManager` - dla encji, dla której zlecono żądanie, a nie dla bieżącego zaznaczenia. 
+ * Listę czujników aktualizuje tylko wtedy, gdy dane dotyczą bieżącej stacji. Odpowiedzi z pomiarami 
+ * obsługuje `MeasurementPipeline` (dekodowanie i zapis w tle, wyświetlenie w `onMeasurementsReady`).
  * 
  * @param data Dane w formacie QString (JSON).
+ * @param kind Rodzaj żądania.
+ * @param entityId Identyfikator stacji (czujniki) lub czujnika (pomiary), dla którego zlecono żądanie.
  */
-void MainWindow::onDataReady(const QString &data) {
-    QJsonDocument doc = QJsonDocument::fromJson(data.toUtf8());
-    if (doc.isArray()) {
-        QJsonArray array = doc.array();
-        if (!array.isEmpty() && array.first().toObject().contains("stationName")) {
-            DataManager::saveHistoricalData("stations", data.toUtf8());
-            StationHandler::handleStationsData(array, ui->stationList, ui->lblStationCount, allStations);
-        } else {
-            DataManager::saveHistoricalData("sensors", data.toUtf8(), currentStationId);
-            SensorHandler::handleSensorsData(array, ui->sensorList, currentSensors);
-        }
-    } else if (doc.isObject()) {
-        DataManager::saveHistoricalData("measurements", data.toUtf8(), currentSensorId);
-
-        QJsonObject obj = doc.object();
-        QVector<QPair<QDateTime, double>> measurements;
-        QJsonArray values = obj["values"].toArray();
-        for (const QJsonValue &val : values) {
-            QJsonObject entry = val.toObject();
-            QDateTime date = QDateTime::fromString(entry["date"].toString(), Qt::ISODate);
-            double value = entry["value"].toDouble(-1.0);
-            if (value >= 0 && date.isValid()) {
-                measurements.append({date, value});
-            }
+void MainWindow::onDataReady(const QString &data, ApiClient::RequestKind kind, int entityId) {
+    MJP_TRACE_SCOPE("MainWindow::onDataReady");
+    if (kind == ApiClient::Measurements) {
+        return;
+    }
+    const QByteArray bytes = data.toUtf8();
+    QJsonDocument doc = QJsonDocument::fromJson(bytes);
+    if (kind == ApiClient::Stations && doc.isArray()) {
+        DataManager::saveHistoricalData("stations", bytes);
+        StationHandler::handleStationsData(doc.array(), stationModel, ui->stationList, ui->lblStationCount, stationCatalog);
+    } else if (kind == ApiClient::Sensors && doc.isArray()) {
+        DataManager::saveHistoricalData("sensors", bytes, entityId);
+        if (entityId == currentStationId) {
+            SensorHandler::handleSensorsData(doc.array(), ui->sensorList, currentSensors);
         }
-        if (!measurements.isEmpty()) {
-            MeasurementHandler::handleMeasurementsData(obj, measurements, ui->lblStats);
-            MeasurementHandler::updateChart(measurements, ui->chartView, currentStationCity, currentStationAddress, currentParamName);
+    }
+}
+
+/**
+ * @brief Wyświetla pomiary bieżącego czujnika zdekodowane przez `MeasurementPipeline`.
+ * 
+ * Statystyki są obliczone w tle, więc w wątku interfejsu pozostaje tylko aktualizacja etykiety i wykresu. 
+ * Pusty wektor pomiarów (niepoprawna lub pusta odpowiedź) jest sygnalizowany na etykiecie statusu, 
+ * a pomiary z nieświeżej odpowiedzi z pamięci podręcznej - osobnym komunikatem.
+ * 
+ * @param sensorId Identyfikator czujnika.
+ * @param measurements Pomiary w kolejności z odpowiedzi API.
+ * @param stats Statystyki serii.
+ * @param stale Wartość true, jeśli pomiary pochodzą z nieświeżej odpowiedzi z pamięci podręcznej.
+ */
+void MainWindow::onMeasurementsReady(int sensorId, const QVector<QPair<QDateTime, double>> &measurements, const MeasurementHandler::Statistics &stats,
+                                     bool stale) {
+    MJP_TRACE_SCOPE("MainWindow::onMeasurementsReady");
+    if (sensorId != currentSensorId) {
+        return;
+    }
+
+    if (!measurements.isEmpty()) {
+        MeasurementHandler::showStatistics(stats, ui->lblStats);
+        MeasurementHandler::updateChart(measurements, ui->chartView, currentStationCity, currentStationAddress, currentParamName);
+        if (stale) {
+            ui->lblStatus->setText(StaleDataStatus);
+            ui->lblStatus->setStyleSheet("color: orange;");
+        } else {
             ui->lblStatus->setText("Wczytano dane online");
             ui->lblStatus->setStyleSheet("color: green;");
-        } else {
-            ui->lblStatus->setText("Błąd danych online");
-            ui->lblStatus->setStyleSheet("color: red;");
         }
+    } else {
+        ui->lblStatus->setText("Błąd danych online");
+        ui->lblStatus->setStyleSheet("color: red;");
     }
 }
 
@@ -136,50 +257,84 @@ void MainWindow::onDataReady(const QString &data) {
  * @brief Obsługuje błędy zgłoszone przez ApiClient.
  * 
  * Wyświetla komunikat o błędzie na etykiecie statusu i próbuje wczytać dane lokalne (stacje, czujniki lub pomiary) 
- * w zależności od kontekstu (bieżącej stacji lub czujnika). Jeśli dane lokalne są dostępne, wywołuje `onDataReady`.
+ * odpowiadające rodzajowi żądania. Błędy żądań dotyczących innej stacji lub czujnika niż bieżące są pomijane. 
+ * Jeśli dane lokalne są dostępne, wywołuje `onDataReady`.
  * 
  * @param error Opis błędu w formacie QString.
+ * @param kind Rodzaj żądania.
+ * @param entityId Identyfikator stacji (czujniki) lub czujnika (pomiary), dla którego zlecono żądanie.
  */
-void MainWindow::onErrorOccurred(const QString &error) {
+void MainWindow::onErrorOccurred(const QString &error, ApiClient::RequestKind kind, int entityId) {
+    if ((kind == ApiClient::Sensors && entityId != currentStationId)
+        || (kind == ApiClient::Measurements && entityId != currentSensorId)) {
+        return;
+    }
+
     lblStatus->setText("Błąd: " + error);
     lblStatus->setStyleSheet("color: red;");
 
-    if (currentSensorId != -1) {
+    if (kind == ApiClient::Measurements) {
         on_btnHistory_clicked();
-    } else if (currentStationId != -1) {
-        QByteArray sensorsData = DataManager::loadDataFromFile("sensors", currentStationId);
+    } else if (kind == ApiClient::Sensors) {
+        QByteArray sensorsData = DataManager::loadDataFromFile("sensors", entityId);
         if (!sensorsData.isEmpty()) {
-            onDataReady(QString::fromUtf8(sensorsData));
+            onDataReady(QString::fromUtf8(sensorsData), ApiClient::Sensors, entityId);
         }
-    } else {
+    } else if (kind == ApiClient::Stations) {
         QByteArray stationsData = DataManager::loadDataFromFile("stations");
         if (!stationsData.isEmpty()) {
-            onDataReady(QString::fromUtf8(stationsData));
+            onDataReady(QString::fromUtf8(stationsData), ApiClient::Stations, -1);
         }
     }
 }
 
+/**
+ * @brief Obsługuje nieświeże dane z pamięci podręcznej zwrócone przez ApiClient, gdy API jest niedostępne.
+ * 
+ * Wyświetla stacje lub czujniki bieżącej stacji tak jak `onDataReady`, ale nie zapisuje ich jako dane historyczne 
+ * (nie są nowym stanem danych) i informuje na etykiecie statusu, że API jest niedostępne. Pomiary obsługuje 
+ * `MeasurementPipeline`, a status ustawia `onMeasurementsReady`.
+ * 
+ * @param data Dane w formacie QString (JSON).
+ * @param kind Rodzaj żądania.
+ * @param entityId Identyfikator stacji (czujniki) lub czujnika (pomiary), dla którego zlecono żądanie.
+ */
+void MainWindow::onStaleDataReady(const QString &data, ApiClient::RequestKind kind, int entityId) {
+    if (kind == ApiClient::Measurements || (kind == ApiClient::Sensors && entityId != currentStationId)) {
+        return;
+    }
+    QJsonDocument doc = QJsonDocument::fromJson(data.toUtf8());
+    if (!doc.isArray()) {
+        return;
+    }
+    if (kind == ApiClient::Stations) {
+        StationHandler::handleStationsData(doc.array(), stationModel, ui->stationList, ui->lblStationCount, stationCatalog);
+    } else {
+        SensorHandler::handleSensorsData(doc.array(), ui->sensorList, currentSensors);
+    }
+    lblStatus->setText(StaleDataStatus);
+    lblStatus->setStyleSheet("color: orange;");
+}
+
 /**
  * @brief Obsługuje kliknięcie elementu listy stacji.
  * 
- * Aktualizuje identyfikator bieżącej stacji, miasto i adres na podstawie klikniętego elementu. 
+ * Aktualizuje identyfikator bieżącej stacji, miasto i adres na podstawie klikniętego wiersza. 
  * W trybie offline wczytuje dane czujników z pliku lokalnego, w trybie online wysyła żądanie API 
  * dla czujników danej stacji.
  * 
- * @param item Wskaźnik na kliknięty element listy `QListWidgetItem`.
+ * @param index Indeks klikniętego wiersza w modelu listy stacji.
  */
-void MainWindow::on_stationList_itemClicked(QListWidgetItem *item) {
+void MainWindow::on_stationList_clicked(const QModelIndex &index) {
+    if (!index.isValid()) return;
     ui->lblStats->clear();
-    currentStationId = item->data(Qt::UserRole).toInt();
-
-    auto stationData = std::find_if(allStations.begin(), allStations.end(),
-                                    [this](const QPair<QString, QJsonObject>& pair) {
-                                        return pair.second["id"].toInt() == currentStationId;
-                                    });
+    historyLoader->cancel();
+    measurementPipeline->cancel();
+    currentStationId = index.data(Qt::UserRole).toInt();
 
-    if (stationData != allStations.end()) {
-        currentStationCity = stationData->second["city"].toObject()["name"].toString();
-        currentStationAddress = stationData->second["addressStreet"].toString();
+    if (const StationCatalog::Station *station = stationCatalog.find(currentStationId)) {
+        currentStationCity = stationCatalog.cityName(*station);
+        currentStationAddress = station->addressStreet;
     }
 
     if (isOffline) {
@@ -193,11 +348,10 @@ void MainWindow::on_stationList_itemClicked(QListWidgetItem *item) {
         }
         QJsonDocument doc = QJsonDocument::fromJson(sensorsData);
         if (doc.isArray()) {
-            onDataReady(QString::fromUtf8(sensorsData));
+            onDataReady(QString::fromUtf8(sensorsData), ApiClient::Sensors, currentStationId);
         }
     } else {
-        apiClient->fetchData(QUrl(QString("https://api.gios.gov.pl/pjp-api/rest/station/sensors/%1")
-                                      .arg(currentStationId)));
+        apiClient->fetchSensors(currentStationId);
     }
 }
 
@@ -205,8 +359,9 @@ void MainWindow::on_stationList_itemClicked(QListWidgetItem *item) {
  * @brief Obsługuje kliknięcie elementu listy czujników.
  * 
  * Aktualizuje identyfikator bieżącego czujnika i nazwę parametru na podstawie klikniętego elementu. 
- * W trybie offline wczytuje i agreguje dane historyczne dla czujnika, w trybie online wysyła żądanie API 
- * dla danych pomiarowych czujnika.
+ * Anuluje trwające wczytywanie danych historycznych. W trybie offline zleca wczytanie i agregację danych 
+ * historycznych czujnika w tle (`HistoryLoader`), w trybie online rozpoczyna zadanie `MeasurementPipeline` 
+ * (pobranie, dekodowanie, zapis i wyświetlenie danych pomiarowych czujnika), anulujące poprzednie zadanie.
  * 
  * @param item Wskaźnik na kliknięty element listy `QListWidgetItem`.
  */
@@ -223,54 +378,20 @@ void MainWindow::on_sensorList_itemClicked(QListWidgetItem *item) {
         currentParamName = sensorData->second;
     }
 
+    historyLoader->cancel();
     if (isOffline) {
-        QVector<QPair<QDateTime, QByteArray>> allData = DataManager::loadAllHistoricalData("measurements", currentSensorId);
-        if (allData.isEmpty()) {
-            lblStatus->setText("Brak danych historycznych");
-            lblStatus->setStyleSheet("color: red;");
-            return;
-        }
-
-        QMap<QDateTime, double> aggregatedData;
-        for (const auto &dataPair : allData) {
-            QJsonDocument doc = QJsonDocument::fromJson(dataPair.second);
-            if (doc.isObject()) {
-                QJsonArray values = doc.object()["values"].toArray();
-                for (const QJsonValue &val : values) {
-                    QJsonObject entry = val.toObject();
-                    QDateTime date = QDateTime::fromString(entry["date"].toString(), Qt::ISODate);
-                    double value = entry["value"].toDouble(-1.0);
-                    if (value >= 0) {
-                        aggregatedData.insert(date, value);
-                    }
-                }
-            }
-        }
-
-        if (aggregatedData.isEmpty()) {
-            lblStatus->setText("Błędne dane lokalne");
-            lblStatus->setStyleSheet("color: red;");
-            return;
-        }
-
-        QVector<QPair<QDateTime, double>> measurements;
-        for (auto it = aggregatedData.begin(); it != aggregatedData.end(); ++it) {
-            measurements.append(qMakePair(it.key(), it.value()));
-        }
-
-        MeasurementHandler::handleMeasurementsData(QJsonObject(), measurements, ui->lblStats);
-        MeasurementHandler::updateChart(measurements, ui->chartView, currentStationCity, currentStationAddress, currentParamName);
+        measurementPipeline->cancel();
+        startHistoryLoad(0, "Wczytano dane lokalne", "Brak danych historycznych");
     } else {
-        apiClient->fetchSensorData(currentSensorId);
+        measurementPipeline->load(currentSensorId);
     }
 }
 
 /**
  * @brief Obsługuje kliknięcie przycisku historii.
  * 
- * Wczytuje wszystkie dane historyczne dla bieżącego czujnika, agreguje je w posortowanym wektorze 
- * i aktualizuje statystyki oraz wykres w interfejsie użytkownika. Wyświetla odpowiedni komunikat 
- * w zależności od dostępności danych.
+ * Zleca wczytanie w tle wszystkich danych historycznych dla bieżącego czujnika. Statystyki i wykres 
+ * są aktualizowane w `onHistoryLoaded` po zakończeniu zadania.
  */
 void MainWindow::on_btnHistory_clicked() {
     if (currentSensorId == -1) {
@@ -279,100 +400,297 @@ void MainWindow::on_btnHistory_clicked() {
         return;
     }
 
-    QVector<QPair<QDateTime, QByteArray>> allData = DataManager::loadAllHistoricalData("measurements", currentSensorId);
-    QMap<QDateTime, double> aggregatedData;
-
-    for (const auto &dataPair : allData) {
-        QJsonDocument doc = QJsonDocument::fromJson(dataPair.second);
-        if (doc.isObject()) {
-            QJsonArray values = doc.object()["values"].toArray();
-            for (const QJsonValue &val : values) {
-                QJsonObject entry = val.toObject();
-                QDateTime date = QDateTime::fromString(entry["date"].toString(), Qt::ISODate);
-                double value = entry["value"].toDouble(-1.0);
-                if (value >= 0 && date.isValid()) {
-                    aggregatedData.insert(date, value);
-                }
-            }
-        }
-    }
+    startHistoryLoad(0, "Wczytano wszystkie dane historyczne", "Brak danych historycznych");
+}
 
-    QVector<QPair<QDateTime, double>> allMeasurements;
-    for (auto it = aggregatedData.constBegin(); it != aggregatedData.constEnd(); ++it) {
-        allMeasurements.append(qMakePair(it.key(), it.value()));
+/**
+ * @brief Wczytuje historyczne dane pomiarów dla określonego zakresu dni.
+ * 
+ * Zleca wczytanie w tle danych historycznych dla bieżącego czujnika z ostatnich `days` dni. Statystyki 
+ * i wykres są aktualizowane w `onHistoryLoaded` po zakończeniu zadania.
+ * 
+ * @param days Liczba dni do wczytania (np. 7 lub 14).
+ */
+void MainWindow::loadHistoricalData(int days) {
+    if (currentSensorId == -1) {
+        lblStatus->setText("Proszę wybrać stację oraz czujnik");
+        lblStatus->setStyleSheet("color: orange;");
+        return;
     }
 
-    std::sort(allMeasurements.begin(), allMeasurements.end(),
-              [](const auto &a, const auto &b) { return a.first < b.first; });
+    startHistoryLoad(days,
+                     QString("Wczytano dane historyczne z %1 dni").arg(days),
+                     QString("Brak danych historycznych z %1 dni").arg(days));
+}
+
+/**
+ * @brief Zleca wczytanie danych historycznych bieżącego czujnika w tle.
+ * 
+ * Zapamiętuje komunikaty wyświetlane po zakończeniu zadania i przekazuje zadanie do `HistoryLoader`, 
+ * który anuluje poprzednie wczytywanie.
+ * 
+ * @param days Liczba ostatnich dni do wczytania; wartość 0 oznacza wszystkie dane.
+ * @param loadedText Komunikat wyświetlany po wczytaniu danych.
+ * @param emptyText Komunikat wyświetlany, gdy brak danych.
+ */
+void MainWindow::startHistoryLoad(int days, const QString &loadedText, const QString &emptyText) {
+    historyLoadedText = loadedText;
+    historyEmptyText = emptyText;
+    historyLoader->load(currentSensorId, days);
+    lblStatus->setText("Wczytywanie danych historycznych...");
+    lblStatus->setStyleSheet("color: orange;");
+}
+
+/**
+ * @brief Wyświetla dane historyczne wczytane w tle.
+ * 
+ * Wyniki dotyczące innego czujnika niż bieżący są pomijane. Aktualizuje statystyki i wykres 
+ * oraz etykietę statusu komunikatem zapamiętanym w `startHistoryLoad`. Jeśli pliki z danymi istnieją, 
+ * ale nie zawierają żadnego pomiaru, wyświetla komunikat o błędnych danych lokalnych.
+ * 
+ * @param sensorId Identyfikator czujnika.
+ * @param days Zakres dni zadania (0 oznacza wszystkie dane).
+ * @param fileCount Liczba plików z danymi historycznymi czujnika.
+ * @param measurements Posortowane rosnąco według czasu pomiary.
+ */
+void MainWindow::onHistoryLoaded(int sensorId, int days, int fileCount, const QVector<QPair<QDateTime, double>> &measurements) {
+    if (sensorId != currentSensorId) {
+        return;
+    }
 
-    if (!allMeasurements.isEmpty()) {
-        MeasurementHandler::handleMeasurementsData(QJsonObject(), allMeasurements, ui->lblStats);
-        MeasurementHandler::updateChart(allMeasurements, ui->chartView, currentStationCity, currentStationAddress, currentParamName);
-        lblStatus->setText("Wczytano wszystkie dane historyczne");
+    if (!measurements.isEmpty()) {
+        MeasurementHandler::handleMeasurementsData(QJsonObject(), measurements, ui->lblStats);
+        MeasurementHandler::updateChart(measurements, ui->chartView, currentStationCity, currentStationAddress, currentParamName);
+        lblStatus->setText(historyLoadedText);
         lblStatus->setStyleSheet("color: orange;");
     } else {
-        lblStatus->setText("Brak danych historycznych");
+        lblStatus->setText(days == 0 && fileCount > 0 ? "Błędne dane lokalne" : historyEmptyText);
         lblStatus->setStyleSheet("color: red;");
     }
 }
 
 /**
- * @brief Wczytuje historyczne dane pomiarów dla określonego zakresu dni.
- * 
- * Wczytuje dane historyczne dla bieżącego czujnika z ostatnich `days` dni, agreguje je w posortowanym 
- * wektorze i aktualizuje statystyki oraz wykres w interfejsie użytkownika. Wyświetla odpowiedni komunikat 
- * w zależności od dostępności danych.
+ * @brief Wyświetla stacje najbliższe stacji zaznaczonej na liście.
  * 
- * @param days Liczba dni do wczytania (np. 7 lub 14).
+ * Jeśli indeks przestrzenny jest nieaktualny, buduje go na nowo. Wyszukuje 10 stacji najbliższych 
+ * zaznaczonej stacji i wyświetla na liście stację wyjściową oraz jej sąsiadów z odległością w kilometrach. 
+ * W trybie online zleca obiektowi `StationDataSync` pakietowe pobranie czujników i najnowszych danych 
+ * pomiarowych tych stacji, aby były dostępne od razu (także offline).
  */
-void MainWindow::loadHistoricalData(int days) {
-    if (currentSensorId == -1) {
-        lblStatus->setText("Proszę wybrać stację oraz czujnik");
+void MainWindow::showNearestStations() {
+    const int stationId = stationModel->stationIdAt(ui->stationList->currentIndex().row());
+    if (stationId == -1) {
+        lblStatus->setText("Proszę wybrać stację");
         lblStatus->setStyleSheet("color: orange;");
         return;
     }
 
-    QVector<QPair<QDateTime, QByteArray>> allData = DataManager::loadAllHistoricalData("measurements", currentSensorId);
-    QMap<QDateTime, double> aggregatedData;
-
-    QDateTime cutoffDate = QDateTime::currentDateTime().addDays(-days);
-
-    for (const auto &dataPair : allData) {
-        QJsonDocument doc = QJsonDocument::fromJson(dataPair.second);
-        if (doc.isObject()) {
-            QJsonArray values = doc.object()["values"].toArray();
-            for (const QJsonValue &val : values) {
-                QJsonObject entry = val.toObject();
-                QDateTime date = QDateTime::fromString(entry["date"].toString(), Qt::ISODate);
-                if (date.isValid() && date >= cutoffDate) {
-                    double value = entry["value"].toDouble(-1.0);
-                    if (value >= 0) {
-                        aggregatedData.insert(date, value);
-                    }
-                }
+    if (spatialIndexRevision != stationCatalog.revision()) {
+        rebuildSpatialIndex();
+    }
+
+    StationSpatialIndex::Location origin;
+    if (!spatialIndex.locationOf(stationId, &origin)) {
+        lblStatus->setText("Brak współrzędnych stacji");
+        lblStatus->setStyleSheet("color: red;");
+        return;
+    }
+
+    const QVector<StationSpatialIndex::Neighbor> neighbors = spatialIndex.nearest(origin.latitude, origin.longitude, 10, stationId);
+    QVector<QPair<int, QString>> rows;
+    QVector<int> stationIds;
+    rows.append(qMakePair(stationId, QString()));
+    stationIds.append(stationId);
+    for (const auto &neighbor : neighbors) {
+        rows.append(qMakePair(neighbor.stationId, QString("  (%1 km)").arg(neighbor.distanceKm, 0, 'f', 1)));
+        stationIds.append(neighbor.stationId);
+    }
+
+    stationModel->showStations(rows);
+    ui->stationList->setCurrentIndex(stationModel->index(0, 0));
+    ui->lblStationCount->setText("Najbliższe stacje [ " + QString::number(neighbors.size()) + " ]");
+
+    if (!isOffline) {
+        nearbySync->syncStations(stationIds);
+    }
+}
+
+/**
+ * @brief Wyświetla w podpowiedzi paska stanu statystyki pamięci podręcznej API i czasu żądań.
+ * 
+ * Pokazuje udział odpowiedzi obsłużonych bez pobierania oraz średnie czasy etapów żądań sieciowych 
+ * i udział żądań wysłanych ciepłym połączeniem lub przez HTTP/2.
+ */
+void MainWindow::updateNetworkToolTip() {
+    const ResponseCache::Stats cache = apiClient->cacheStats();
+    const RequestTiming::Stats timing = apiClient->timingStats();
+    QString toolTip = QString("Pamięć podręczna API: %1% odpowiedzi bez pobierania "
+                              "(trafienia: %2, niezmienione: %3, pobrane: %4), zaoszczędzono %5 KB")
+                          .arg(qRound(cache.hitRatio() * 100))
+                          .arg(cache.hits)
+                          .arg(cache.revalidated)
+                          .arg(cache.misses)
+                          .arg(cache.bytesSaved / 1024);
+    if (timing.requests > 0) {
+        toolTip += QString("\nŻądania: %1 (ciepłe połączenie: %2, HTTP/2: %3), średnio: połączenie %4 ms, "
+                           "pierwszy bajt %5 ms, transfer %6 ms, razem %7 ms")
+                       .arg(timing.requests)
+                       .arg(timing.reusedConnections)
+                       .arg(timing.http2Requests)
+                       .arg(qRound(timing.averageConnectMs))
+                       .arg(qRound(timing.averageTtfbMs))
+                       .arg(qRound(timing.averageTransferMs))
+                       .arg(qRound(timing.averageTotalMs));
+    }
+    ui->lblStatus->setToolTip(toolTip);
+}
+
+/**
+ * @brief Zleca pobranie z wyprzedzeniem czujników podświetlonej stacji i stacji sąsiednich na liście.
+ * 
+ * Wywoływana przy zmianie bieżącego wiersza (nawigacja strzałkami) i po najechaniu kursorem na wiersz. 
+ * Stacje sąsiednie są podawane od najbliższych (przy tej samej odległości najpierw stacja poniżej). 
+ * W trybie offline nie zleca żądań.
+ * 
+ * @param index Indeks podświetlonego wiersza listy stacji.
+ */
+void MainWindow::prefetchStations(const QModelIndex &index) {
+    if (!index.isValid() || isOffline) {
+        return;
+    }
+    QVector<int> stationIds{stationModel->stationIdAt(index.row())};
+    const int rows = stationModel->rowCount();
+    for (int distance = 1; distance <= Prefetcher::NeighborStations; ++distance) {
+        for (int row : {index.row() + distance, index.row() - distance}) {
+            if (row >= 0 && row < rows) {
+                stationIds.append(stationModel->stationIdAt(row));
             }
         }
     }
+    prefetcher->highlightStations(stationIds);
+}
+
+/**
+ * @brief Zleca pobranie z wyprzedzeniem danych pomiarowych podświetlonego czujnika.
+ * 
+ * Wywoływana przy zmianie bieżącego elementu listy czujników (także po jej wypełnieniu, gdy zaznaczany 
+ * jest pierwszy czujnik) i po najechaniu kursorem na element. W trybie offline nie zleca żądań.
+ * 
+ * @param item Wskaźnik na podświetlony element listy czujników lub nullptr.
+ */
+void MainWindow::prefetchSensor(QListWidgetItem *item) {
+    if (isOffline) {
+        return;
+    }
+    prefetcher->highlightSensor(item ? item->data(Qt::UserRole).toInt() : -1);
+}
 
-    QVector<QPair<QDateTime, double>> filteredData;
-    for (auto it = aggregatedData.constBegin(); it != aggregatedData.constEnd(); ++it) {
-        filteredData.append(qMakePair(it.key(), it.value()));
+/**
+ * @brief Rozpoczyna pobieranie czujników i najnowszych danych pomiarowych wszystkich stacji.
+ * 
+ * Działa tylko w trybie online. Na czas synchronizacji wyłącza akcję, aby nie rozpocząć jej ponownie; 
+ * postęp jest wyświetlany na pasku stanu.
+ */
+void MainWindow::syncAllStations() {
+    if (isOffline) {
+        lblStatus->setText("Brak połączenia z internetem");
+        lblStatus->setStyleSheet("color: red;");
+        return;
     }
 
-    std::sort(filteredData.begin(), filteredData.end(),
-              [](const auto &a, const auto &b) { return a.first < b.first; });
+    actionSyncAll->setEnabled(false);
+    fullSync->syncAll();
+}
 
-    if (!filteredData.isEmpty()) {
-        MeasurementHandler::handleMeasurementsData(QJsonObject(), filteredData, ui->lblStats);
-        MeasurementHandler::updateChart(filteredData, ui->chartView, currentStationCity, currentStationAddress, currentParamName);
-        lblStatus->setText(QString("Wczytano dane historyczne z %1 dni").arg(days));
+/**
+ * @brief Rozpoczyna pobieranie archiwalnych danych pomiarowych zaznaczonego czujnika.
+ * 
+ * Działa tylko w trybie online. Pyta o liczbę dni wstecz (domyślnie 365) i zleca pobieranie obiektowi 
+ * `ArchiveBackfill`; na czas pobierania wyłącza akcję, a postęp jest wyświetlany na pasku stanu. 
+ * Okna pobrane przy wcześniejszym, przerwanym pobieraniu są pomijane.
+ */
+void MainWindow::backfillSensor() {
+    QListWidgetItem *item = ui->sensorList->currentItem();
+    if (!item) {
+        lblStatus->setText("Proszę wybrać czujnik");
         lblStatus->setStyleSheet("color: orange;");
+        return;
+    }
+    if (isOffline) {
+        lblStatus->setText("Brak połączenia z internetem");
+        lblStatus->setStyleSheet("color: red;");
+        return;
+    }
+
+    bool ok = false;
+    const int days = QInputDialog::getInt(this, "Dane archiwalne", "Liczba dni wstecz:", 365, 1, 3650, 1, &ok);
+    if (!ok) {
+        return;
+    }
+
+    const QDate today = QDate::currentDate();
+    actionBackfill->setEnabled(false);
+    archiveBackfill->start({item->data(Qt::UserRole).toInt()}, today.addDays(-days + 1), today);
+}
+
+/**
+ * @brief Włącza śledzenie czasu wykonania lub zapisuje zebrany ślad.
+ * 
+ * Pierwsze wywołanie (gdy śledzenie jest wyłączone) włącza je. Kolejne zapisują ślad w formacie 
+ * Chrome/Perfetto do pliku "trace_<znacznik czasu>.json" w katalogu danych aplikacji i wyświetlają 
+ * jego ścieżkę na pasku stanu; śledzenie pozostaje włączone.
+ */
+void MainWindow::saveTrace() {
+    if (!Tracing::isEnabled()) {
+        Tracing::setEnabled(true);
+        lblStatus->setText("Śledzenie włączone (Ctrl+Shift+T zapisuje ślad)");
+        lblStatus->setStyleSheet("color: green;");
+        return;
+    }
+
+    const QString path = DataManager::getDataFilePath(QString("trace_%1").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")));
+    if (Tracing::writeChromeTrace(path)) {
+        lblStatus->setText("Zapisano ślad: " + path);
+        lblStatus->setStyleSheet("color: green;");
     } else {
-        lblStatus->setText(QString("Brak danych historycznych z %1 dni").arg(days));
+        lblStatus->setText("Nie można zapisać śladu");
         lblStatus->setStyleSheet("color: red;");
     }
 }
 
+/**
+ * @brief Wyświetla panel diagnostyczny z bieżącymi metrykami aplikacji.
+ * 
+ * Panel jest tworzony przy pierwszym wywołaniu, a kolejne wywołania przywracają go na wierzch. 
+ * Tabela metryk jest odświeżana co sekundę tylko wtedy, gdy panel jest widoczny.
+ */
+void MainWindow::showDiagnostics() {
+    if (!diagnosticsDialog) {
+        diagnosticsDialog = new DiagnosticsDialog(this);
+    }
+    diagnosticsDialog->show();
+    diagnosticsDialog->raise();
+    diagnosticsDialog->activateWindow();
+}
+
+/**
+ * @brief Buduje indeks przestrzenny stacji na podstawie współrzędnych z katalogu stacji.
+ * 
+ * Pomija stacje bez poprawnych współrzędnych i zapamiętuje rewizję katalogu, z której zbudowano indeks.
+ */
+void MainWindow::rebuildSpatialIndex() {
+    QVector<StationSpatialIndex::Location> locations;
+    locations.reserve(stationCatalog.size());
+    for (int i = 0; i < stationCatalog.size(); ++i) {
+        const StationCatalog::Station &station = stationCatalog.at(i);
+        if (StationCatalog::hasLocation(station)) {
+            locations.append({station.id, station.latitude, station.longitude});
+        }
+    }
+    spatialIndex.build(locations);
+    spatialIndexRevision = stationCatalog.revision();
+}
+
 /**
  * @brief Aktualizuje zegar w interfejsie użytkownika.
  * 
@@ -408,9 +726,9 @@ void MainWindow::showEvent(QShowEvent *event) {
 void MainWindow::keyPressEvent(QKeyEvent *event) {
     if (event->key() == Qt::Key_Return || event->key() == Qt::Key_Enter) {
         if (ui->stationList->hasFocus()) {
-            QListWidgetItem *currentItem = ui->stationList->currentItem();
-            if (currentItem) {
-                on_stationList_itemClicked(currentItem);
+            QModelIndex currentIndex = ui->stationList->currentIndex();
+            if (currentIndex.isValid()) {
+                on_stationList_clicked(currentIndex);
             }
         } else if (ui->sensorList->hasFocus()) {
             QListWidgetItem *currentItem = ui->sensorList->currentItem();
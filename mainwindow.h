@@ -13,13 +13,26 @@
 #include <QJsonObject>
 #include <QListWidgetItem>
 #include <QKeyEvent>
+#include <QAction>
+#include <QDateTime>
+#include <QInputDialog>
+#include "apiclient.h"
+#include "measurementhandler.h"
+#include "stationcatalog.h"
+#include "stationspatialindex.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
-class ApiClient;
 class ConnectionManager;
+class StationListModel;
+class StationDataSync;
+class ArchiveBackfill;
+class HistoryLoader;
+class MeasurementPipeline;
+class Prefetcher;
+class DiagnosticsDialog;
 
 class MainWindow : public QMainWindow
 {
@@ -30,7 +43,7 @@ public:
      * @brief Konstruktor klasy MainWindow.
      * 
      * Inicjalizuje główne okno aplikacji, konfiguruje interfejs użytkownika, tworzy obiekty `ApiClient` 
-     * i `ConnectionManager`, ustawia timery dla zegara i sprawdzania połączenia oraz konfiguruje filtry zdarzeń.
+     * i `ConnectionManager`, ustawia timery dla zegara i filtrowania listy stacji, włącza śledzenie stanu połączenia oraz konfiguruje filtry zdarzeń.
      * 
      * @param parent Wskaźnik na obiekt nadrzędny (QWidget), domyślnie nullptr.
      */
@@ -78,12 +91,14 @@ private slots:
     /**
      * @brief Obsługuje dane zwrócone przez ApiClient.
      * 
-     * Przetwarza dane JSON (stacje, czujniki lub pomiary), zapisuje je jako dane historyczne 
-     * i aktualizuje interfejs użytkownika (listy, wykres, statystyki).
+     * Przetwarza dane JSON (stacje lub czujniki), zapisuje je jako dane historyczne 
+     * i aktualizuje listy w interfejsie użytkownika; pomiary obsługuje `MeasurementPipeline`.
      * 
      * @param data Dane w formacie QString (JSON).
+     * @param kind Rodzaj żądania.
+     * @param entityId Identyfikator stacji (czujniki) lub czujnika (pomiary), dla którego zlecono żądanie.
      */
-    void onDataReady(const QString &data);
+    void onDataReady(const QString &data, ApiClient::RequestKind kind, int entityId);
 
     /**
      * @brief Obsługuje błędy zgłoszone przez ApiClient.
@@ -91,8 +106,21 @@ private slots:
      * Wyświetla komunikat o błędzie i próbuje wczytać dane lokalne, jeśli są dostępne.
      * 
      * @param error Opis błędu w formacie QString.
+     * @param kind Rodzaj żądania.
+     * @param entityId Identyfikator stacji (czujniki) lub czujnika (pomiary), dla którego zlecono żądanie.
      */
-    void onErrorOccurred(const QString &error);
+    void onErrorOccurred(const QString &error, ApiClient::RequestKind kind, int entityId);
+
+    /**
+     * @brief Obsługuje nieświeże dane z pamięci podręcznej zwrócone przez ApiClient, gdy API jest niedostępne.
+     * 
+     * Wyświetla dane (stacje lub czujniki) bez zapisywania ich jako dane historyczne i informuje o tym na etykiecie statusu.
+     * 
+     * @param data Dane w formacie QString (JSON).
+     * @param kind Rodzaj żądania.
+     * @param entityId Identyfikator stacji (czujniki) lub czujnika (pomiary), dla którego zlecono żądanie.
+     */
+    void onStaleDataReady(const QString &data, ApiClient::RequestKind kind, int entityId);
 
     /**
      * @brief Obsługuje kliknięcie elementu listy stacji.
@@ -100,9 +128,9 @@ private slots:
      * Aktualizuje identyfikator bieżącej stacji, miasto i adres, a następnie wczytuje dane czujników 
      * (online lub offline).
      * 
-     * @param item Wskaźnik na kliknięty element listy `QListWidgetItem`.
+     * @param index Indeks klikniętego wiersza w modelu listy stacji.
      */
-    void on_stationList_itemClicked(QListWidgetItem *item);
+    void on_stationList_clicked(const QModelIndex &index);
 
     /**
      * @brief Obsługuje kliknięcie elementu listy czujników.
@@ -130,6 +158,46 @@ private slots:
      */
     void loadHistoricalData(int days);
 
+    /**
+     * @brief Wyświetla stacje najbliższe stacji zaznaczonej na liście.
+     * 
+     * Wyszukuje w indeksie przestrzennym stacje najbliższe zaznaczonej stacji, wyświetla je na liście 
+     * stacji wraz z odległością i (w trybie online) zleca pakietowe pobranie ich czujników i najnowszych 
+     * danych pomiarowych.
+     */
+    void showNearestStations();
+
+    /**
+     * @brief Pobiera w tle czujniki i najnowsze dane pomiarowe wszystkich stacji.
+     * 
+     * W trybie online zleca obiektowi `StationDataSync` pobranie listy stacji, a następnie czujników 
+     * i danych pomiarowych każdej stacji, aby dane całego kraju były dostępne lokalnie (także offline).
+     */
+    void syncAllStations();
+
+    /**
+     * @brief Pobiera w tle archiwalne dane pomiarowe zaznaczonego czujnika.
+     * 
+     * W trybie online pyta o liczbę dni wstecz i zleca obiektowi `ArchiveBackfill` stronicowane pobranie 
+     * danych archiwalnych, które są zapisywane lokalnie jako dane historyczne czujnika.
+     */
+    void backfillSensor();
+
+    /**
+     * @brief Włącza śledzenie czasu wykonania lub zapisuje zebrany ślad (Ctrl+Shift+T).
+     * 
+     * Ślad obejmuje żądania sieciowe (`ApiWorker`), ich obsługę w wątku GUI, zapis i odczyt danych 
+     * oraz budowę wykresu; można go otworzyć w chrome://tracing lub Perfetto.
+     */
+    void saveTrace();
+
+    /**
+     * @brief Wyświetla panel diagnostyczny z bieżącymi metrykami aplikacji (Ctrl+Shift+D).
+     * 
+     * Panel (`DiagnosticsDialog`) jest niemodalny i tworzony przy pierwszym otwarciu.
+     */
+    void showDiagnostics();
+
     /**
      * @brief Aktualizuje zegar w interfejsie użytkownika.
      * 
@@ -137,12 +205,79 @@ private slots:
      */
     void updateClock();
 
+    /**
+     * @brief Wyświetla dane historyczne wczytane w tle.
+     * 
+     * @param sensorId Identyfikator czujnika.
+     * @param days Zakres dni zadania (0 oznacza wszystkie dane).
+     * @param fileCount Liczba plików z danymi historycznymi czujnika.
+     * @param measurements Posortowane rosnąco według czasu pomiary.
+     */
+    void onHistoryLoaded(int sensorId, int days, int fileCount, const QVector<QPair<QDateTime, double>> &measurements);
+
+    /**
+     * @brief Wyświetla pomiary bieżącego czujnika zdekodowane przez `MeasurementPipeline`.
+     * 
+     * @param sensorId Identyfikator czujnika.
+     * @param measurements Pomiary w kolejności z odpowiedzi API.
+     * @param stats Statystyki serii obliczone w tle.
+     * @param stale Wartość true, jeśli pomiary pochodzą z nieświeżej odpowiedzi z pamięci podręcznej.
+     */
+    void onMeasurementsReady(int sensorId, const QVector<QPair<QDateTime, double>> &measurements, const MeasurementHandler::Statistics &stats,
+                             bool stale);
+
 private:
+    /**
+     * @brief Zleca wczytanie danych historycznych bieżącego czujnika w tle.
+     * 
+     * @param days Liczba ostatnich dni do wczytania; wartość 0 oznacza wszystkie dane.
+     * @param loadedText Komunikat wyświetlany po wczytaniu danych.
+     * @param emptyText Komunikat wyświetlany, gdy brak danych.
+     */
+    void startHistoryLoad(int days, const QString &loadedText, const QString &emptyText);
+
+    /**
+     * @brief Buduje indeks przestrzenny stacji na podstawie współrzędnych z katalogu stacji.
+     */
+    void rebuildSpatialIndex();
+
+    /**
+     * @brief Wyświetla w podpowiedzi paska stanu statystyki pamięci podręcznej API i czasu żądań.
+     */
+    void updateNetworkToolTip();
+
+    /**
+     * @brief Zleca pobranie z wyprzedzeniem czujników podświetlonej stacji i stacji sąsiednich na liście.
+     * 
+     * @param index Indeks podświetlonego wiersza listy stacji.
+     */
+    void prefetchStations(const QModelIndex &index);
+
+    /**
+     * @brief Zleca pobranie z wyprzedzeniem danych pomiarowych podświetlonego czujnika.
+     * 
+     * @param item Wskaźnik na podświetlony element listy czujników lub nullptr.
+     */
+    void prefetchSensor(QListWidgetItem *item);
+
     Ui::MainWindow *ui;
     ApiClient *apiClient;
     ConnectionManager *connectionManager;
+    StationListModel *stationModel;
+    StationDataSync *nearbySync;
+    StationDataSync *fullSync;
+    ArchiveBackfill *archiveBackfill;
+    HistoryLoader *historyLoader;
+    MeasurementPipeline *measurementPipeline;
+    Prefetcher *prefetcher;
+    DiagnosticsDialog *diagnosticsDialog;
+    QAction *actionNearestStations;
+    QAction *actionSyncAll;
+    QAction *actionBackfill;
+    QAction *actionTrace;
+    QAction *actionDiagnostics;
     QTimer *clockTimer;
-    QTimer *connectionCheckTimer;
+    QTimer *searchDebounceTimer;
     QLabel *lblStatus;
     bool isOffline;
     int currentStationId;
@@ -150,8 +285,12 @@ private:
     QString currentStationCity;
     QString currentStationAddress;
     QString currentParamName;
-    QList<QPair<QString, QJsonObject>> allStations;
+    QString historyLoadedText;
+    QString historyEmptyText;
+    StationCatalog stationCatalog;
     QVector<QPair<int, QString>> currentSensors;
+    StationSpatialIndex spatialIndex;
+    int spatialIndexRevision;
 };
 
 #endif
\ No newline at end of file
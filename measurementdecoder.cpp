@@ -0,0 +1,577 @@
+/**
+ * @file measurementdecoder.cpp
+ * @brief Implementacja klasy MeasurementDecoder - strumieniowego dekodera odpowiedzi z pomiarami bez drzewa JSON.
+ */
+
+#include "measurementdecoder.h"
+#include "metrics.h"
+#include "tracing.h"
+
+#include <QElapsedTimer>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+namespace {
+/** Rozmiar bufora obszaru tymczasowego na stosie (B); większe potrzeby są pokrywane ze sterty. */
+constexpr std::size_t ArenaInlineSize = 2048;
+/** Długość najkrótszego wpisu pomiaru (`{"date":"yyyy-MM-dd HH:mm:ss","value":0}`), używana do rezerwacji serii. */
+constexpr int MinEntrySize = 40;
+/** Największe zagnieżdżenie pomijanych wartości. */
+constexpr int MaxDepth = 64;
+/** Największa liczba cyfr znaczących liczby odczytywanej bez utraty dokładności (mieści się w 64 bitach). */
+constexpr int MaxSignificantDigits = 19;
+/** Największa mantysa dokładnie reprezentowalna w typie double (2^53). */
+constexpr quint64 MaxExactMantissa = quint64(1) << 53;
+
+/** Potęgi dziesięci dokładnie reprezentowalne w typie double. */
+constexpr double ExactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+constexpr int MaxExactPower = 22;
+
+/**
+ * @brief Zasób pamięci przekazujący alokacje do sterty i zliczający je.
+ *
+ * Jest zasobem nadrzędnym obszaru tymczasowego, więc liczy tylko alokacje, które nie zmieściły się
+ * w buforze na stosie.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    int allocations = 0;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Odczytuje cztery cyfry szesnastkowe sekwencji `\uXXXX`.
+ */
+bool readHex(const char *begin, const char *end, char32_t *code) {
+    if (end - begin < 4) {
+        return false;
+    }
+    char32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        const char c = begin[i];
+        value <<= 4;
+        if (isDigit(c)) {
+            value |= static_cast<char32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value |= static_cast<char32_t>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            value |= static_cast<char32_t>(c - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+    *code = value;
+    return true;
+}
+
+/**
+ * @brief Zapisuje znak w UTF-8 i zwraca wskaźnik za zapisanymi bajtami.
+ */
+char *appendUtf8(char *out, char32_t code) {
+    if (code < 0x80) {
+        *out++ = static_cast<char>(code);
+    } else if (code < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (code >> 6));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (code >> 12));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (code >> 18));
+        *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+/**
+ * @brief Odczytuje liczbę całkowitą z podanej liczby cyfr dziesiętnych.
+ */
+bool readDigits(std::string_view text, std::size_t position, int count, int *value) {
+    int result = 0;
+    for (int i = 0; i < count; ++i) {
+        const char c = text[position + static_cast<std::size_t>(i)];
+        if (!isDigit(c)) {
+            return false;
+        }
+        result = result * 10 + (c - '0');
+    }
+    *value = result;
+    return true;
+}
+
+/**
+ * @brief Odczytuje datę pomiaru.
+ *
+ * Format API (`yyyy-MM-dd HH:mm:ss`, także z separatorem `T`) jest odczytywany bezpośrednio z bajtów,
+ * jako czas lokalny - tak jak `QDateTime::fromString` z `Qt::ISODate` dla daty bez strefy czasowej.
+ * Pozostałe warianty ISO 8601 (ułamki sekund, strefa czasowa) są przekazywane do `QDateTime::fromString`.
+ */
+QDateTime parseDate(std::string_view text) {
+    if (text.size() == 19 && text[4] == '-' && text[7] == '-' && (text[10] == ' ' || text[10] == 'T')
+        && text[13] == ':' && text[16] == ':') {
+        int year, month, day, hour, minute, second;
+        if (!readDigits(text, 0, 4, &year) || !readDigits(text, 5, 2, &month) || !readDigits(text, 8, 2, &day)
+            || !readDigits(text, 11, 2, &hour) || !readDigits(text, 14, 2, &minute) || !readDigits(text, 17, 2, &second)
+            || !QDate::isValid(year, month, day) || !QTime::isValid(hour, minute, second)) {
+            return QDateTime();
+        }
+        return QDateTime(QDate(year, month, day), QTime(hour, minute, second));
+    }
+    return QDateTime::fromString(QString::fromUtf8(text.data(), static_cast<int>(text.size())), Qt::ISODate);
+}
+
+/**
+ * @brief Odczytuje kolejne elementy dokumentu JSON z bufora bajtów.
+ *
+ * Teksty bez sekwencji ucieczki są zwracane jako widoki bufora wejściowego; pozostałe są rozpakowywane
+ * do obszaru tymczasowego.
+ */
+class Scanner
+{
+public:
+    Scanner(const char *begin, const char *end, std::pmr::memory_resource *arena)
+        : p(begin), end(end), arena(arena) {}
+
+    bool atEnd() {
+        skipSpace();
+        return p == end;
+    }
+
+    bool peek(char c) {
+        skipSpace();
+        return p != end && *p == c;
+    }
+
+    bool peekNumber() {
+        skipSpace();
+        return p != end && (*p == '-' || isDigit(*p));
+    }
+
+    bool consume(char c) {
+        if (!peek(c)) {
+            return false;
+        }
+        ++p;
+        return true;
+    }
+
+    bool readString(std::string_view *out);
+    bool readNumber(double *out);
+    bool skipValue(int depth = 0);
+
+private:
+    void skipSpace() {
+        while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+            ++p;
+        }
+    }
+
+    bool readLiteral(std::string_view literal);
+    bool unescape(const char *begin, const char *stop, std::string_view *out);
+
+    const char *p;
+    const char *end;
+    std::pmr::memory_resource *arena;
+};
+
+/**
+ * @brief Odczytuje tekst; dla `out` równego nullptr tylko go pomija (bez rozpakowywania).
+ */
+bool Scanner::readString(std::string_view *out) {
+    if (!consume('"')) {
+        return false;
+    }
+    const char *begin = p;
+    bool escaped = false;
+    while (p != end && *p != '"') {
+        if (*p == '\\') {
+            escaped = true;
+            if (++p == end) {
+                return false;
+            }
+        } else if (static_cast<unsigned char>(*p) < 0x20) {
+            return false;
+        }
+        ++p;
+    }
+    if (p == end) {
+        return false;
+    }
+    const char *stop = p++;
+    if (!out) {
+        return true;
+    }
+    if (!escaped) {
+        *out = std::string_view(begin, static_cast<std::size_t>(stop - begin));
+        return true;
+    }
+    return unescape(begin, stop, out);
+}
+
+/**
+ * @brief Rozpakowuje tekst z sekwencjami ucieczki do obszaru tymczasowego.
+ *
+ * Wynik nie jest dłuższy niż zapis w JSON, więc bufor jest przydzielany raz. Niesparowane surogaty
+ * UTF-16 są zastępowane znakiem U+FFFD.
+ */
+bool Scanner::unescape(const char *begin, const char *stop, std::string_view *out) {
+    char *buffer = static_cast<char *>(arena->allocate(static_cast<std::size_t>(stop - begin), 1));
+    char *w = buffer;
+    for (const char *s = begin; s != stop; ++s) {
+        if (*s != '\\') {
+            *w++ = *s;
+            continue;
+        }
+        switch (*++s) {
+        case '"':
+        case '\\':
+        case '/':
+            *w++ = *s;
+            break;
+        case 'b':
+            *w++ = '\b';
+            break;
+        case 'f':
+            *w++ = '\f';
+            break;
+        case 'n':
+            *w++ = '\n';
+            break;
+        case 'r':
+            *w++ = '\r';
+            break;
+        case 't':
+            *w++ = '\t';
+            break;
+        case 'u': {
+            char32_t code;
+            if (!readHex(s + 1, stop, &code)) {
+                return false;
+            }
+            s += 4;
+            char32_t low;
+            if (code >= 0xD800 && code < 0xDC00 && stop - s >= 7 && s[1] == '\\' && s[2] == 'u'
+                && readHex(s + 3, stop, &low) && low >= 0xDC00 && low < 0xE000) {
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                s += 6;
+            } else if (code >= 0xD800 && code < 0xE000) {
+                code = 0xFFFD;
+            }
+            w = appendUtf8(w, code);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    *out = std::string_view(buffer, static_cast<std::size_t>(w - buffer));
+    return true;
+}
+
+/**
+ * @brief Odczytuje liczbę.
+ *
+ * Liczby o co najwyżej 19 cyfrach znaczących, których mantysa i wykładnik dziesiętny są dokładnie
+ * reprezentowalne w typie double (wszystkie wartości pomiarów API), są wyliczane jednym mnożeniem lub
+ * dzieleniem, co daje wynik poprawnie zaokrąglony, jak `strtod`. Pozostałe są odczytywane przez
+ * `QByteArray::toDouble` (niezależnie od ustawień regionalnych).
+ */
+bool Scanner::readNumber(double *out) {
+    skipSpace();
+    const char *begin = p;
+    const bool negative = p != end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) {
+        return false;
+    }
+
+    quint64 mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool exact = true;
+    auto addDigit = [&](char c, bool fraction) {
+        if (significant < MaxSignificantDigits) {
+            mantissa = mantissa * 10 + static_cast<quint64>(c - '0');
+            if (mantissa != 0) {
+                ++significant;
+            }
+            if (fraction) {
+                --exponent;
+            }
+        } else {
+            exact = exact && c == '0';
+            if (!fraction) {
+                ++exponent;
+            }
+        }
+    };
+
+    if (*p == '0') {
+        ++p;
+    } else {
+        while (p != end && isDigit(*p)) {
+            addDigit(*p++, false);
+        }
+    }
+    if (p != end && *p == '.') {
+        ++p;
+        if (p == end || !isDigit(*p)) {
+            return false;
+        }
+        while (p != end && isDigit(*p)) {
+            addDigit(*p++, true);
+        }
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        const bool negativeExponent = p != end && *p == '-';
+        if (p != end && (*p == '-' || *p == '+')) {
+            ++p;
+        }
+        if (p == end || !isDigit(*p)) {
+            return false;
+        }
+        int value = 0;
+        while (p != end && isDigit(*p)) {
+            value = qMin(value * 10 + (*p++ - '0'), 100000);
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+
+    if (exact && mantissa <= MaxExactMantissa && exponent >= -MaxExactPower && exponent <= MaxExactPower) {
+        const double value = static_cast<double>(mantissa);
+        const double result = exponent < 0 ? value / ExactPowersOfTen[-exponent] : value * ExactPowersOfTen[exponent];
+        *out = negative ? -result : result;
+        return true;
+    }
+    bool ok = false;
+    *out = QByteArray(begin, static_cast<int>(p - begin)).toDouble(&ok);
+    return ok;
+}
+
+/**
+ * @brief Pomija dowolną wartość JSON, sprawdzając jej składnię.
+ */
+bool Scanner::skipValue(int depth) {
+    if (depth > MaxDepth || atEnd()) {
+        return false;
+    }
+    switch (*p) {
+    case '"':
+        return readString(nullptr);
+    case '{':
+        ++p;
+        if (consume('}')) {
+            return true;
+        }
+        do {
+            if (!readString(nullptr) || !consume(':') || !skipValue(depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume('}');
+    case '[':
+        ++p;
+        if (consume(']')) {
+            return true;
+        }
+        do {
+            if (!skipValue(depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume(']');
+    case 't':
+        return readLiteral("true");
+    case 'f':
+        return readLiteral("false");
+    case 'n':
+        return readLiteral("null");
+    default: {
+        double ignored;
+        return readNumber(&ignored);
+    }
+    }
+}
+
+bool Scanner::readLiteral(std::string_view literal) {
+    if (static_cast<std::size_t>(end - p) < literal.size() || std::string_view(p, literal.size()) != literal) {
+        return false;
+    }
+    p += literal.size();
+    return true;
+}
+
+/**
+ * @brief Odczytuje tablicę `values` i dopisuje poprawne pomiary do serii.
+ */
+bool parseValues(Scanner &scanner, MeasurementDecoder::Series *series, const QDateTime &cutoff, MeasurementDecoder::Result *result) {
+    if (!scanner.consume('[')) {
+        return false;
+    }
+    if (scanner.consume(']')) {
+        return true;
+    }
+    do {
+        if (!scanner.consume('{')) {
+            if (!scanner.skipValue()) {
+                return false;
+            }
+            ++result->skipped;
+            continue;
+        }
+
+        QDateTime date;
+        double value = -1.0;
+        if (!scanner.consume('}')) {
+            do {
+                std::string_view name;
+                if (!scanner.readString(&name) || !scanner.consume(':')) {
+                    return false;
+                }
+                if (name == "date" && scanner.peek('"')) {
+                    std::string_view text;
+                    if (!scanner.readString(&text)) {
+                        return false;
+                    }
+                    date = parseDate(text);
+                } else if (name == "value" && scanner.peekNumber()) {
+                    if (!scanner.readNumber(&value)) {
+                        return false;
+                    }
+                } else if (!scanner.skipValue()) {
+                    return false;
+                }
+            } while (scanner.consume(','));
+            if (!scanner.consume('}')) {
+                return false;
+            }
+        }
+
+        if (value >= 0 && date.isValid() && (!cutoff.isValid() || date >= cutoff)) {
+            series->append({date, value});
+            ++result->points;
+        } else {
+            ++result->skipped;
+        }
+    } while (scanner.consume(','));
+    return scanner.consume(']');
+}
+
+/**
+ * @brief Odczytuje obiekt główny odpowiedzi; pola inne niż `key` i `values` są pomijane.
+ */
+bool parseDocument(Scanner &scanner, MeasurementDecoder::Series *series, const QDateTime &cutoff, QString *key,
+                   MeasurementDecoder::Result *result) {
+    if (!scanner.consume('{')) {
+        return false;
+    }
+    if (scanner.consume('}')) {
+        return scanner.atEnd();
+    }
+    do {
+        std::string_view name;
+        if (!scanner.readString(&name) || !scanner.consume(':')) {
+            return false;
+        }
+        if (name == "values" && scanner.peek('[')) {
+            if (!parseValues(scanner, series, cutoff, result)) {
+                return false;
+            }
+        } else if (name == "key" && key && scanner.peek('"')) {
+            std::string_view text;
+            if (!scanner.readString(&text)) {
+                return false;
+            }
+            *key = QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+        } else if (!scanner.skipValue()) {
+            return false;
+        }
+    } while (scanner.consume(','));
+    return scanner.consume('}') && scanner.atEnd();
+}
+}
+
+/**
+ * @brief Dekoduje odpowiedź `data/getData` i dopisuje pomiary do serii.
+ *
+ * Obszar tymczasowy zaczyna się od bufora na stosie (`ArenaInlineSize`), a jego zasób nadrzędny zlicza
+ * alokacje na stercie. Seria jest rezerwowana na górne oszacowanie liczby wpisów (rozmiar dokumentu
+ * podzielony przez długość najkrótszego wpisu), chyba że ma już wystarczającą pojemność - np. bufor
+ * używany ponownie dla kolejnych plików. Liczba alokacji jest zapisywana w histogramie
+ * `mjp_decode_heap_allocations`, a czas i liczba pomiarów w tych samych metrykach co
+ * `MeasurementHandler::parseMeasurements`.
+ *
+ * @param json Odpowiedź API w formacie JSON.
+ * @param series Wskaźnik na serię, do której dopisywane są pomiary.
+ * @param cutoff Najstarsza uwzględniana data (niepoprawna data oznacza brak ograniczenia).
+ * @param key Wskaźnik na zmienną na kod parametru lub nullptr.
+ * @return Result Wynik dekodowania.
+ */
+MeasurementDecoder::Result MeasurementDecoder::decode(const QByteArray &json, Series *series, const QDateTime &cutoff, QString *key) {
+    MJP_TRACE_SCOPE("MeasurementDecoder::decode");
+    static Metrics::Histogram &duration = Metrics::histogram("mjp_parse_duration_microseconds", "Czas odczytu pomiarów z odpowiedzi API");
+    static Metrics::Counter &ingested = Metrics::counter("mjp_points_ingested_total", "Pomiary odczytane z odpowiedzi API");
+    static Metrics::Histogram &allocations = Metrics::histogram("mjp_decode_heap_allocations",
+                                                                "Alokacje na stercie podczas dekodowania jednej odpowiedzi z pomiarami");
+    QElapsedTimer timer;
+    timer.start();
+
+    std::array<std::byte, ArenaInlineSize> inlineBuffer;
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena(inlineBuffer.data(), inlineBuffer.size(), &upstream);
+    Scanner scanner(json.constData(), json.constData() + json.size(), &arena);
+
+    Result result;
+    const int originalSize = series->size();
+    const int estimate = json.size() / MinEntrySize + 1;
+    if (series->capacity() - originalSize < estimate) {
+        series->reserve(originalSize + estimate);
+        ++result.heapAllocations;
+    }
+    const int reservedCapacity = series->capacity();
+
+    result.valid = parseDocument(scanner, series, cutoff, key, &result);
+    if (!result.valid) {
+        series->resize(originalSize);
+        result.points = 0;
+        result.skipped = 0;
+    }
+    if (series->capacity() != reservedCapacity) {
+        ++result.heapAllocations;
+    }
+    result.heapAllocations += upstream.allocations;
+
+    ingested.add(static_cast<quint64>(result.points));
+    allocations.record(result.heapAllocations);
+    duration.record(timer.nsecsElapsed() / 1000);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ * @file measurementdecoder.h
+ * @brief Definicja klasy MeasurementDecoder - strumieniowego dekodera odpowiedzi z pomiarami bez drzewa JSON.
+ */
+
+#ifndef MEASUREMENTDECODER_H
+#define MEASUREMENTDECODER_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+class MeasurementDecoder
+{
+public:
+    using Series = QVector<QPair<QDateTime, double>>;
+
+    /**
+     * @brief Wynik dekodowania jednej odpowiedzi.
+     *
+     * `heapAllocations` obejmuje alokacje obszaru tymczasowego poza buforem na stosie oraz powiększenia
+     * serii wynikowej; dla odpowiedzi bez sekwencji ucieczki w tekstach i z serią zarezerwowaną
+     * z wyprzedzeniem wynosi 0 niezależnie od liczby pomiarów.
+     */
+    struct Result {
+        bool valid = false;
+        int points = 0;
+        int skipped = 0;
+        int heapAllocations = 0;
+    };
+
+    /**
+     * @brief Dekoduje odpowiedź `data/getData` (`{"key", "values": [{"date", "value"}]}`) i dopisuje pomiary do serii.
+     *
+     * Dokument jest odczytywany bezpośrednio z bajtów UTF-8, bez tworzenia `QJsonDocument`, obiektów
+     * `QJsonObject` i tekstów `QString` dla pojedynczych pomiarów. Teksty z sekwencjami ucieczki są
+     * rozpakowywane do obszaru tymczasowego (`std::pmr::monotonic_buffer_resource`) zwalnianego w całości
+     * po zakończeniu dekodowania. Seria jest rezerwowana raz, na podstawie rozmiaru dokumentu.
+     *
+     * Pomiary bez wartości (null), z wartością ujemną, z niepoprawną datą lub starsze niż `cutoff` są pomijane.
+     * Niepoprawny dokument nie zmienia serii.
+     *
+     * @param json Odpowiedź API w formacie JSON.
+     * @param series Wskaźnik na serię, do której dopisywane są pary (czas, wartość) w kolejności z odpowiedzi.
+     * @param cutoff Najstarsza uwzględniana data (niepoprawna data oznacza brak ograniczenia).
+     * @param key Wskaźnik na zmienną, do której zostanie zapisany kod parametru (`key`), lub nullptr.
+     * @return Result Wynik dekodowania; `valid` ma wartość false, jeśli dokument nie jest poprawnym obiektem JSON.
+     */
+    static Result decode(const QByteArray &json, Series *series, const QDateTime &cutoff = QDateTime(), QString *key = nullptr);
+};
+
+#endif
\ No newline at end of file
@@ -4,31 +4,87 @@
  */
 
 #include "measurementhandler.h"
+#include "metrics.h"
+#include "tracing.h"
+
+#include <QElapsedTimer>
 
 /**
  * @brief Przetwarza dane pomiarowe i aktualizuje statystyki w interfejsie użytkownika.
  * 
- * Przetwarza dane pomiarowe z wektora `customData` lub z obiektu JSON (`obj`), tworząc posortowaną listę 
- * pomiarów (czas, wartość). Oblicza minimalną, maksymalną i średnią wartość oraz trend danych, 
- * a następnie aktualizuje etykietę `lblStats` z wynikami w formacie tekstowym.
+ * Przetwarza dane pomiarowe z wektora `customData` lub z obiektu JSON (`obj`, przez `parseMeasurements`), 
+ * oblicza statystyki (`computeStatistics`), a następnie wyświetla je w etykiecie `lblStats` (`showStatistics`).
  * 
  * @param obj Obiekt JSON zawierający dane pomiarowe (używany, jeśli `customData` jest puste).
  * @param customData Wektor par (czas, wartość) z danymi pomiarowymi.
  * @param lblStats Wskaźnik na `QLabel`, w którym wyświetlane są statystyki.
  */
 void MeasurementHandler::handleMeasurementsData(const QJsonObject &obj, const QVector<QPair<QDateTime, double>> &customData, QLabel *lblStats) {
-    QVector<QPair<QDateTime, double>> measurements = customData;
-
-    if (measurements.isEmpty()) {
-        QJsonArray values = obj["values"].toArray();
-        for (const QJsonValue &val : values) {
-            QJsonObject entry = val.toObject();
-            QDateTime date = QDateTime::fromString(entry["date"].toString(), Qt::ISODate);
-            double value = entry["value"].toDouble(-1.0);
-            if (value >= 0) measurements.append({date, value});
-        }
+    MJP_TRACE_SCOPE("MeasurementHandler::handleMeasurementsData");
+    showStatistics(computeStatistics(customData.isEmpty() ? parseMeasurements(obj) : customData), lblStats);
+}
+
+/**
+ * @brief Wyświetla obliczone wcześniej statystyki serii.
+ * 
+ * Aktualizuje etykietę `lblStats` minimum, średnią, maksimum (z dokładnością do 0,1) i trendem.
+ * 
+ * @param stats Statystyki serii; przy `count` równym 0 etykieta nie jest zmieniana.
+ * @param lblStats Wskaźnik na `QLabel`, w którym wyświetlane są statystyki.
+ */
+void MeasurementHandler::showStatistics(const Statistics &stats, QLabel *lblStats) {
+    if (stats.count > 0) {
+        QString output = QString("Minimum: %1\nŚrednia: %2\nMaksimum: %3\n\nTrend: %4")
+                             .arg(stats.min, 0, 'f', 1)
+                             .arg(stats.avg, 0, 'f', 1)
+                             .arg(stats.max, 0, 'f', 1)
+                             .arg(stats.trend);
+        lblStats->setText(output);
+    }
+}
+
+/**
+ * @brief Odczytuje pomiary z odpowiedzi `data/getData`.
+ * 
+ * Daty są odczytywane w formacie ISO 8601, a pomiary bez wartości (null) i z wartością ujemną są pomijane.
+ * 
+ * @param obj Obiekt JSON zawierający dane pomiarowe.
+ * @return QVector<QPair<QDateTime, double>> Pary (czas, wartość) w kolejności z odpowiedzi.
+ */
+QVector<QPair<QDateTime, double>> MeasurementHandler::parseMeasurements(const QJsonObject &obj) {
+    MJP_TRACE_SCOPE("MeasurementHandler::parseMeasurements");
+    static Metrics::Histogram &duration = Metrics::histogram("mjp_parse_duration_microseconds", "Czas odczytu pomiarów z odpowiedzi API");
+    static Metrics::Counter &ingested = Metrics::counter("mjp_points_ingested_total", "Pomiary odczytane z odpowiedzi API");
+    QElapsedTimer timer;
+    timer.start();
+    QVector<QPair<QDateTime, double>> measurements;
+    const QJsonArray values = obj["values"].toArray();
+    measurements.reserve(values.size());
+    for (const QJsonValue &val : values) {
+        QJsonObject entry = val.toObject();
+        QDateTime date = QDateTime::fromString(entry["date"].toString(), Qt::ISODate);
+        double value = entry["value"].toDouble(-1.0);
+        if (value >= 0) measurements.append({date, value});
     }
+    ingested.add(static_cast<quint64>(measurements.size()));
+    duration.record(timer.nsecsElapsed() / 1000);
+    return measurements;
+}
 
+/**
+ * @brief Oblicza minimum, średnią, maksimum i trend serii pomiarów.
+ * 
+ * Sortuje pomiary według czasu (trend zależy od kolejności), pomija wartości ujemne przy minimum, 
+ * średniej i maksimum, a trend wyznacza `analyzeTrend`.
+ * 
+ * @param measurements Pary (czas, wartość) w dowolnej kolejności.
+ * @return Statistics Statystyki serii; `count` równe 0 oznacza brak poprawnych wartości.
+ */
+MeasurementHandler::Statistics MeasurementHandler::computeStatistics(QVector<QPair<QDateTime, double>> measurements) {
+    MJP_TRACE_SCOPE("MeasurementHandler::computeStatistics");
+    static Metrics::Histogram &duration = Metrics::histogram("mjp_statistics_duration_microseconds", "Czas obliczenia statystyk serii pomiarów");
+    QElapsedTimer timer;
+    timer.start();
     std::sort(measurements.begin(), measurements.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
 
     QVector<double> validValues;
@@ -36,19 +92,16 @@ void MeasurementHandler::handleMeasurementsData(const QJsonObject &obj, const QV
         if (m.second >= 0) validValues.append(m.second);
     }
 
+    Statistics stats;
     if (!validValues.isEmpty()) {
-        double minVal = *std::min_element(validValues.begin(), validValues.end());
-        double maxVal = *std::max_element(validValues.begin(), validValues.end());
-        double avgVal = std::accumulate(validValues.begin(), validValues.end(), 0.0) / validValues.size();
-        QString trend = analyzeTrend(measurements);
-
-        QString output = QString("Minimum: %1\nŚrednia: %2\nMaksimum: %3\n\nTrend: %4")
-                             .arg(minVal, 0, 'f', 1)
-                             .arg(avgVal, 0, 'f', 1)
-                             .arg(maxVal, 0, 'f', 1)
-                             .arg(trend);
-        lblStats->setText(output);
+        stats.count = validValues.size();
+        stats.min = *std::min_element(validValues.begin(), validValues.end());
+        stats.max = *std::max_element(validValues.begin(), validValues.end());
+        stats.avg = std::accumulate(validValues.begin(), validValues.end(), 0.0) / validValues.size();
+        stats.trend = analyzeTrend(measurements);
     }
+    duration.record(timer.nsecsElapsed() / 1000);
+    return stats;
 }
 
 /**
@@ -101,6 +154,7 @@ QString MeasurementHandler::analyzeTrend(const QVector<QPair<QDateTime, double>>
  * @note Funkcja kończy działanie, jeśli dane są puste.
  */
 void MeasurementHandler::updateChart(const QVector<QPair<QDateTime, double>> &data, QChartView *chartView, const QString &stationCity, const QString &stationAddress, const QString &paramName) {
+    MJP_TRACE_SCOPE("MeasurementHandler::updateChart");
     if (data.isEmpty()) return;
 
     QChart *oldChart = chartView->chart();
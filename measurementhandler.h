@@ -25,6 +25,39 @@
 class MeasurementHandler
 {
 public:
+    /**
+     * @brief Statystyki serii pomiarów.
+     * 
+     * `count` to liczba poprawnych (nieujemnych) wartości; pozostałe pola mają sens tylko, gdy jest ona dodatnia.
+     */
+    struct Statistics {
+        int count = 0;
+        double min = 0.0;
+        double avg = 0.0;
+        double max = 0.0;
+        QString trend;
+    };
+
+    /**
+     * @brief Odczytuje pomiary z odpowiedzi `data/getData` (`{"values": [{"date", "value"}]}`).
+     * 
+     * Pomija pomiary bez wartości (null) i z wartością ujemną.
+     * 
+     * @param obj Obiekt JSON zawierający dane pomiarowe.
+     * @return QVector<QPair<QDateTime, double>> Pary (czas, wartość) w kolejności z odpowiedzi.
+     */
+    static QVector<QPair<QDateTime, double>> parseMeasurements(const QJsonObject &obj);
+
+    /**
+     * @brief Oblicza minimum, średnią, maksimum i trend serii pomiarów.
+     * 
+     * Nie korzysta z interfejsu użytkownika, więc można ją wywołać także poza wątkiem GUI (np. w benchmarkach).
+     * 
+     * @param measurements Pary (czas, wartość) w dowolnej kolejności.
+     * @return Statistics Statystyki serii.
+     */
+    static Statistics computeStatistics(QVector<QPair<QDateTime, double>> measurements);
+
     /**
      * @brief Przetwarza dane pomiarowe i aktualizuje statystyki w interfejsie użytkownika.
      * 
@@ -37,6 +70,14 @@ public:
      */
     static void handleMeasurementsData(const QJsonObject &obj, const QVector<QPair<QDateTime, double>> &customData, QLabel *lblStats);
 
+    /**
+     * @brief Wyświetla obliczone wcześniej statystyki serii (np. w tle, przez `computeStatistics`).
+     * 
+     * @param stats Statystyki serii; przy `count` równym 0 etykieta nie jest zmieniana.
+     * @param lblStats Wskaźnik na `QLabel`, w którym wyświetlane są statystyki.
+     */
+    static void showStatistics(const Statistics &stats, QLabel *lblStats);
+
     /**
      * @brief Aktualizuje wykres danych pomiarowych w interfejsie użytkownika.
      * 
@@ -0,0 +1,179 @@
+/**
+ * @file measurementpipeline.cpp
+ * @brief Implementacja klasy MeasurementPipeline - potoku pobierania, dekodowania, zapisu i wyświetlania pomiarów czujnika.
+ */
+
+#include "measurementpipeline.h"
+#include "datamanager.h"
+#include "measurementdecoder.h"
+#include "tracing.h"
+
+/**
+ * @brief Konstruktor klasy MeasurementPipeline.
+ *
+ * Łączy odpowiedzi (także nieświeże odpowiedzi z pamięci podręcznej) oraz błędy żądań pomiarów z `ApiClient`
+ * z etapami potoku. Etapy w tle są zlecane
+ * wspólnej puli wątków (`TaskExecutor`) z wysokim priorytetem, bo na ich wynik czeka użytkownik.
+ *
+ * @param apiClient Wskaźnik na klienta API.
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+MeasurementPipeline::MeasurementPipeline(ApiClient *apiClient, QObject *parent)
+    : QObject(parent)
+    , apiClient(apiClient)
+    , tasks(TaskExecutor::High)
+    , currentJobId(0)
+    , currentSensorId(-1)
+    , running(false)
+{
+    connect(apiClient, &ApiClient::dataReady, this, [this](const QString &data, ApiClient::RequestKind kind, int entityId) {
+        onDataReady(data, kind, entityId, false);
+    });
+    connect(apiClient, &ApiClient::staleDataReady, this, [this](const QString &data, ApiClient::RequestKind kind, int entityId) {
+        onDataReady(data, kind, entityId, true);
+    });
+    connect(apiClient, &ApiClient::errorOccurred, this, [this](const QString &, ApiClient::RequestKind kind, int entityId) {
+        onErrorOccurred(kind, entityId);
+    });
+}
+
+/**
+ * @brief Destruktor klasy MeasurementPipeline.
+ *
+ * Anuluje bieżące zadanie i czeka na zakończenie jego zadań we wspólnej puli wątków, aby rozpoczęty zapis
+ * danych został dokończony, a zadania nie odwoływały się do usuniętego obiektu.
+ */
+MeasurementPipeline::~MeasurementPipeline() {
+    cancel();
+    tasks.wait();
+}
+
+/**
+ * @brief Rozpoczyna zadanie dla czujnika.
+ *
+ * Zadanie przechodzi przez etapy: pobranie (`ApiClient::fetchSensorData`, w wątku sieciowym), dekodowanie
+ * i statystyki (`run`, we wspólnej puli wątków), przekazanie wyników do wątku obiektu (`onJobFinished`) i zapis
+ * danych (w puli wątków, po przekazaniu wyników, więc wyświetlanie nie czeka na dysk). Etapy kolejnych zadań
+ * nakładają się: nowe żądanie może być pobierane i dekodowane, gdy poprzednie dane są jeszcze zapisywane.
+ * Poprzednie zadanie jest anulowane, ale jego żądanie sieciowe zastępuje `ApiClient::fetchSensorData`, więc
+ * ponowny wybór tego samego czujnika w trakcie pobierania nie przerywa połączenia.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @return int Identyfikator zadania.
+ */
+int MeasurementPipeline::load(int sensorId) {
+    currentCancellation.cancel();
+
+    const int jobId = ++currentJobId;
+    currentSensorId = sensorId;
+    currentCancellation = TaskExecutor::CancellationToken();
+    running = true;
+    apiClient->fetchSensorData(sensorId);
+    return jobId;
+}
+
+/**
+ * @brief Anuluje bieżące zadanie (jeśli jest w toku).
+ *
+ * Przerywa żądanie sieciowe (`ApiClient::cancel`), a jeśli odpowiedź jest już dekodowana, jej wyniki
+ * nie są przekazywane. Odebrane dane są mimo to zapisywane.
+ */
+void MeasurementPipeline::cancel() {
+    if (!running) {
+        return;
+    }
+    apiClient->cancel(ApiClient::Measurements);
+    currentCancellation.cancel();
+    running = false;
+}
+
+/**
+ * @brief Sprawdza, czy zadanie jest w toku.
+ *
+ * @return bool Wartość true, jeśli wyniki bieżącego zadania nie zostały jeszcze przekazane.
+ */
+bool MeasurementPipeline::isRunning() const {
+    return running;
+}
+
+/**
+ * @brief Przekazuje odpowiedź z pomiarami do wspólnej puli wątków.
+ *
+ * Odpowiedzi innych zadań niż bieżące (np. zleconych przed anulowaniem) są tylko dekodowane i zapisywane,
+ * tak jak wcześniej w `MainWindow::onDataReady`. Nieświeże odpowiedzi z pamięci podręcznej są tylko wyświetlane.
+ */
+void MeasurementPipeline::onDataReady(const QString &data, ApiClient::RequestKind kind, int entityId, bool stale) {
+    if (kind != ApiClient::Measurements) {
+        return;
+    }
+    const bool current = running && entityId == currentSensorId;
+    const int jobId = current ? currentJobId : 0;
+    TaskExecutor::CancellationToken cancellation = current ? currentCancellation : TaskExecutor::CancellationToken();
+    if (!current) {
+        cancellation.cancel();
+    }
+    tasks.run([this, jobId, entityId, data, stale, cancellation]() {
+        run(jobId, entityId, data, stale, cancellation);
+    });
+}
+
+/**
+ * @brief Kończy bieżące zadanie po błędzie żądania pomiarów; obsługę błędu (dane lokalne) zapewnia odbiorca
+ * sygnału `ApiClient::errorOccurred`.
+ */
+void MeasurementPipeline::onErrorOccurred(ApiClient::RequestKind kind, int entityId) {
+    if (kind == ApiClient::Measurements && running && entityId == currentSensorId) {
+        running = false;
+    }
+}
+
+/**
+ * @brief Przekazuje wyniki bieżącego zadania (wykonywane w wątku obiektu).
+ *
+ * Wyniki zadań zastąpionych nowszym zadaniem lub anulowanych są odrzucane.
+ */
+void MeasurementPipeline::onJobFinished(int jobId, int sensorId, const QVector<QPair<QDateTime, double>> &measurements,
+                                        const MeasurementHandler::Statistics &stats, bool stale) {
+    if (jobId != currentJobId || !running) {
+        return;
+    }
+    running = false;
+    emit finished(sensorId, measurements, stats, stale);
+}
+
+/**
+ * @brief Etapy zadania wykonywane w wątku roboczym.
+ *
+ * Dekoduje odpowiedź (`MeasurementDecoder`), oblicza statystyki serii, przekazuje wyniki do wątku obiektu
+ * i dopiero wtedy zapisuje poprawny dokument na dysku. Znacznik anulowania jest sprawdzany przed każdym
+ * etapem przeznaczonym tylko do wyświetlenia; dekodowanie (sprawdzenie poprawności) i zapis są wykonywane zawsze,
+ * z wyjątkiem zapisu nieświeżej odpowiedzi z pamięci podręcznej (nie jest to nowy stan danych).
+ *
+ * @param jobId Identyfikator zadania (0 dla odpowiedzi spoza bieżącego zadania).
+ * @param sensorId Identyfikator czujnika.
+ * @param data Odpowiedź API.
+ * @param stale Wartość true, jeśli odpowiedź jest nieświeżą odpowiedzią z pamięci podręcznej.
+ * @param cancellation Znacznik anulowania zadania.
+ */
+void MeasurementPipeline::run(int jobId, int sensorId, const QString &data, bool stale, const TaskExecutor::CancellationToken &cancellation) {
+    MJP_TRACE_SCOPE_ID("MeasurementPipeline::run", jobId);
+    const QByteArray bytes = data.toUtf8();
+    MeasurementDecoder::Series measurements;
+    const bool valid = MeasurementDecoder::decode(bytes, &measurements).valid;
+
+    if (!cancellation.isCancelled()) {
+        MeasurementHandler::Statistics stats;
+        if (!measurements.isEmpty()) {
+            stats = MeasurementHandler::computeStatistics(measurements);
+        }
+        if (!cancellation.isCancelled()) {
+            QMetaObject::invokeMethod(this, [this, jobId, sensorId, measurements, stats, stale]() {
+                onJobFinished(jobId, sensorId, measurements, stats, stale);
+            }, Qt::QueuedConnection);
+        }
+    }
+
+    if (valid && !stale) {
+        DataManager::saveHistoricalData("measurements", bytes, sensorId);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+/**
+ * @file measurementpipeline.h
+ * @brief Definicja klasy MeasurementPipeline - potoku pobierania, dekodowania, zapisu i wyświetlania pomiarów czujnika.
+ */
+
+#ifndef MEASUREMENTPIPELINE_H
+#define MEASUREMENTPIPELINE_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QVector>
+#include <QPair>
+#include "apiclient.h"
+#include "measurementhandler.h"
+#include "taskexecutor.h"
+
+class MeasurementPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy MeasurementPipeline.
+     *
+     * @param apiClient Wskaźnik na klienta API, przez którego pobierane są pomiary.
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit MeasurementPipeline(ApiClient *apiClient, QObject *parent = nullptr);
+
+    /**
+     * @brief Destruktor klasy MeasurementPipeline.
+     *
+     * Anuluje bieżące zadanie i czeka na zakończenie jego zadań we wspólnej puli wątków (także zapisu danych).
+     */
+    ~MeasurementPipeline();
+
+    /**
+     * @brief Rozpoczyna zadanie dla czujnika: pobranie, dekodowanie i statystyki w tle, zapis i przekazanie wyników.
+     *
+     * Anuluje poprzednie zadanie - jego wyniki nie zostaną przekazane.
+     *
+     * @param sensorId Identyfikator czujnika.
+     * @return int Identyfikator zadania.
+     */
+    int load(int sensorId);
+
+    /**
+     * @brief Anuluje bieżące zadanie (jeśli jest w toku), łącznie z żądaniem sieciowym.
+     */
+    void cancel();
+
+    /**
+     * @brief Sprawdza, czy zadanie jest w toku.
+     *
+     * @return bool Wartość true, jeśli wyniki bieżącego zadania nie zostały jeszcze przekazane.
+     */
+    bool isRunning() const;
+
+signals:
+    /**
+     * @brief Sygnał emitowany w wątku obiektu po zdekodowaniu pomiarów bieżącego zadania.
+     *
+     * @param sensorId Identyfikator czujnika.
+     * @param measurements Pomiary w kolejności z odpowiedzi API; pusty wektor oznacza niepoprawne lub puste dane.
+     * @param stats Statystyki serii obliczone w tle.
+     * @param stale Wartość true, jeśli pomiary pochodzą z nieświeżej odpowiedzi z pamięci podręcznej (API niedostępne).
+     */
+    void finished(int sensorId, const QVector<QPair<QDateTime, double>> &measurements, const MeasurementHandler::Statistics &stats,
+                  bool stale);
+
+private:
+    void onDataReady(const QString &data, ApiClient::RequestKind kind, int entityId, bool stale);
+    void onErrorOccurred(ApiClient::RequestKind kind, int entityId);
+    void onJobFinished(int jobId, int sensorId, const QVector<QPair<QDateTime, double>> &measurements, const MeasurementHandler::Statistics &stats,
+                       bool stale);
+    void run(int jobId, int sensorId, const QString &data, bool stale, const TaskExecutor::CancellationToken &cancellation);
+
+    ApiClient *apiClient;
+    TaskExecutor::TaskGroup tasks;
+    int currentJobId;
+    int currentSensorId;
+    bool running;
+    TaskExecutor::CancellationToken currentCancellation;
+};
+
+#endif
\ No newline at end of file
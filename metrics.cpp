@@ -0,0 +1,319 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementacja klasy Metrics - rejestru liczników, wskaźników i histogramów czasu działania.
+ */
+
+#include "metrics.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/** Kwantyle eksportowane dla histogramów. */
+const double exportedQuantiles[] = {0.5, 0.9, 0.99};
+
+/**
+ * @brief Zarejestrowana metryka; dokładnie jeden ze wskaźników na wartość jest ustawiony.
+ */
+struct Entry {
+    QString name;
+    QString help;
+    QString labels;
+    Metrics::Type type = Metrics::CounterType;
+    std::unique_ptr<Metrics::Counter> counter;
+    std::unique_ptr<Metrics::Gauge> gauge;
+    std::unique_ptr<Metrics::Histogram> histogram;
+};
+
+struct Registry {
+    QMutex mutex;
+    std::vector<std::unique_ptr<Entry>> entries;
+    QHash<QString, Entry *> byKey;
+    std::vector<std::function<void()>> collectors;
+};
+
+Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+Entry &find(const QString &name, const QString &help, const QString &labels, Metrics::Type type) {
+    Registry &r = registry();
+    QMutexLocker locker(&r.mutex);
+    const QString key = name + '{' + labels + '}';
+    auto it = r.byKey.constFind(key);
+    if (it != r.byKey.constEnd()) {
+        Q_ASSERT(it.value()->type == type);
+        return *it.value();
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->labels = labels;
+    entry->type = type;
+    switch (type) {
+    case Metrics::CounterType:
+        entry->counter = std::make_unique<Metrics::Counter>();
+        break;
+    case Metrics::GaugeType:
+        entry->gauge = std::make_unique<Metrics::Gauge>();
+        break;
+    case Metrics::HistogramType:
+        entry->histogram = std::make_unique<Metrics::Histogram>();
+        break;
+    }
+    r.byKey.insert(key, entry.get());
+    r.entries.push_back(std::move(entry));
+    return *r.entries.back();
+}
+
+void runCollectors() {
+    std::vector<std::function<void()>> collectors;
+    {
+        QMutexLocker locker(&registry().mutex);
+        collectors = registry().collectors;
+    }
+    for (const auto &collector : collectors) {
+        collector();
+    }
+}
+
+QString withLabel(const QString &labels, const QString &extra) {
+    if (labels.isEmpty()) {
+        return extra;
+    }
+    return extra.isEmpty() ? labels : labels + ',' + extra;
+}
+
+QByteArray sampleLine(const QString &name, const QString &labels, double value) {
+    QByteArray line = name.toUtf8();
+    if (!labels.isEmpty()) {
+        line += '{' + labels.toUtf8() + '}';
+    }
+    line += ' ' + QByteArray::number(value, 'g', 15) + '\n';
+    return line;
+}
+
+}
+
+/**
+ * @brief Zapisuje wartość w histogramie (wartości ujemne są traktowane jak 0).
+ *
+ * @param value Wartość (np. czas w milisekundach lub mikrosekundach).
+ */
+void Metrics::Histogram::record(qint64 value) {
+    value = qMax<qint64>(0, value);
+    buckets[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    valueSum.fetch_add(value, std::memory_order_relaxed);
+
+    qint64 previous = maxValue.load(std::memory_order_relaxed);
+    while (value > previous && !maxValue.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Zwraca przybliżony kwantyl zapisanych wartości.
+ *
+ * Przechodzi przez przedziały, sumując ich liczności, aż do przedziału zawierającego kwantyl; wynik
+ * nie przekracza największej zapisanej wartości.
+ *
+ * @param quantile Kwantyl (0..1).
+ * @return qint64 Górna granica przedziału zawierającego kwantyl (0, jeśli histogram jest pusty).
+ */
+qint64 Metrics::Histogram::percentile(double quantile) const {
+    const quint64 n = count();
+    if (n == 0) {
+        return 0;
+    }
+    const quint64 target = qMax<quint64>(1, static_cast<quint64>(std::ceil(qBound(0.0, quantile, 1.0) * n)));
+    quint64 seen = 0;
+    for (int bucket = 0; bucket < BucketCount; ++bucket) {
+        seen += buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return qMin(upperBound(bucket), maxValue.load(std::memory_order_relaxed));
+        }
+    }
+    return maxValue.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca numer przedziału wartości.
+ *
+ * Wartości 0..7 mają własne przedziały; dla większych wartości o najstarszym bicie na pozycji `e`
+ * przedział wyznaczają trzy kolejne bity (8 przedziałów na każdą potęgę dwójki).
+ *
+ * @param value Wartość nieujemna.
+ * @return int Numer przedziału.
+ */
+int Metrics::Histogram::bucketFor(qint64 value) {
+    if (value < SubBuckets) {
+        return static_cast<int>(value);
+    }
+    const int exponent = 63 - qCountLeadingZeroBits(static_cast<quint64>(value));
+    const int shift = exponent - SubBucketBits;
+    return (shift + 1) * SubBuckets + static_cast<int>((value >> shift) - SubBuckets);
+}
+
+/**
+ * @brief Zwraca największą wartość należącą do przedziału.
+ *
+ * @param bucket Numer przedziału.
+ * @return qint64 Górna granica przedziału.
+ */
+qint64 Metrics::Histogram::upperBound(int bucket) {
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+    const int shift = bucket / SubBuckets - 1;
+    const qint64 lower = static_cast<qint64>(SubBuckets + bucket % SubBuckets) << shift;
+    return lower + (qint64(1) << shift) - 1;
+}
+
+/**
+ * @brief Zwraca (rejestrując przy pierwszym użyciu) licznik o podanej nazwie i etykietach.
+ *
+ * @param name Nazwa metryki.
+ * @param help Opis metryki.
+ * @param labels Etykiety w formacie Prometheus.
+ * @return Counter& Licznik.
+ */
+Metrics::Counter &Metrics::counter(const QString &name, const QString &help, const QString &labels) {
+    return *find(name, help, labels, CounterType).counter;
+}
+
+/**
+ * @brief Zwraca (rejestrując przy pierwszym użyciu) wskaźnik o podanej nazwie i etykietach.
+ *
+ * @param name Nazwa metryki.
+ * @param help Opis metryki.
+ * @param labels Etykiety w formacie Prometheus.
+ * @return Gauge& Wskaźnik.
+ */
+Metrics::Gauge &Metrics::gauge(const QString &name, const QString &help, const QString &labels) {
+    return *find(name, help, labels, GaugeType).gauge;
+}
+
+/**
+ * @brief Zwraca (rejestrując przy pierwszym użyciu) histogram o podanej nazwie i etykietach.
+ *
+ * @param name Nazwa metryki.
+ * @param help Opis metryki.
+ * @param labels Etykiety w formacie Prometheus.
+ * @return Histogram& Histogram.
+ */
+Metrics::Histogram &Metrics::histogram(const QString &name, const QString &help, const QString &labels) {
+    return *find(name, help, labels, HistogramType).histogram;
+}
+
+/**
+ * @brief Tworzy etykietę w formacie Prometheus z zakodowanymi znakami `\`, `"` i końca wiersza.
+ *
+ * @param key Nazwa etykiety.
+ * @param value Wartość etykiety.
+ * @return QString Etykieta `klucz="wartość"`.
+ */
+QString Metrics::label(const QString &key, const QString &value) {
+    QString escaped = value;
+    escaped.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+    return key + "=\"" + escaped + '"';
+}
+
+/**
+ * @brief Rejestruje funkcję aktualizującą metryki wyliczane na żądanie.
+ *
+ * @param collector Funkcja aktualizująca metryki.
+ */
+void Metrics::addCollector(std::function<void()> collector) {
+    QMutexLocker locker(&registry().mutex);
+    registry().collectors.push_back(std::move(collector));
+}
+
+/**
+ * @brief Zwraca wszystkie metryki w formacie tekstowym Prometheus.
+ *
+ * Metryki o tej samej nazwie (różniące się etykietami) są grupowane pod jednym nagłówkiem HELP/TYPE.
+ *
+ * @return QByteArray Treść odpowiedzi punktu końcowego `/metrics`.
+ */
+QByteArray Metrics::prometheusText() {
+    const QVector<Sample> samples = snapshot();
+    QByteArray text;
+    QString currentName;
+
+    for (const Sample &sample : samples) {
+        if (sample.name != currentName) {
+            currentName = sample.name;
+            const char *type = sample.type == CounterType ? "counter" : sample.type == GaugeType ? "gauge" : "summary";
+            text += "# HELP " + sample.name.toUtf8() + ' ' + sample.help.toUtf8() + '\n';
+            text += "# TYPE " + sample.name.toUtf8() + ' ' + type + '\n';
+        }
+        if (sample.type != HistogramType) {
+            text += sampleLine(sample.name, sample.labels, sample.value);
+            continue;
+        }
+        const qint64 quantiles[] = {sample.p50, sample.p90, sample.p99};
+        for (int i = 0; i < 3; ++i) {
+            const QString quantile = QString("quantile=\"%1\"").arg(exportedQuantiles[i]);
+            text += sampleLine(sample.name, withLabel(sample.labels, quantile), quantiles[i]);
+        }
+        text += sampleLine(sample.name + "_sum", sample.labels, sample.sum);
+        text += sampleLine(sample.name + "_count", sample.labels, sample.value);
+    }
+    return text;
+}
+
+/**
+ * @brief Zwraca migawkę wszystkich metryk.
+ *
+ * Najpierw wywołuje zarejestrowane funkcje aktualizujące, a następnie odczytuje wartości; metryki o tej
+ * samej nazwie występują obok siebie (w kolejności rejestracji pierwszej z nich).
+ *
+ * @return QVector<Sample> Migawki metryk.
+ */
+QVector<Metrics::Sample> Metrics::snapshot() {
+    runCollectors();
+
+    QVector<Sample> samples;
+    Registry &r = registry();
+    QMutexLocker locker(&r.mutex);
+    QVector<QString> order;
+    QHash<QString, QVector<const Entry *>> byName;
+    for (const auto &entry : r.entries) {
+        if (!byName.contains(entry->name)) {
+            order.append(entry->name);
+        }
+        byName[entry->name].append(entry.get());
+    }
+
+    for (const QString &name : std::as_const(order)) {
+        for (const Entry *entry : byName.value(name)) {
+            Sample sample;
+            sample.name = entry->name;
+            sample.labels = entry->labels;
+            sample.help = entry->help;
+            sample.type = entry->type;
+            if (entry->counter) {
+                sample.value = static_cast<double>(entry->counter->value());
+            } else if (entry->gauge) {
+                sample.value = static_cast<double>(entry->gauge->value());
+            } else {
+                sample.value = static_cast<double>(entry->histogram->count());
+                sample.sum = static_cast<double>(entry->histogram->sum());
+                sample.p50 = entry->histogram->percentile(0.5);
+                sample.p90 = entry->histogram->percentile(0.9);
+                sample.p99 = entry->histogram->percentile(0.99);
+            }
+            samples.append(sample);
+        }
+    }
+    return samples;
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+/**
+ * @file metrics.h
+ * @brief Definicja klasy Metrics - rejestru liczników, wskaźników i histogramów czasu działania.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <functional>
+
+class Metrics
+{
+public:
+    /**
+     * @brief Licznik rosnący (np. liczba żądań, pobrane bajty).
+     */
+    class Counter
+    {
+    public:
+        void add(quint64 amount = 1) { count.fetch_add(amount, std::memory_order_relaxed); }
+        quint64 value() const { return count.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<quint64> count{0};
+    };
+
+    /**
+     * @brief Wskaźnik - wartość, która może rosnąć i maleć (np. głębokość kolejki).
+     */
+    class Gauge
+    {
+    public:
+        void set(qint64 value) { current.store(value, std::memory_order_relaxed); }
+        void add(qint64 amount) { current.fetch_add(amount, std::memory_order_relaxed); }
+        qint64 value() const { return current.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<qint64> current{0};
+    };
+
+    /**
+     * @brief Histogram o przedziałach logarytmiczno-liniowych (jak HdrHistogram).
+     *
+     * Każda potęga dwójki jest dzielona na 8 równych przedziałów, więc kwantyle mają błąd względny
+     * najwyżej 12,5% w całym zakresie wartości nieujemnych, przy stałej pamięci (ok. 4 KB) i zapisie
+     * bez blokad (jedna operacja atomowa na przedział, licznik i sumę).
+     */
+    class Histogram
+    {
+    public:
+        void record(qint64 value);
+        quint64 count() const { return total.load(std::memory_order_relaxed); }
+        qint64 sum() const { return valueSum.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Zwraca przybliżony kwantyl zapisanych wartości.
+         *
+         * @param quantile Kwantyl (0..1), np. 0.99.
+         * @return qint64 Górna granica przedziału zawierającego kwantyl (0, jeśli histogram jest pusty).
+         */
+        qint64 percentile(double quantile) const;
+
+    private:
+        static constexpr int SubBucketBits = 3;
+        static constexpr int SubBuckets = 1 << SubBucketBits;
+        static constexpr int BucketCount = (64 - SubBucketBits) * SubBuckets;
+
+        static int bucketFor(qint64 value);
+        static qint64 upperBound(int bucket);
+
+        std::atomic<quint64> buckets[BucketCount] = {};
+        std::atomic<quint64> total{0};
+        std::atomic<qint64> valueSum{0};
+        std::atomic<qint64> maxValue{0};
+    };
+
+    enum Type {
+        CounterType,
+        GaugeType,
+        HistogramType
+    };
+
+    /**
+     * @brief Migawka jednej metryki (do panelu diagnostycznego).
+     *
+     * Dla liczników i wskaźników `value` to bieżąca wartość; dla histogramów `value` to liczba pomiarów,
+     * a `sum`, `p50`, `p90` i `p99` - suma i kwantyle.
+     */
+    struct Sample {
+        QString name;
+        QString labels;
+        QString help;
+        Type type = CounterType;
+        double value = 0.0;
+        double sum = 0.0;
+        qint64 p50 = 0;
+        qint64 p90 = 0;
+        qint64 p99 = 0;
+    };
+
+    /**
+     * @brief Zwraca (rejestrując przy pierwszym użyciu) licznik o podanej nazwie i etykietach.
+     *
+     * Wyszukanie metryki wymaga blokady, więc w często wykonywanym kodzie należy zapamiętać referencję
+     * (np. w zmiennej statycznej); sama aktualizacja wartości nie blokuje. Metryki nie są nigdy usuwane,
+     * więc referencja pozostaje ważna do końca działania programu.
+     *
+     * @param name Nazwa metryki w formacie Prometheus (np. "mjp_http_downloaded_bytes_total").
+     * @param help Opis metryki.
+     * @param labels Etykiety w formacie Prometheus (np. utworzone przez `label`), domyślnie brak.
+     * @return Counter& Licznik.
+     */
+    static Counter &counter(const QString &name, const QString &help, const QString &labels = QString());
+
+    /**
+     * @brief Zwraca (rejestrując przy pierwszym użyciu) wskaźnik o podanej nazwie i etykietach.
+     *
+     * @param name Nazwa metryki.
+     * @param help Opis metryki.
+     * @param labels Etykiety w formacie Prometheus, domyślnie brak.
+     * @return Gauge& Wskaźnik.
+     */
+    static Gauge &gauge(const QString &name, const QString &help, const QString &labels = QString());
+
+    /**
+     * @brief Zwraca (rejestrując przy pierwszym użyciu) histogram o podanej nazwie i etykietach.
+     *
+     * @param name Nazwa metryki (z jednostką, np. "mjp_parse_duration_microseconds").
+     * @param help Opis metryki.
+     * @param labels Etykiety w formacie Prometheus, domyślnie brak.
+     * @return Histogram& Histogram.
+     */
+    static Histogram &histogram(const QString &name, const QString &help, const QString &labels = QString());
+
+    /**
+     * @brief Tworzy etykietę w formacie Prometheus (`klucz="wartość"`) z poprawnie zakodowaną wartością.
+     *
+     * @param key Nazwa etykiety.
+     * @param value Wartość etykiety.
+     * @return QString Etykieta.
+     */
+    static QString label(const QString &key, const QString &value);
+
+    /**
+     * @brief Rejestruje funkcję aktualizującą metryki wyliczane na żądanie (np. rozmiar magazynu danych).
+     *
+     * Funkcje są wywoływane przed każdym odczytem (`prometheusText`, `snapshot`).
+     *
+     * @param collector Funkcja aktualizująca metryki.
+     */
+    static void addCollector(std::function<void()> collector);
+
+    /**
+     * @brief Zwraca wszystkie metryki w formacie tekstowym Prometheus (wersja 0.0.4).
+     *
+     * Histogramy są eksportowane jako typ `summary` (kwantyle 0.5, 0.9, 0.99 oraz `_sum` i `_count`).
+     *
+     * @return QByteArray Treść odpowiedzi punktu końcowego `/metrics`.
+     */
+    static QByteArray prometheusText();
+
+    /**
+     * @brief Zwraca migawkę wszystkich metryk, w kolejności rejestracji.
+     *
+     * @return QVector<Sample> Migawki metryk.
+     */
+    static QVector<Sample> snapshot();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+/**
+ * @file giosmock.cpp
+ * @brief Implementacja klasy GiosMock - lokalnej atrapy API GIOS z regulowanym opóźnieniem, błędami i limitem żądań.
+ */
+
+#include "giosmock.h"
+#include "syntheticgiosdata.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+/**
+ * @brief Konstruktor klasy GiosMock.
+ *
+ * Generuje z góry listę stacji (jest niezmienna), a listy czujników i serie pomiarów generuje przy
+ * żądaniu. Rejestruje obsługę wszystkich ścieżek zaczynających się od `basePath`.
+ *
+ * @param options Ustawienia atrapy.
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+GiosMock::GiosMock(const Options &options, QObject *parent)
+    : QObject(parent)
+    , options(options)
+    , random(options.seed)
+    , stations(SyntheticGiosData::stationsJson(options.stationCount, options.seed))
+    , tokens(options.rateLimit)
+    , lastRefill(0)
+{
+    clock.start();
+    server.route(options.basePath, [this](const HttpServer::Request &request) { return handle(request); });
+}
+
+/**
+ * @brief Rozpoczyna nasłuchiwanie.
+ *
+ * @param address Adres, na którym serwer nasłuchuje.
+ * @param port Port; 0 oznacza dowolny wolny port.
+ * @return bool Wartość true, jeśli serwer nasłuchuje.
+ */
+bool GiosMock::listen(const QHostAddress &address, quint16 port) {
+    this->address = address;
+    return server.listen(address, port);
+}
+
+/**
+ * @brief Zwraca adres bazowy API atrapy (do opcji `--api-url` aplikacji).
+ */
+QString GiosMock::baseUrl() const {
+    return QString("http://%1:%2%3").arg(address.toString()).arg(server.port()).arg(options.basePath);
+}
+
+/**
+ * @brief Zwraca opis ostatniego błędu serwera.
+ */
+QString GiosMock::errorString() const {
+    return server.errorString();
+}
+
+/**
+ * @brief Obsługuje żądanie punktu końcowego API.
+ *
+ * Kolejno: limit żądań (429 z Retry-After), losowy błąd serwera (503), a następnie odpowiedź
+ * `station/findAll`, `station/sensors/<id>`, `data/getData/<id>` lub stronicowanego
+ * `archivalData/getDataBySensor/<id>` (parametry `dateFrom`, `dateTo`, `page`, `size`). Czujniki kolejnych stacji
+ * są numerowane jednym licznikiem od 1 (stacja s ma czujniki `(s - 1) * sensorsPerStation + 1` i następne), więc
+ * czujnik istnieje, jeśli `id` nie przekracza łącznej liczby czujników.
+ * Każda odpowiedź ma opóźnienie `latencyMs` powiększone o losowe 0..`jitterMs`.
+ *
+ * @param request Żądanie HTTP.
+ * @return HttpServer::Response Odpowiedź.
+ */
+HttpServer::Response GiosMock::handle(const HttpServer::Request &request) {
+    const int delay = options.latencyMs + (options.jitterMs > 0 ? random.bounded(options.jitterMs + 1) : 0);
+    const QString path = request.path.mid(options.basePath.size());
+    const QStringList segments = path.split('/', Qt::SkipEmptyParts);
+    bool ok = false;
+    const int id = segments.size() == 3 ? segments.at(2).toInt(&ok) : -1;
+    const bool sensorExists = id >= 1 && static_cast<qint64>(id) <= static_cast<qint64>(options.stationCount) * options.sensorsPerStation;
+    HttpServer::Response response;
+
+    if (!takeToken()) {
+        response.status = 429;
+        response.headers.append(qMakePair(QByteArray("Retry-After"), QByteArray("1")));
+    } else if (options.errorRate > 0 && random.generateDouble() < options.errorRate) {
+        response.status = 503;
+    } else if (path == "station/findAll") {
+        response = withBody(request, stations);
+    } else if (ok && segments.at(0) == "station" && segments.at(1) == "sensors" && id >= 1 && id <= options.stationCount) {
+        auto it = sensors.find(id);
+        if (it == sensors.end()) {
+            it = sensors.insert(id, SyntheticGiosData::sensorsJson(id, options.sensorsPerStation, (id - 1) * options.sensorsPerStation + 1));
+        }
+        response = withBody(request, it.value());
+    } else if (ok && segments.at(0) == "data" && segments.at(1) == "getData" && sensorExists) {
+        response = withBody(request, SyntheticGiosData::measurementsJson(id, options.hours, QDateTime::currentDateTime(), options.seed));
+    } else if (ok && segments.at(0) == "archivalData" && segments.at(1) == "getDataBySensor" && sensorExists) {
+        response = archivalPage(request, id);
+    } else {
+        response.status = 404;
+    }
+    response.delayMs = delay;
+    return response;
+}
+
+/**
+ * @brief Tworzy stronę archiwalnych danych pomiarowych czujnika.
+ *
+ * Pomiary godzinowe z zakresu `dateFrom`..`dateTo` (od najnowszego) są dzielone na strony po `size`
+ * (domyślnie 500) pozycji; odpowiedź zawiera stronę `page` i łączną liczbę stron (`totalPages`).
+ *
+ * @param request Żądanie HTTP.
+ * @param sensorId Identyfikator czujnika.
+ * @return HttpServer::Response Odpowiedź 200, 304 lub 400 (niepoprawny zakres dat).
+ */
+HttpServer::Response GiosMock::archivalPage(const HttpServer::Request &request, int sensorId) {
+    const QDateTime from = QDateTime::fromString(request.query.queryItemValue("dateFrom", QUrl::FullyDecoded), "yyyy-MM-dd HH:mm");
+    const QDateTime to = QDateTime::fromString(request.query.queryItemValue("dateTo", QUrl::FullyDecoded), "yyyy-MM-dd HH:mm");
+    const int page = qMax(0, request.query.queryItemValue("page").toInt());
+    int size = request.query.queryItemValue("size").toInt();
+    if (size <= 0) {
+        size = 500;
+    }
+    if (!from.isValid() || !to.isValid() || to < from) {
+        HttpServer::Response response;
+        response.status = 400;
+        return response;
+    }
+
+    const int hours = static_cast<int>(from.secsTo(to) / 3600) + 1;
+    const QJsonObject all = QJsonDocument::fromJson(SyntheticGiosData::measurementsJson(sensorId, hours, to, options.seed)).object();
+    const QJsonArray values = all["values"].toArray();
+    QJsonArray pageValues;
+    for (int i = page * size; i < qMin(values.size(), (page + 1) * size); ++i) {
+        pageValues.append(values.at(i));
+    }
+
+    QJsonObject data;
+    data["key"] = all["key"];
+    data["values"] = pageValues;
+    data["totalPages"] = (values.size() + size - 1) / size;
+    return withBody(request, QJsonDocument(data).toJson(QJsonDocument::Compact));
+}
+
+/**
+ * @brief Tworzy odpowiedź z treścią i nagłówkiem ETag; na żądanie warunkowe z tym samym ETag zwraca 304.
+ *
+ * @param request Żądanie HTTP.
+ * @param body Treść odpowiedzi.
+ * @return HttpServer::Response Odpowiedź 200 lub 304.
+ */
+HttpServer::Response GiosMock::withBody(const HttpServer::Request &request, const QByteArray &body) {
+    HttpServer::Response response;
+    const QByteArray etag = '"' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex().left(16) + '"';
+    response.headers.append(qMakePair(QByteArray("ETag"), etag));
+    if (request.headers.value("if-none-match") == etag) {
+        response.status = 304;
+    } else {
+        response.body = body;
+    }
+    return response;
+}
+
+/**
+ * @brief Pobiera żeton z kubełka limitu żądań (pojemność i szybkość uzupełniania - `rateLimit` na sekundę).
+ *
+ * @return bool Wartość true, jeśli żądanie mieści się w limicie (lub limit jest wyłączony).
+ */
+bool GiosMock::takeToken() {
+    if (options.rateLimit <= 0) {
+        return true;
+    }
+    const qint64 now = clock.elapsed();
+    tokens = qMin(options.rateLimit, tokens + (now - lastRefill) * options.rateLimit / 1000.0);
+    lastRefill = now;
+    if (tokens < 1.0) {
+        return false;
+    }
+    tokens -= 1.0;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+/**
+ * @file giosmock.h
+ * @brief Definicja klasy GiosMock - lokalnej atrapy API GIOS z regulowanym opóźnieniem, błędami i limitem żądań.
+ */
+
+#ifndef GIOSMOCK_H
+#define GIOSMOCK_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QRandomGenerator>
+#include "httpserver.h"
+
+class GiosMock : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Ustawienia atrapy.
+     *
+     * `latencyMs` i `jitterMs` - opóźnienie odpowiedzi (stałe i losowe), `errorRate` - udział odpowiedzi 503
+     * (0..1), `rateLimit` - liczba żądań na sekundę, powyżej której serwer odpowiada 429 z nagłówkiem
+     * Retry-After (0 wyłącza limit), `basePath` - ścieżka, pod którą dostępne są punkty końcowe API.
+     */
+    struct Options {
+        int stationCount = 300;
+        int sensorsPerStation = 6;
+        int hours = 72;
+        int latencyMs = 0;
+        int jitterMs = 0;
+        double errorRate = 0.0;
+        double rateLimit = 0.0;
+        quint32 seed = 2025;
+        QString basePath = "/pjp-api/rest/";
+    };
+
+    /**
+     * @brief Konstruktor klasy GiosMock.
+     *
+     * @param options Ustawienia atrapy.
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit GiosMock(const Options &options, QObject *parent = nullptr);
+
+    /**
+     * @brief Rozpoczyna nasłuchiwanie.
+     *
+     * @param address Adres, na którym serwer nasłuchuje.
+     * @param port Port; 0 oznacza dowolny wolny port.
+     * @return bool Wartość true, jeśli serwer nasłuchuje.
+     */
+    bool listen(const QHostAddress &address, quint16 port);
+
+    /**
+     * @brief Zwraca adres bazowy API atrapy (do opcji `--api-url` aplikacji).
+     */
+    QString baseUrl() const;
+
+    /**
+     * @brief Zwraca opis ostatniego błędu serwera.
+     */
+    QString errorString() const;
+
+private:
+    HttpServer::Response handle(const HttpServer::Request &request);
+    HttpServer::Response archivalPage(const HttpServer::Request &request, int sensorId);
+    HttpServer::Response withBody(const HttpServer::Request &request, const QByteArray &body);
+    bool takeToken();
+
+    Options options;
+    HttpServer server;
+    QHostAddress address;
+    QRandomGenerator random;
+    QByteArray stations;
+    QHash<int, QByteArray> sensors;
+    QElapsedTimer clock;
+    double tokens;
+    qint64 lastRefill;
+};
+
+#endif
\ No newline at end of file
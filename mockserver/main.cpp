@@ -0,0 +1,55 @@
+/**
+ * @file main.cpp
+ * @brief Plik główny lokalnej atrapy API GIOS.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QtDebug>
+#include "giosmock.h"
+
+/**
+ * @brief Główna funkcja atrapy API GIOS.
+ *
+ * Odczytuje ustawienia z wiersza poleceń, uruchamia serwer i wypisuje adres bazowy API do przekazania
+ * aplikacji (`MJP --api-url <adres>`) lub benchmarkom.
+ *
+ * @param argc Liczba argumentów wiersza poleceń.
+ * @param argv Tablica argumentów wiersza poleceń.
+ * @return int Kod wyjścia (0 oznacza sukces).
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Lokalna atrapa API GIOS z syntetycznymi danymi.");
+    parser.addHelpOption();
+    parser.addOption({"port", "Port (domyślnie 8080, 0 - dowolny wolny).", "port", "8080"});
+    parser.addOption({"stations", "Liczba stacji (domyślnie 300).", "liczba", "300"});
+    parser.addOption({"sensors", "Liczba czujników na stację (domyślnie 6).", "liczba", "6"});
+    parser.addOption({"hours", "Liczba godzin w serii pomiarów (domyślnie 72).", "liczba", "72"});
+    parser.addOption({"latency", "Opóźnienie odpowiedzi w ms (domyślnie 0).", "ms", "0"});
+    parser.addOption({"jitter", "Dodatkowe losowe opóźnienie odpowiedzi w ms (domyślnie 0).", "ms", "0"});
+    parser.addOption({"error-rate", "Udział odpowiedzi 503, 0..1 (domyślnie 0).", "udział", "0"});
+    parser.addOption({"rate-limit", "Limit żądań na sekundę, powyżej odpowiedź 429 (domyślnie 0 - bez limitu).", "liczba", "0"});
+    parser.addOption({"seed", "Ziarno generatora danych (domyślnie 2025).", "liczba", "2025"});
+    parser.process(app);
+
+    GiosMock::Options options;
+    options.stationCount = qMax(0, parser.value("stations").toInt());
+    options.sensorsPerStation = qMax(0, parser.value("sensors").toInt());
+    options.hours = qMax(0, parser.value("hours").toInt());
+    options.latencyMs = qMax(0, parser.value("latency").toInt());
+    options.jitterMs = qMax(0, parser.value("jitter").toInt());
+    options.errorRate = qBound(0.0, parser.value("error-rate").toDouble(), 1.0);
+    options.rateLimit = qMax(0.0, parser.value("rate-limit").toDouble());
+    options.seed = parser.value("seed").toUInt();
+
+    GiosMock mock(options);
+    if (!mock.listen(QHostAddress::LocalHost, static_cast<quint16>(parser.value("port").toUInt()))) {
+        qCritical().noquote() << "Nie można uruchomić serwera:" << mock.errorString();
+        return 1;
+    }
+    qInfo().noquote() << "Atrapa API GIOS:" << mock.baseUrl();
+    return app.exec();
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+QT += core network
+QT -= gui
+TARGET = mjp_mockserver
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += .. ../benchmarks
+
+SOURCES += \
+    main.cpp \
+    giosmock.cpp \
+    ../benchmarks/syntheticgiosdata.cpp \
+    ../httpserver.cpp
+
+HEADERS += \
+    giosmock.h \
+    ../benchmarks/syntheticgiosdata.h \
+    ../httpserver.h
\ No newline at end of file
@@ -0,0 +1,196 @@
+/**
+ * @file prefetcher.cpp
+ * @brief Implementacja klasy Prefetcher - pobierania z wyprzedzeniem danych stacji i czujników podczas przeglądania list.
+ */
+
+#include "prefetcher.h"
+#include "apiclient.h"
+#include "apiendpoints.h"
+#include "metrics.h"
+
+#include <utility>
+
+namespace {
+
+/** Czas (ms), przez który podświetlenie musi pozostać na elemencie, zanim zostaną wysłane żądania (przytrzymana strzałka nie zleca żądań dla każdego mijanego wiersza). */
+constexpr int DwellInterval = 120;
+
+/** Maksymalna liczba żądań z wyprzedzeniem w toku. */
+constexpr int MaxPending = 4;
+
+/** Największa liczba żądań, które można zlecić naraz po okresie bezczynności. */
+constexpr double BudgetBurst = 8.0;
+
+/** Liczba żądań na sekundę, o którą odnawia się budżet. */
+constexpr double BudgetPerSecond = 1.0;
+
+/** Czas (ms), przez który pobrany adres nie jest pobierany ponownie (krótszy niż ważność odpowiedzi w `ResponseCache`). */
+constexpr qint64 RefetchInterval = 10 * 60 * 1000;
+
+/** Czas (ms), po którym adres, którego pobranie się nie powiodło, może być zlecony ponownie. */
+constexpr qint64 FailedRetryInterval = 30 * 1000;
+
+Metrics::Counter &prefetchRequests(const char *result) {
+    return Metrics::counter("mjp_prefetch_requests_total", "Żądania pobierania z wyprzedzeniem według wyniku (issued, cancelled, over_budget)",
+                            Metrics::label("result", result));
+}
+
+}
+
+/**
+ * @brief Konstruktor klasy Prefetcher.
+ *
+ * Konfiguruje jednorazowy licznik czasu podświetlenia i łączy sygnał `batchFinished` obiektu `ApiClient`
+ * z obsługą zakończenia żądań. Wyniki pakietów, których nie zlecił ten obiekt, są ignorowane.
+ *
+ * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+Prefetcher::Prefetcher(ApiClient *apiClient, QObject *parent)
+    : QObject(parent)
+    , apiClient(apiClient)
+    , sensorId(-1)
+    , budget(BudgetBurst)
+    , budgetUpdatedAt(0)
+{
+    clock.start();
+    dwellTimer.setSingleShot(true);
+    dwellTimer.setInterval(DwellInterval);
+    connect(&dwellTimer, &QTimer::timeout, this, &Prefetcher::issue);
+    connect(apiClient, &ApiClient::batchFinished, this, &Prefetcher::onBatchFinished);
+}
+
+/**
+ * @brief Ustawia stacje, których listy czujników należy pobrać z wyprzedzeniem.
+ *
+ * Żądania są zlecane dopiero po czasie `DwellInterval` bez zmiany podświetlenia.
+ *
+ * @param stationIds Identyfikatory stacji: najpierw podświetlona, potem sąsiednie.
+ */
+void Prefetcher::highlightStations(const QVector<int> &stationIds) {
+    this->stationIds = stationIds;
+    dwellTimer.start();
+}
+
+/**
+ * @brief Ustawia czujnik, którego dane pomiarowe należy pobrać z wyprzedzeniem.
+ *
+ * @param sensorId Identyfikator podświetlonego czujnika lub -1.
+ */
+void Prefetcher::highlightSensor(int sensorId) {
+    this->sensorId = sensorId;
+    dwellTimer.start();
+}
+
+/**
+ * @brief Anuluje wszystkie żądania z wyprzedzeniem i zapomina podświetlone elementy.
+ */
+void Prefetcher::clear() {
+    dwellTimer.stop();
+    stationIds.clear();
+    sensorId = -1;
+    issue();
+}
+
+/**
+ * @brief Dopasowuje żądania w toku do bieżących podświetleń.
+ *
+ * Adresy kolejno: dane pomiarowe podświetlonego czujnika, czujniki podświetlonej stacji i czujniki stacji
+ * sąsiednich. Żądania dla adresów spoza tej listy są anulowane (`ApiClient::cancelBatch`), a brakujące są
+ * zlecane jako jednoelementowe pakiety z priorytetem `RequestScheduler::Prefetch`, dopóki nie zostanie
+ * osiągnięty limit żądań w toku (`MaxPending`) lub wyczerpany budżet. Adresy pobrane w ciągu
+ * `RefetchInterval` są pomijane - ich odpowiedzi są w `ResponseCache`, więc potwierdzenie wyboru
+ * jest obsługiwane bez połączenia z serwerem - a adresy, których pobranie się nie powiodło, są pomijane
+ * przez `FailedRetryInterval`.
+ */
+void Prefetcher::issue() {
+    static Metrics::Counter &issued = prefetchRequests("issued");
+    static Metrics::Counter &cancelled = prefetchRequests("cancelled");
+    static Metrics::Counter &overBudget = prefetchRequests("over_budget");
+
+    QVector<QUrl> targets;
+    if (apiClient->isOnline()) {
+        if (sensorId != -1) {
+            targets.append(ApiEndpoints::measurements(sensorId));
+        }
+        for (int stationId : std::as_const(stationIds)) {
+            targets.append(ApiEndpoints::sensors(stationId));
+        }
+    }
+
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (!targets.contains(it.key())) {
+            apiClient->cancelBatch(it.value());
+            pendingByBatch.remove(it.value());
+            cancelled.add();
+            it = pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const qint64 now = clock.elapsed();
+    for (auto it = nextFetchAt.begin(); it != nextFetchAt.end();) {
+        if (now >= it.value()) {
+            it = nextFetchAt.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const QUrl &url : std::as_const(targets)) {
+        if (pending.size() >= MaxPending) {
+            break;
+        }
+        if (pending.contains(url) || nextFetchAt.contains(url)) {
+            continue;
+        }
+        if (!takeBudget()) {
+            overBudget.add();
+            break;
+        }
+        const int batchId = apiClient->fetchBatch(QVector<QUrl>{url}, RequestScheduler::Prefetch);
+        pending.insert(url, batchId);
+        pendingByBatch.insert(batchId, url);
+        issued.add();
+    }
+}
+
+/**
+ * @brief Obsługuje zakończenie żądania z wyprzedzeniem.
+ *
+ * Udanie pobrany adres nie jest pobierany ponownie przez `RefetchInterval`, a adres, którego pobranie się
+ * nie powiodło (np. po błędzie przejściowym), tylko przez krótszy `FailedRetryInterval`, więc pojedynczy błąd
+ * nie blokuje pobierania z wyprzedzeniem na długo. Jeśli podświetlenie się nie zmienia, zleca kolejne adresy
+ * w zwolnionym miejscu.
+ *
+ * @param batchId Identyfikator pakietu.
+ * @param failedCount Liczba żądań pakietu zakończonych błędem.
+ */
+void Prefetcher::onBatchFinished(int batchId, int failedCount) {
+    const QUrl url = pendingByBatch.take(batchId);
+    if (url.isEmpty()) {
+        return;
+    }
+    pending.remove(url);
+    nextFetchAt.insert(url, clock.elapsed() + (failedCount == 0 ? RefetchInterval : FailedRetryInterval));
+    if (!dwellTimer.isActive()) {
+        issue();
+    }
+}
+
+/**
+ * @brief Pobiera jedno żądanie z budżetu (kubełek żetonów odnawiany o `BudgetPerSecond` na sekundę).
+ *
+ * @return bool Wartość false, jeśli budżet jest wyczerpany.
+ */
+bool Prefetcher::takeBudget() {
+    const qint64 now = clock.elapsed();
+    budget = qMin(BudgetBurst, budget + (now - budgetUpdatedAt) * BudgetPerSecond / 1000.0);
+    budgetUpdatedAt = now;
+    if (budget < 1.0) {
+        return false;
+    }
+    budget -= 1.0;
+    return true;
+}
\ No newline at end of file
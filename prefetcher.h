@@ -0,0 +1,72 @@
+/**
+ * @file prefetcher.h
+ * @brief Definicja klasy Prefetcher - pobierania z wyprzedzeniem danych stacji i czujników podczas przeglądania list.
+ */
+
+#ifndef PREFETCHER_H
+#define PREFETCHER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+class ApiClient;
+
+class Prefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** Liczba stacji sąsiednich (powyżej i poniżej podświetlonej), których czujniki są pobierane z wyprzedzeniem. */
+    static constexpr int NeighborStations = 2;
+
+    /**
+     * @brief Konstruktor klasy Prefetcher.
+     *
+     * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit Prefetcher(ApiClient *apiClient, QObject *parent = nullptr);
+
+    /**
+     * @brief Ustawia stacje, których listy czujników należy pobrać z wyprzedzeniem.
+     *
+     * Zastępuje poprzednie stacje; żądania dla stacji, których nie ma na nowej liście, są anulowane.
+     *
+     * @param stationIds Identyfikatory stacji: najpierw podświetlona, potem sąsiednie (w kolejności ważności).
+     */
+    void highlightStations(const QVector<int> &stationIds);
+
+    /**
+     * @brief Ustawia czujnik, którego dane pomiarowe należy pobrać z wyprzedzeniem.
+     *
+     * @param sensorId Identyfikator podświetlonego czujnika lub -1 (brak).
+     */
+    void highlightSensor(int sensorId);
+
+    /**
+     * @brief Anuluje wszystkie żądania z wyprzedzeniem i zapomina podświetlone elementy (wywoływana przy przejściu w tryb offline).
+     */
+    void clear();
+
+private:
+    void issue();
+    void onBatchFinished(int batchId, int failedCount);
+    bool takeBudget();
+
+    ApiClient *apiClient;
+    QTimer dwellTimer;
+    QElapsedTimer clock;
+    QVector<int> stationIds;
+    int sensorId;
+    double budget;
+    qint64 budgetUpdatedAt;
+    QHash<QUrl, int> pending;
+    QHash<int, QUrl> pendingByBatch;
+    QHash<QUrl, qint64> nextFetchAt;
+};
+
+#endif
\ No newline at end of file
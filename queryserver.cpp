@@ -0,0 +1,546 @@
+/**
+ * @file queryserver.cpp
+ * @brief Implementacja klasy QueryServer - lokalnego serwera HTTP/JSON udostępniającego dane z magazynu aplikacji.
+ */
+
+#include "queryserver.h"
+#include "datamanager.h"
+#include "historyloader.h"
+#include "metrics.h"
+#include "taskexecutor.h"
+#include "tracing.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace {
+/** Prefiks ścieżek punktów końcowych serwera. */
+const char *const ApiPrefix = "/api/";
+/** Łączny rozmiar treści odpowiedzi w pamięci podręcznej (bajty). */
+constexpr int CacheCapacity = 32 * 1024 * 1024;
+/** Liczba pomiarów, powyżej której odpowiedź jest wysyłana strumieniowo (i nie trafia do pamięci podręcznej). */
+constexpr int StreamThreshold = 5000;
+/** Liczba pomiarów w jednej części odpowiedzi strumieniowej. */
+constexpr int StreamChunkSize = 1000;
+/** Format dat w odpowiedziach (taki sam jak w API GIOS). */
+const char *const DateFormat = "yyyy-MM-dd HH:mm:ss";
+/** Format znacznika czasu zapisu w nazwach plików pomiarów (`DataManager::saveHistoricalData`). */
+const char *const FileTimestampFormat = "yyyyMMdd_HHmmss";
+
+/** Licznik żądań danej trasy. */
+Metrics::Counter &routeRequests(const char *route) {
+    return Metrics::counter("mjp_query_requests_total", "Żądania lokalnego serwera zapytań", Metrics::label("route", route));
+}
+}
+
+/**
+ * @brief Scalanie pomiarów z kolejnych plików czujnika plik po pliku.
+ *
+ * Pliki są czytane od najstarszego; pomiar nowszego pliku zastępuje pomiar tej samej chwili z pliku starszego.
+ * Pomiary wcześniejsze niż najwcześniejszy pomiar ostatnio wczytanego pliku są przekazywane od razu (nowsze
+ * pliki obejmują późniejsze okresy), więc w pamięci pozostają pomiary co najwyżej dwóch plików, a nie całego
+ * zakresu. Pliki zapisane przed początkiem zakresu są pomijane bez odczytu - plik zapisany w chwili T nie
+ * zawiera pomiarów późniejszych niż T.
+ */
+class QueryServer::MeasurementCursor
+{
+public:
+    MeasurementCursor(const QStringList &files, const QDateTime &from, const QDateTime &to)
+        : from(from)
+        , to(to)
+    {
+        for (const QString &path : files) {
+            const QDateTime saved = fileTimestamp(path);
+            if (!from.isValid() || !saved.isValid() || saved >= from) {
+                this->files.append(path);
+            }
+        }
+    }
+
+    /**
+     * @brief Sprawdza, czy wszystkie pomiary zostały przekazane.
+     */
+    bool atEnd() const {
+        return next >= files.size() && pending.isEmpty();
+    }
+
+    /**
+     * @brief Wczytuje kolejny plik i dołącza do `points` pomiary, których nie zmieni żaden nowszy plik.
+     *
+     * @param points Wskaźnik na wektor, do którego dołączane są pomiary (w kolejności czasu).
+     */
+    void read(Measurements *points) {
+        QDateTime settled;
+        if (next < files.size()) {
+            QMap<QDateTime, double> fresh;
+            QFile file(files.at(next++));
+            if (file.open(QIODevice::ReadOnly)) {
+                HistoryLoader::appendMeasurements(file.readAll(), from, fresh);
+            }
+            if (fresh.isEmpty()) {
+                return;
+            }
+            settled = fresh.firstKey();
+            for (auto it = fresh.constBegin(); it != fresh.constEnd(); ++it) {
+                if ((!emittedUntil.isValid() || it.key() > emittedUntil) && (!to.isValid() || it.key() <= to)) {
+                    pending.insert(it.key(), it.value());
+                }
+            }
+        }
+        auto it = pending.begin();
+        while (it != pending.end() && (!settled.isValid() || it.key() < settled)) {
+            points->append(qMakePair(it.key(), it.value()));
+            emittedUntil = it.key();
+            it = pending.erase(it);
+        }
+    }
+
+private:
+    QStringList files;
+    QDateTime from;
+    QDateTime to;
+    int next = 0;
+    QMap<QDateTime, double> pending;
+    QDateTime emittedUntil;
+};
+
+/**
+ * @brief Konstruktor klasy QueryServer.
+ *
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject).
+ */
+QueryServer::QueryServer(QObject *parent)
+    : QObject(parent)
+    , cache(CacheCapacity)
+{
+    server.route(ApiPrefix, [this](const HttpServer::Request &request) { return handle(request); });
+}
+
+/**
+ * @brief Rozpoczyna nasłuchiwanie.
+ *
+ * @param address Adres, na którym serwer nasłuchuje.
+ * @param port Port; 0 oznacza dowolny wolny port.
+ * @return bool Wartość true, jeśli serwer nasłuchuje.
+ */
+bool QueryServer::listen(const QHostAddress &address, quint16 port) {
+    return server.listen(address, port);
+}
+
+/**
+ * @brief Zwraca port, na którym serwer nasłuchuje.
+ */
+quint16 QueryServer::port() const {
+    return server.port();
+}
+
+/**
+ * @brief Zwraca opis ostatniego błędu serwera.
+ */
+QString QueryServer::errorString() const {
+    return server.errorString();
+}
+
+/**
+ * @brief Rozpoznaje punkt końcowy żądania i zwraca jego odpowiedź.
+ *
+ * Dla każdego punktu końcowego wyznacza pliki magazynu danych, z których powstaje odpowiedź; ich stan
+ * (`storeFingerprint`) decyduje o ETag i ważności wpisu pamięci podręcznej (`respond`).
+ *
+ * @param request Żądanie HTTP.
+ * @return HttpServer::Response Odpowiedź JSON lub błąd 400/404.
+ */
+HttpServer::Response QueryServer::handle(const HttpServer::Request &request) {
+    MJP_TRACE_SCOPE("QueryServer::handle");
+    const QStringList parts = request.path.mid(int(qstrlen(ApiPrefix))).split('/', Qt::SkipEmptyParts);
+
+    if (parts == QStringList{"stations"}) {
+        static Metrics::Counter &requests = routeRequests("stations");
+        requests.add();
+        const QString path = DataManager::getDataFilePath("stations");
+        return respond(request, {path}, [path]() { return fileResponse(path); });
+    }
+
+    bool ok = false;
+    const int id = parts.value(1).toInt(&ok);
+    if (!ok || parts.size() != 3) {
+        return error(404, "Nieznany punkt końcowy");
+    }
+
+    if (parts.at(0) == "stations" && parts.at(2) == "sensors") {
+        static Metrics::Counter &requests = routeRequests("sensors");
+        requests.add();
+        const QString path = DataManager::getDataFilePath("sensors", id);
+        return respond(request, {path}, [path]() { return fileResponse(path); });
+    }
+    if (parts.at(0) != "sensors") {
+        return error(404, "Nieznany punkt końcowy");
+    }
+
+    const QStringList files = DataManager::historicalDataFiles("measurements", id);
+    if (files.isEmpty()) {
+        return error(404, "Brak danych czujnika");
+    }
+    if (parts.at(2) == "latest") {
+        static Metrics::Counter &requests = routeRequests("latest");
+        requests.add();
+        return respond(request, files, [id, files]() { return latest(id, files); });
+    }
+    if (parts.at(2) == "measurements") {
+        static Metrics::Counter &requests = routeRequests("measurements");
+        requests.add();
+        return respond(request, files, [id, files, query = request.query]() { return measurements(id, files, query); });
+    }
+    if (parts.at(2) == "rollup") {
+        static Metrics::Counter &requests = routeRequests("rollup");
+        requests.add();
+        return respond(request, files, [id, files, query = request.query]() { return rollup(id, files, query); });
+    }
+    return error(404, "Nieznany punkt końcowy");
+}
+
+/**
+ * @brief Zwraca odpowiedź z pamięci podręcznej lub tworzy ją i zapamiętuje.
+ *
+ * Kluczem pamięci podręcznej jest ścieżka z posortowanymi parametrami zapytania, a ETag - skrót klucza i stanu
+ * plików, z których powstaje odpowiedź (nazwy, rozmiary i czasy modyfikacji; bez odczytu treści). Żądanie
+ * warunkowe (If-None-Match) z aktualnym ETag otrzymuje 304 bez tworzenia odpowiedzi, a wpis z nieaktualnym
+ * ETag (np. po zapisaniu nowych pomiarów) jest tworzony ponownie. Odpowiedzi strumieniowe nie są zapamiętywane,
+ * ale mają ETag. Nagłówek Cache-Control: no-cache każe klientom sprawdzać aktualność przy każdym użyciu.
+ * Przy braku w pamięci podręcznej odpowiedź jest tworzona we wspólnej puli wątków (`TaskExecutor`), a wysyłana
+ * i zapamiętywana w wątku serwera (`HttpServer::Response::deferred`), więc odczyt plików nie blokuje
+ * wątku interfejsu.
+ *
+ * @param request Żądanie HTTP.
+ * @param files Pliki magazynu danych, z których powstaje odpowiedź.
+ * @param build Funkcja tworząca odpowiedź (wywoływana w wątku roboczym).
+ * @return HttpServer::Response Odpowiedź.
+ */
+HttpServer::Response QueryServer::respond(const HttpServer::Request &request, const QStringList &files,
+                                          std::function<HttpServer::Response()> build) {
+    static Metrics::Counter &hits = Metrics::counter("mjp_query_cache_total", "Odpowiedzi serwera zapytań według wyniku pamięci podręcznej",
+                                                     Metrics::label("result", "hit"));
+    static Metrics::Counter &notModified = Metrics::counter("mjp_query_cache_total", "Odpowiedzi serwera zapytań według wyniku pamięci podręcznej",
+                                                            Metrics::label("result", "not_modified"));
+    static Metrics::Counter &misses = Metrics::counter("mjp_query_cache_total", "Odpowiedzi serwera zapytań według wyniku pamięci podręcznej",
+                                                       Metrics::label("result", "miss"));
+
+    auto items = request.query.queryItems(QUrl::FullyDecoded);
+    std::sort(items.begin(), items.end());
+    QUrlQuery canonical;
+    canonical.setQueryItems(items);
+    const QString key = request.path + '?' + canonical.toString(QUrl::FullyEncoded);
+    const QByteArray etag = '"' + QCryptographicHash::hash(key.toUtf8() + storeFingerprint(files), QCryptographicHash::Sha1).toHex().left(16) + '"';
+
+    auto withValidators = [etag](HttpServer::Response response) {
+        if (response.status == 200 || response.status == 304) {
+            response.headers.append(qMakePair(QByteArray("ETag"), etag));
+            response.headers.append(qMakePair(QByteArray("Cache-Control"), QByteArray("no-cache")));
+        }
+        return response;
+    };
+
+    HttpServer::Response response;
+    if (request.headers.value("if-none-match") == etag) {
+        notModified.add();
+        response.status = 304;
+        return withValidators(response);
+    }
+    if (const CachedResponse *cached = cache.object(key); cached && cached->etag == etag) {
+        hits.add();
+        response.body = cached->body;
+        return withValidators(response);
+    }
+
+    misses.add();
+    response.deferred = [this, key, etag, withValidators, build = std::move(build)](const std::function<void(const HttpServer::Response &)> &reply) {
+        TaskExecutor::instance().submit([this, key, etag, withValidators, build, reply]() {
+            const HttpServer::Response built = build();
+            QMetaObject::invokeMethod(this, [this, key, etag, withValidators, built, reply]() {
+                if (built.status == 200 && !built.stream) {
+                    cache.insert(key, new CachedResponse{etag, built.body}, qMax(1, int(built.body.size())));
+                }
+                reply(withValidators(built));
+            }, Qt::QueuedConnection);
+        });
+    };
+    return response;
+}
+
+/**
+ * @brief Zwraca zawartość pliku magazynu danych (odpowiedź API GIOS zapisaną bez zmian).
+ *
+ * @param path Ścieżka pliku.
+ * @return HttpServer::Response Odpowiedź 200 lub 404, jeśli pliku nie ma w magazynie.
+ */
+HttpServer::Response QueryServer::fileResponse(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return error(404, "Brak danych w lokalnym magazynie");
+    }
+    HttpServer::Response response;
+    response.body = file.readAll();
+    return response;
+}
+
+/**
+ * @brief Zwraca najnowszy pomiar czujnika.
+ *
+ * Pliki są przeglądane od najnowszego. Plik bez pomiarów (np. same wartości null) nie kończy przeglądania,
+ * a przeglądanie kończy się dopiero na pliku zapisanym przed najpóźniejszym znalezionym pomiarem - plik
+ * zapisany w chwili T nie zawiera późniejszych pomiarów - więc zwykle wystarcza odczyt jednego pliku.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @param files Pliki pomiarów czujnika, od najstarszego do najnowszego.
+ * @return HttpServer::Response Odpowiedź `{"sensorId", "date", "value"}` lub 404.
+ */
+HttpServer::Response QueryServer::latest(int sensorId, const QStringList &files) {
+    MJP_TRACE_SCOPE("QueryServer::latest");
+    QPair<QDateTime, double> newest;
+    for (auto it = files.crbegin(); it != files.crend(); ++it) {
+        const QDateTime saved = fileTimestamp(*it);
+        if (newest.first.isValid() && saved.isValid() && saved < newest.first) {
+            break;
+        }
+        const Measurements points = load({*it}, QDateTime(), QDateTime());
+        if (!points.isEmpty() && (!newest.first.isValid() || points.last().first > newest.first)) {
+            newest = points.last();
+        }
+    }
+    if (!newest.first.isValid()) {
+        return error(404, "Brak pomiarów czujnika");
+    }
+    HttpServer::Response response;
+    response.body = "{\"sensorId\":" + QByteArray::number(sensorId) + ',' + pointJson(newest.first, newest.second).mid(1);
+    return response;
+}
+
+/**
+ * @brief Zwraca pomiary czujnika z zakresu dat (parametry `from` i `to`, domyślnie bez ograniczeń).
+ *
+ * Pomiary ze wszystkich plików są scalane (powtórzenia tej samej chwili pomiaru występują raz) i sortowane
+ * według czasu. Treść ma postać `{"sensorId": ..., "values": [{"date": ..., "value": ...}, ...]}`, zgodną
+ * z odpowiedzią `data/getData` API GIOS. Pliki są czytane po kolei (`MeasurementCursor`), a pomiary od razu
+ * zamieniane na JSON. Po przekroczeniu `StreamThreshold` pomiarów odpowiedź jest wysyłana strumieniowo:
+ * dotychczasowa treść (utworzona w wątku roboczym) jest pierwszą częścią, a każda kolejna część powstaje
+ * z następnych plików (co najmniej `StreamChunkSize` pomiarów), gdy gniazdo jest gotowe na dalszą treść,
+ * więc ani pomiary, ani treść całego zakresu nie są składane w pamięci.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @param files Pliki pomiarów czujnika.
+ * @param query Parametry zapytania.
+ * @return HttpServer::Response Odpowiedź 200 lub 400 (niepoprawny zakres dat).
+ */
+HttpServer::Response QueryServer::measurements(int sensorId, const QStringList &files, const QUrlQuery &query) {
+    QDateTime from;
+    QDateTime to;
+    if (!parseRange(query, &from, &to)) {
+        return error(400, "Niepoprawny zakres dat (from, to)");
+    }
+
+    const QByteArray head = "{\"sensorId\":" + QByteArray::number(sensorId) + ",\"values\":[";
+    auto cursor = std::make_shared<MeasurementCursor>(files, from, to);
+    auto count = std::make_shared<int>(0);
+    auto chunk = [cursor, count](int size) {
+        QByteArray bytes;
+        Measurements points;
+        while (!cursor->atEnd() && points.size() < size) {
+            cursor->read(&points);
+        }
+        bytes.reserve(int(points.size()) * 48);
+        for (const auto &point : std::as_const(points)) {
+            if ((*count)++ > 0) {
+                bytes += ',';
+            }
+            bytes += pointJson(point.first, point.second);
+        }
+        return bytes;
+    };
+
+    HttpServer::Response response;
+    const QByteArray first = chunk(StreamThreshold + 1);
+    if (cursor->atEnd()) {
+        response.body = head + first + "]}";
+        return response;
+    }
+
+    bool started = false;
+    bool finished = false;
+    response.stream = [head, first, cursor, chunk, started, finished]() mutable -> QByteArray {
+        if (!started) {
+            started = true;
+            return head + first;
+        }
+        if (finished) {
+            return QByteArray();
+        }
+        while (!cursor->atEnd()) {
+            const QByteArray bytes = chunk(StreamChunkSize);
+            if (!bytes.isEmpty()) {
+                return bytes;
+            }
+        }
+        finished = true;
+        return "]}";
+    };
+    return response;
+}
+
+/**
+ * @brief Zwraca statystyki pomiarów czujnika w przedziałach czasu (parametr `interval`: `hour` lub `day`).
+ *
+ * Dla każdego niepustego przedziału zwraca początek, liczbę pomiarów, minimum, średnią i maksimum.
+ * Pomiary są agregowane plik po pliku (`MeasurementCursor`), bez wczytywania całego zakresu.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @param files Pliki pomiarów czujnika.
+ * @param query Parametry zapytania (`from`, `to`, `interval`, domyślnie `day`).
+ * @return HttpServer::Response Odpowiedź `{"sensorId", "interval", "buckets": [...]}` lub 400.
+ */
+HttpServer::Response QueryServer::rollup(int sensorId, const QStringList &files, const QUrlQuery &query) {
+    QDateTime from;
+    QDateTime to;
+    const QString interval = query.queryItemValue("interval").isEmpty() ? QString("day") : query.queryItemValue("interval");
+    if (!parseRange(query, &from, &to) || (interval != "hour" && interval != "day")) {
+        return error(400, "Niepoprawny zakres dat (from, to) lub przedział (interval: hour, day)");
+    }
+
+    struct Bucket {
+        int count = 0;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        double sum = 0.0;
+    };
+    QMap<QDateTime, Bucket> buckets;
+    MeasurementCursor cursor(files, from, to);
+    Measurements points;
+    while (!cursor.atEnd()) {
+        points.resize(0);
+        cursor.read(&points);
+        for (const auto &point : std::as_const(points)) {
+            const QDateTime start = interval == "hour"
+                                        ? QDateTime(point.first.date(), QTime(point.first.time().hour(), 0))
+                                        : QDateTime(point.first.date(), QTime(0, 0));
+            Bucket &bucket = buckets[start];
+            bucket.count++;
+            bucket.min = qMin(bucket.min, point.second);
+            bucket.max = qMax(bucket.max, point.second);
+            bucket.sum += point.second;
+        }
+    }
+
+    QByteArray body = "{\"sensorId\":" + QByteArray::number(sensorId) + ",\"interval\":\"" + interval.toUtf8() + "\",\"buckets\":[";
+    for (auto it = buckets.constBegin(); it != buckets.constEnd(); ++it) {
+        if (it != buckets.constBegin()) {
+            body += ',';
+        }
+        body += "{\"start\":\"" + it.key().toString(DateFormat).toUtf8() + "\",\"count\":" + QByteArray::number(it->count)
+                + ",\"min\":" + QByteArray::number(it->min, 'g', 10) + ",\"avg\":" + QByteArray::number(it->sum / it->count, 'g', 10)
+                + ",\"max\":" + QByteArray::number(it->max, 'g', 10) + '}';
+    }
+    body += "]}";
+
+    HttpServer::Response response;
+    response.body = body;
+    return response;
+}
+
+/**
+ * @brief Wczytuje i scala pomiary z plików, ograniczone do zakresu dat.
+ *
+ * Pliki zapisane przed początkiem zakresu są pomijane bez odczytu (`MeasurementCursor`).
+ *
+ * @param files Pliki pomiarów.
+ * @param from Najwcześniejsza data (niepoprawna oznacza brak ograniczenia).
+ * @param to Najpóźniejsza data (niepoprawna oznacza brak ograniczenia).
+ * @return Measurements Pomiary posortowane według czasu, bez powtórzeń.
+ */
+QueryServer::Measurements QueryServer::load(const QStringList &files, const QDateTime &from, const QDateTime &to) {
+    MJP_TRACE_SCOPE("QueryServer::load");
+    MeasurementCursor cursor(files, from, to);
+    Measurements points;
+    while (!cursor.atEnd()) {
+        cursor.read(&points);
+    }
+    return points;
+}
+
+/**
+ * @brief Odczytuje chwilę zapisu pliku pomiarów z jego nazwy (`<type>_<id>_yyyyMMdd_HHmmss.json`).
+ *
+ * @param path Ścieżka pliku.
+ * @return QDateTime Chwila zapisu lub niepoprawna data, jeśli nazwa ma inny format.
+ */
+QDateTime QueryServer::fileTimestamp(const QString &path) {
+    const QString name = QFileInfo(path).completeBaseName();
+    return QDateTime::fromString(name.section('_', -2), FileTimestampFormat);
+}
+
+/**
+ * @brief Odczytuje zakres dat z parametrów `from` i `to` (ISO 8601, data lub data z godziną).
+ *
+ * Sama data w `to` oznacza koniec tego dnia. Brak parametru oznacza brak ograniczenia.
+ *
+ * @param query Parametry zapytania.
+ * @param from Wskaźnik na początek zakresu.
+ * @param to Wskaźnik na koniec zakresu.
+ * @return bool Wartość false, jeśli parametr ma niepoprawny format lub `from` jest późniejsze niż `to`.
+ */
+bool QueryServer::parseRange(const QUrlQuery &query, QDateTime *from, QDateTime *to) {
+    auto parse = [&query](const char *name, bool endOfDay, QDateTime *result) {
+        const QString value = query.queryItemValue(name, QUrl::FullyDecoded);
+        if (value.isEmpty()) {
+            return true;
+        }
+        const QDate date = QDate::fromString(value, Qt::ISODate);
+        *result = date.isValid() ? QDateTime(date, endOfDay ? QTime(23, 59, 59) : QTime(0, 0))
+                                 : QDateTime::fromString(value, Qt::ISODate);
+        return result->isValid();
+    };
+    return parse("from", false, from) && parse("to", true, to) && !(from->isValid() && to->isValid() && *from > *to);
+}
+
+/**
+ * @brief Zwraca opis stanu plików (nazwy, rozmiary, czasy modyfikacji) bez odczytu ich treści.
+ *
+ * @param files Ścieżki plików.
+ * @return QByteArray Opis stanu plików.
+ */
+QByteArray QueryServer::storeFingerprint(const QStringList &files) {
+    QByteArray fingerprint;
+    for (const QString &path : files) {
+        const QFileInfo info(path);
+        fingerprint += info.fileName().toUtf8() + ':' + QByteArray::number(info.exists() ? info.size() : -1) + ':'
+                       + QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + ';';
+    }
+    return fingerprint;
+}
+
+/**
+ * @brief Zwraca pomiar w formacie JSON (`{"date": ..., "value": ...}`).
+ */
+QByteArray QueryServer::pointJson(const QDateTime &date, double value) {
+    return "{\"date\":\"" + date.toString(DateFormat).toUtf8() + "\",\"value\":" + QByteArray::number(value, 'g', 10) + '}';
+}
+
+/**
+ * @brief Tworzy odpowiedź błędu w formacie `{"error": ...}`.
+ *
+ * @param status Kod odpowiedzi.
+ * @param message Opis błędu.
+ * @return HttpServer::Response Odpowiedź błędu.
+ */
+HttpServer::Response QueryServer::error(int status, const QString &message) {
+    HttpServer::Response response;
+    response.status = status;
+    response.body = QJsonDocument(QJsonObject{{"error", message}}).toJson(QJsonDocument::Compact);
+    return response;
+}
\ No newline at end of file
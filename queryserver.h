@@ -0,0 +1,88 @@
+/**
+ * @file queryserver.h
+ * @brief Definicja klasy QueryServer - lokalnego serwera HTTP/JSON udostępniającego dane z magazynu aplikacji.
+ */
+
+#ifndef QUERYSERVER_H
+#define QUERYSERVER_H
+
+#include <QObject>
+#include <QCache>
+#include <QDateTime>
+#include <QPair>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+#include "httpserver.h"
+
+class QueryServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy QueryServer.
+     *
+     * Rejestruje punkty końcowe tylko do odczytu (prefiks `/api/`):
+     * - `stations` - lista stacji,
+     * - `stations/<id>/sensors` - czujniki stacji,
+     * - `sensors/<id>/latest` - najnowszy pomiar czujnika,
+     * - `sensors/<id>/measurements?from=&to=` - pomiary z zakresu dat,
+     * - `sensors/<id>/rollup?from=&to=&interval=hour|day` - minimum, średnia i maksimum w przedziałach czasu.
+     *
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit QueryServer(QObject *parent = nullptr);
+
+    /**
+     * @brief Rozpoczyna nasłuchiwanie.
+     *
+     * @param address Adres, na którym serwer nasłuchuje.
+     * @param port Port; 0 oznacza dowolny wolny port.
+     * @return bool Wartość true, jeśli serwer nasłuchuje.
+     */
+    bool listen(const QHostAddress &address, quint16 port);
+
+    /**
+     * @brief Zwraca port, na którym serwer nasłuchuje.
+     */
+    quint16 port() const;
+
+    /**
+     * @brief Zwraca opis ostatniego błędu serwera.
+     */
+    QString errorString() const;
+
+private:
+    using Measurements = QVector<QPair<QDateTime, double>>;
+
+    /**
+     * @brief Odpowiedź zapamiętana w pamięci podręcznej razem z ETag stanu magazynu, z którego powstała.
+     */
+    struct CachedResponse {
+        QByteArray etag;
+        QByteArray body;
+    };
+
+    class MeasurementCursor;
+
+    HttpServer::Response handle(const HttpServer::Request &request);
+    HttpServer::Response respond(const HttpServer::Request &request, const QStringList &files,
+                                 std::function<HttpServer::Response()> build);
+    static HttpServer::Response fileResponse(const QString &path);
+    static HttpServer::Response latest(int sensorId, const QStringList &files);
+    static HttpServer::Response measurements(int sensorId, const QStringList &files, const QUrlQuery &query);
+    static HttpServer::Response rollup(int sensorId, const QStringList &files, const QUrlQuery &query);
+
+    static Measurements load(const QStringList &files, const QDateTime &from, const QDateTime &to);
+    static QDateTime fileTimestamp(const QString &path);
+    static bool parseRange(const QUrlQuery &query, QDateTime *from, QDateTime *to);
+    static QByteArray storeFingerprint(const QStringList &files);
+    static QByteArray pointJson(const QDateTime &date, double value);
+    static HttpServer::Response error(int status, const QString &message);
+
+    HttpServer server;
+    QCache<QString, CachedResponse> cache;
+};
+
+#endif
\ No newline at end of file
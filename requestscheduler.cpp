@@ -0,0 +1,198 @@
+/**
+ * @file requestscheduler.cpp
+ * @brief Implementacja klasy RequestScheduler - kolejki priorytetowej żądań sieciowych ApiWorker.
+ */
+
+#include "requestscheduler.h"
+
+#include <QtMath>
+
+namespace {
+/** Maksymalna liczba jednoczesnych żądań do jednego hosta (tyle połączeń otwiera QNetworkAccessManager). */
+constexpr int MaxPerHost = 6;
+/** Liczba miejsc na hosta zarezerwowanych dla żądań interaktywnych. */
+constexpr int ReservedForInteractive = 1;
+/** Pojemność kubełka żetonów (maksymalna liczba żądań wysłanych bez przerwy). */
+constexpr double BucketCapacity = 10.0;
+/** Liczba żetonów przybywających na sekundę (średnia liczba żądań na sekundę). */
+constexpr double TokensPerSecond = 2.0;
+/** Najkrótszy odstęp (ms) między kolejnymi sygnałami `statsChanged` (jedna klatka interfejsu). */
+constexpr int StatsInterval = 16;
+}
+
+/**
+ * @brief Konstruktor klasy RequestScheduler.
+ *
+ * Kubełek żetonów jest na początku pełny. Timer uzupełniania jest uruchamiany tylko wtedy, gdy żądania
+ * w tle czekają na żeton. Timer statystyk zbiera zmiany stanu kolejki i zgłasza je jednym sygnałem
+ * `statsChanged` na `StatsInterval`.
+ *
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+RequestScheduler::RequestScheduler(QObject *parent)
+    : QObject(parent)
+    , tokens(BucketCapacity)
+    , dispatched{}
+    , totalWaitMs{}
+    , maxWaitMs{}
+    , active(0)
+{
+    sinceRefill.start();
+    refillTimer.setSingleShot(true);
+    connect(&refillTimer, &QTimer::timeout, this, &RequestScheduler::dispatch);
+    statsTimer.setSingleShot(true);
+    statsTimer.setInterval(StatsInterval);
+    connect(&statsTimer, &QTimer::timeout, this, [this]() { emit statsChanged(stats()); });
+}
+
+/**
+ * @brief Dodaje żądanie do kolejki i wysyła żądania, na które pozwalają limity.
+ *
+ * @param request Żądanie sieciowe.
+ * @param requestId Identyfikator żądania.
+ * @param priority Klasa priorytetu.
+ */
+void RequestScheduler::enqueue(const QNetworkRequest &request, int requestId, Priority priority) {
+    Item item{request, requestId, QElapsedTimer()};
+    item.queuedFor.start();
+    queues[qBound(0, static_cast<int>(priority), PriorityCount - 1)].append(item);
+    dispatch();
+}
+
+/**
+ * @brief Usuwa żądanie z kolejki.
+ *
+ * @param requestId Identyfikator żądania.
+ * @return bool Wartość true, jeśli żądanie czekało w kolejce (nie zostało jeszcze wysłane).
+ */
+bool RequestScheduler::cancel(int requestId) {
+    for (QList<Item> &queue : queues) {
+        for (int i = 0; i < queue.size(); ++i) {
+            if (queue.at(i).requestId == requestId) {
+                queue.removeAt(i);
+                scheduleStats();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Przenosi oczekujące żądanie do wyższej klasy priorytetu.
+ *
+ * Używane, gdy użytkownik zażąda danych, które są już w kolejce jako pobieranie w tle - żądanie nie musi
+ * wtedy czekać za pozostałymi żądaniami w tle.
+ *
+ * @param requestId Identyfikator żądania.
+ * @param priority Nowa klasa priorytetu (ignorowana, jeśli nie jest wyższa od bieżącej).
+ */
+void RequestScheduler::promote(int requestId, Priority priority) {
+    for (int p = priority + 1; p < PriorityCount; ++p) {
+        for (int i = 0; i < queues[p].size(); ++i) {
+            if (queues[p].at(i).requestId == requestId) {
+                queues[priority].append(queues[p].takeAt(i));
+                dispatch();
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Zgłasza zakończenie wysłanego żądania i zwalnia miejsce dla hosta.
+ *
+ * @param url Adres URL zakończonego żądania.
+ */
+void RequestScheduler::requestFinished(const QUrl &url) {
+    auto it = activePerHost.find(url.host());
+    if (it != activePerHost.end()) {
+        if (--it.value() <= 0) activePerHost.erase(it);
+        active--;
+    }
+    dispatch();
+}
+
+/**
+ * @brief Zwraca bieżące statystyki kolejki.
+ *
+ * @return Stats Statystyki kolejki.
+ */
+RequestScheduler::Stats RequestScheduler::stats() const {
+    Stats result;
+    for (int p = 0; p < PriorityCount; ++p) {
+        result.queued[p] = queues[p].size();
+        result.dispatched[p] = dispatched[p];
+        result.averageWaitMs[p] = dispatched[p] == 0 ? 0.0 : static_cast<double>(totalWaitMs[p]) / dispatched[p];
+        result.maxWaitMs[p] = maxWaitMs[p];
+    }
+    result.active = active;
+    return result;
+}
+
+/**
+ * @brief Wysyła oczekujące żądania, na które pozwalają limity.
+ *
+ * Kolejki są przeglądane od najwyższego priorytetu, a w obrębie kolejki w kolejności dodania. Żądanie może
+ * zostać wysłane, jeśli jego host ma wolne miejsce - żądania w tle nie mogą zająć miejsc zarezerwowanych dla
+ * żądań interaktywnych. Żądania w tle wymagają ponadto żetonu z kubełka; żądania interaktywne nie czekają
+ * na żeton, ale go zużywają (stan kubełka może spaść poniżej zera), więc ogólna częstość żądań nie przekracza
+ * limitu. Jeśli żądania w tle czekają tylko na żeton, timer budzi kolejkę, gdy żeton przybędzie.
+ */
+void RequestScheduler::dispatch() {
+    refillTokens();
+    bool waitingForTokens = false;
+
+    for (int p = 0; p < PriorityCount; ++p) {
+        const bool interactive = p == Interactive;
+        const int hostLimit = interactive ? MaxPerHost : MaxPerHost - ReservedForInteractive;
+        QList<Item> &queue = queues[p];
+
+        for (int i = 0; i < queue.size();) {
+            const QString host = queue.at(i).request.url().host();
+            if (activePerHost.value(host) >= hostLimit) {
+                ++i;
+                continue;
+            }
+            if (!interactive && tokens < 1.0) {
+                waitingForTokens = true;
+                break;
+            }
+
+            Item item = queue.takeAt(i);
+            const qint64 waited = item.queuedFor.elapsed();
+            totalWaitMs[p] += waited;
+            maxWaitMs[p] = qMax(maxWaitMs[p], waited);
+            dispatched[p]++;
+            tokens -= 1.0;
+            activePerHost[host]++;
+            active++;
+            emit ready(item.request, item.requestId);
+        }
+    }
+
+    if (waitingForTokens && !refillTimer.isActive()) {
+        refillTimer.start(qCeil((1.0 - tokens) * 1000.0 / TokensPerSecond));
+    }
+    scheduleStats();
+}
+
+/**
+ * @brief Zgłasza zmianę stanu kolejki.
+ *
+ * Sygnał `statsChanged` (przekazywany do wątku interfejsu) jest emitowany dopiero po `StatsInterval`
+ * z bieżącymi statystykami, więc zmiany przy każdym wysłaniu i zakończeniu żądania w tym czasie
+ * są zgłaszane razem.
+ */
+void RequestScheduler::scheduleStats() {
+    if (!statsTimer.isActive()) {
+        statsTimer.start();
+    }
+}
+
+/**
+ * @brief Dodaje żetony, które przybyły od ostatniego uzupełnienia.
+ */
+void RequestScheduler::refillTokens() {
+    tokens = qMin(BucketCapacity, tokens + sinceRefill.restart() * TokensPerSecond / 1000.0);
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * @file requestscheduler.h
+ * @brief Definicja klasy RequestScheduler - kolejki priorytetowej żądań sieciowych ApiWorker.
+ */
+
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QNetworkRequest>
+#include <QTimer>
+
+class RequestScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Klasa priorytetu żądania (mniejsza wartość - wyższy priorytet).
+     */
+    enum Priority {
+        Interactive,
+        Prefetch,
+        Backfill,
+        PriorityCount
+    };
+    Q_ENUM(Priority)
+
+    /**
+     * @brief Statystyki kolejki.
+     *
+     * Dla każdej klasy priorytetu: liczba żądań w kolejce, liczba wysłanych żądań, średni i maksymalny czas
+     * oczekiwania w kolejce (ms). `active` to liczba żądań w toku (wszystkie hosty).
+     */
+    struct Stats {
+        int queued[PriorityCount] = {};
+        quint64 dispatched[PriorityCount] = {};
+        double averageWaitMs[PriorityCount] = {};
+        qint64 maxWaitMs[PriorityCount] = {};
+        int active = 0;
+    };
+
+    /**
+     * @brief Konstruktor klasy RequestScheduler.
+     *
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit RequestScheduler(QObject *parent = nullptr);
+
+    /**
+     * @brief Dodaje żądanie do kolejki i wysyła żądania, na które pozwalają limity.
+     *
+     * @param request Żądanie sieciowe.
+     * @param requestId Identyfikator żądania.
+     * @param priority Klasa priorytetu.
+     */
+    void enqueue(const QNetworkRequest &request, int requestId, Priority priority);
+
+    /**
+     * @brief Usuwa żądanie z kolejki.
+     *
+     * @param requestId Identyfikator żądania.
+     * @return bool Wartość true, jeśli żądanie czekało w kolejce (nie zostało jeszcze wysłane).
+     */
+    bool cancel(int requestId);
+
+    /**
+     * @brief Przenosi oczekujące żądanie do wyższej klasy priorytetu.
+     *
+     * Żądanie trafia na koniec kolejki nowej klasy; czas oczekiwania liczony jest od pierwotnego dodania.
+     *
+     * @param requestId Identyfikator żądania.
+     * @param priority Nowa klasa priorytetu (ignorowana, jeśli nie jest wyższa od bieżącej).
+     */
+    void promote(int requestId, Priority priority);
+
+    /**
+     * @brief Zgłasza zakończenie wysłanego żądania i zwalnia miejsce dla hosta.
+     *
+     * @param url Adres URL zakończonego żądania.
+     */
+    void requestFinished(const QUrl &url);
+
+    /**
+     * @brief Zwraca bieżące statystyki kolejki.
+     *
+     * @return Stats Statystyki kolejki.
+     */
+    Stats stats() const;
+
+signals:
+    /**
+     * @brief Sygnał emitowany, gdy żądanie może zostać wysłane.
+     *
+     * @param request Żądanie sieciowe.
+     * @param requestId Identyfikator żądania.
+     */
+    void ready(const QNetworkRequest &request, int requestId);
+
+    /**
+     * @brief Sygnał emitowany po zmianie stanu kolejki (najwyżej raz na klatkę interfejsu).
+     *
+     * @param stats Bieżące statystyki kolejki.
+     */
+    void statsChanged(const RequestScheduler::Stats &stats);
+
+private:
+    struct Item {
+        QNetworkRequest request;
+        int requestId;
+        QElapsedTimer queuedFor;
+    };
+
+    void dispatch();
+    void refillTokens();
+    void scheduleStats();
+
+    QList<Item> queues[PriorityCount];
+    QHash<QString, int> activePerHost;
+    QTimer refillTimer;
+    QTimer statsTimer;
+    QElapsedTimer sinceRefill;
+    double tokens;
+    quint64 dispatched[PriorityCount];
+    qint64 totalWaitMs[PriorityCount];
+    qint64 maxWaitMs[PriorityCount];
+    int active;
+};
+
+Q_DECLARE_METATYPE(RequestScheduler::Stats)
+
+#endif
\ No newline at end of file
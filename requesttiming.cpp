@@ -0,0 +1,121 @@
+/**
+ * @file requesttiming.cpp
+ * @brief Implementacja klasy RequestTiming - pomiaru czasu etapów żądań sieciowych ApiWorker.
+ */
+
+#include "requesttiming.h"
+
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+/**
+ * @brief Rozpoczyna pomiar odpowiedzi tuż po jej utworzeniu przez QNetworkAccessManager.
+ *
+ * Zapamiętuje chwile, w których odpowiedź emituje sygnały kolejnych etapów: rozpoczęcie łączenia
+ * (tylko dla nowego połączenia), zakończenie uzgadniania TLS, wysłanie żądania i odebranie nagłówków.
+ * Sygnały `socketStartedConnecting` i `requestSent` są dostępne od Qt 6.3; we wcześniejszych wersjach
+ * czas połączenia nie jest mierzony, a czas do pierwszego bajtu jest liczony od utworzenia odpowiedzi.
+ *
+ * @param reply Wskaźnik na odpowiedź sieciową.
+ */
+void RequestTiming::track(QNetworkReply *reply) {
+    Marks &entry = marks[reply];
+    entry.clock.start();
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    QObject::connect(reply, &QNetworkReply::socketStartedConnecting, reply, [this, reply]() {
+        Marks &entry = marks[reply];
+        entry.connecting = entry.clock.elapsed();
+    });
+    QObject::connect(reply, &QNetworkReply::requestSent, reply, [this, reply]() {
+        Marks &entry = marks[reply];
+        entry.sent = entry.clock.elapsed();
+    });
+#endif
+#ifndef QT_NO_SSL
+    QObject::connect(reply, &QNetworkReply::encrypted, reply, [this, reply]() {
+        Marks &entry = marks[reply];
+        entry.encrypted = entry.clock.elapsed();
+    });
+#endif
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, reply, [this, reply]() {
+        Marks &entry = marks[reply];
+        if (entry.headers == -1) {
+            entry.headers = entry.clock.elapsed();
+        }
+    });
+}
+
+/**
+ * @brief Kończy pomiar odpowiedzi i dolicza go do statystyk.
+ *
+ * @param reply Wskaźnik na zakończoną odpowiedź sieciową.
+ * @return Phases Czasy etapów żądania (domyślne, jeśli odpowiedź nie była mierzona).
+ */
+RequestTiming::Phases RequestTiming::finish(QNetworkReply *reply) {
+    auto it = marks.find(reply);
+    if (it == marks.end()) {
+        return Phases();
+    }
+    const Marks entry = it.value();
+    marks.erase(it);
+
+    Phases phases;
+    phases.total = entry.clock.elapsed();
+    phases.reusedConnection = entry.connecting == -1;
+    phases.http2 = reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+    if (entry.connecting != -1) {
+        const qint64 connected = entry.encrypted != -1 ? entry.encrypted : entry.sent;
+        if (connected != -1) {
+            phases.connect = connected - entry.connecting;
+        }
+    }
+    if (entry.headers != -1) {
+        phases.ttfb = entry.headers - qMax<qint64>(entry.sent, 0);
+        phases.transfer = phases.total - entry.headers;
+    }
+
+    totals.requests++;
+    if (phases.reusedConnection) {
+        totals.reusedConnections++;
+    }
+    if (phases.http2) {
+        totals.http2Requests++;
+    }
+    connectTotal.add(phases.connect);
+    ttfbTotal.add(phases.ttfb);
+    transferTotal.add(phases.transfer);
+    totalTotal.add(phases.total);
+    return phases;
+}
+
+/**
+ * @brief Zwraca statystyki wszystkich zmierzonych żądań.
+ *
+ * @return Stats Statystyki żądań.
+ */
+RequestTiming::Stats RequestTiming::stats() const {
+    Stats result = totals;
+    result.averageConnectMs = connectTotal.average();
+    result.averageTtfbMs = ttfbTotal.average();
+    result.averageTransferMs = transferTotal.average();
+    result.averageTotalMs = totalTotal.average();
+    return result;
+}
+
+/**
+ * @brief Dolicza zmierzony czas etapu (wartości ujemne - etap niezmierzony - są pomijane).
+ */
+void RequestTiming::Total::add(qint64 value) {
+    if (value >= 0) {
+        sum += value;
+        count++;
+    }
+}
+
+/**
+ * @brief Zwraca średni czas etapu (ms) lub 0, jeśli etap nie został zmierzony.
+ */
+double RequestTiming::Total::average() const {
+    return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+}
\ No newline at end of file
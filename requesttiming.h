@@ -0,0 +1,99 @@
+/**
+ * @file requesttiming.h
+ * @brief Definicja klasy RequestTiming - pomiaru czasu etapów żądań sieciowych ApiWorker.
+ */
+
+#ifndef REQUESTTIMING_H
+#define REQUESTTIMING_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMetaType>
+
+class QNetworkReply;
+
+class RequestTiming
+{
+public:
+    /**
+     * @brief Czasy etapów jednego żądania (ms); -1 oznacza etap, który nie wystąpił lub nie został zmierzony.
+     *
+     * `connect` - zestawienie nowego połączenia (rozwiązanie nazwy, TCP i TLS; Qt nie udostępnia tych
+     * etapów osobno), `ttfb` - od wysłania żądania do nagłówków odpowiedzi, `transfer` - od nagłówków
+     * do końca treści, `total` - od wysłania żądania przez QNetworkAccessManager do końca odpowiedzi.
+     */
+    struct Phases {
+        qint64 connect = -1;
+        qint64 ttfb = -1;
+        qint64 transfer = -1;
+        qint64 total = -1;
+        bool reusedConnection = true;
+        bool http2 = false;
+    };
+
+    /**
+     * @brief Statystyki wszystkich zmierzonych żądań.
+     *
+     * `reusedConnections` - żądania wysłane istniejącym (ciepłym) połączeniem, `http2Requests` - żądania
+     * wysłane przez HTTP/2. Średnie czasy etapów (ms) liczone są z żądań, w których etap wystąpił.
+     */
+    struct Stats {
+        quint64 requests = 0;
+        quint64 reusedConnections = 0;
+        quint64 http2Requests = 0;
+        double averageConnectMs = 0;
+        double averageTtfbMs = 0;
+        double averageTransferMs = 0;
+        double averageTotalMs = 0;
+    };
+
+    /**
+     * @brief Rozpoczyna pomiar odpowiedzi tuż po jej utworzeniu przez QNetworkAccessManager.
+     *
+     * @param reply Wskaźnik na odpowiedź sieciową.
+     */
+    void track(QNetworkReply *reply);
+
+    /**
+     * @brief Kończy pomiar odpowiedzi i dolicza go do statystyk.
+     *
+     * @param reply Wskaźnik na zakończoną odpowiedź sieciową.
+     * @return Phases Czasy etapów żądania (domyślne, jeśli odpowiedź nie była mierzona).
+     */
+    Phases finish(QNetworkReply *reply);
+
+    /**
+     * @brief Zwraca statystyki wszystkich zmierzonych żądań.
+     *
+     * @return Stats Statystyki żądań.
+     */
+    Stats stats() const;
+
+private:
+    struct Marks {
+        QElapsedTimer clock;
+        qint64 connecting = -1;
+        qint64 encrypted = -1;
+        qint64 sent = -1;
+        qint64 headers = -1;
+    };
+
+    struct Total {
+        qint64 sum = 0;
+        quint64 count = 0;
+
+        void add(qint64 value);
+        double average() const;
+    };
+
+    QHash<QNetworkReply*, Marks> marks;
+    Stats totals;
+    Total connectTotal;
+    Total ttfbTotal;
+    Total transferTotal;
+    Total totalTotal;
+};
+
+Q_DECLARE_METATYPE(RequestTiming::Stats)
+
+#endif
\ No newline at end of file
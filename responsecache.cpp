@@ -0,0 +1,202 @@
+/**
+ * @file responsecache.cpp
+ * @brief Implementacja klasy ResponseCache - dyskowej pamięci podręcznej odpowiedzi API GIOS.
+ */
+
+#include "responsecache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+/**
+ * @brief Zwraca udział żądań obsłużonych z pamięci podręcznej (trafienia i odpowiedzi 304).
+ *
+ * @return double Wartość z zakresu 0..1.
+ */
+double ResponseCache::Stats::hitRatio() const {
+    const quint64 total = hits + revalidated + misses;
+    return total == 0 ? 0.0 : static_cast<double>(hits + revalidated) / total;
+}
+
+/**
+ * @brief Konstruktor klasy ResponseCache.
+ *
+ * Każdy wpis to dwa pliki o nazwie będącej skrótem SHA-1 adresu URL: `<skrót>.body` z treścią odpowiedzi
+ * i `<skrót>.meta` z walidatorami (ETag, Last-Modified) i terminem ważności.
+ *
+ * @param directory Katalog pamięci podręcznej; pusty oznacza podkatalog "http" katalogu CacheLocation.
+ */
+ResponseCache::ResponseCache(const QString &directory)
+    : directory(directory.isEmpty()
+                    ? QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("http")
+                    : directory)
+{
+    QDir dir(this->directory);
+    if (!dir.exists()) dir.mkpath(".");
+}
+
+/**
+ * @brief Wyszukuje wpis dla podanego adresu URL.
+ *
+ * @param url Adres URL żądania.
+ * @param entry Wskaźnik na strukturę, do której zapisywany jest wpis.
+ * @return bool Wartość true, jeśli wpis istnieje (świeży lub nie).
+ */
+bool ResponseCache::lookup(const QUrl &url, Entry *entry) const {
+    QFile metaFile(filePath(url, "meta"));
+    QFile bodyFile(filePath(url, "body"));
+    if (!metaFile.open(QIODevice::ReadOnly) || !bodyFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject meta = QJsonDocument::fromJson(metaFile.readAll()).object();
+    if (meta["url"].toString() != url.toString(QUrl::FullyEncoded)) {
+        return false;
+    }
+    entry->etag = meta["etag"].toString().toUtf8();
+    entry->lastModified = meta["lastModified"].toString().toUtf8();
+    entry->expiresAt = QDateTime::fromString(meta["expiresAt"].toString(), Qt::ISODate);
+    entry->body = bodyFile.readAll();
+    return true;
+}
+
+/**
+ * @brief Zapisuje pobraną odpowiedź wraz z walidatorami i terminem ważności wynikającym z polityki.
+ *
+ * Treść jest zapisywana przed metadanymi, więc przerwany zapis nie pozostawia metadanych wskazujących
+ * na niepełną treść. Odpowiedzi bez okresu ważności w polityce (`expiryFor`, np. strony danych archiwalnych
+ * pobierane jednorazowo) nie są zapisywane - nie byłyby nigdy użyte bez połączenia z serwerem, a przy
+ * wieloletnim pobieraniu danych archiwalnych powiększałyby pamięć podręczną bez ograniczeń. Wpis zapisany
+ * dla takiego adresu przez wcześniejszą wersję programu jest przy tym usuwany.
+ *
+ * @param url Adres URL żądania.
+ * @param body Treść odpowiedzi.
+ * @param etag Wartość nagłówka ETag (może być pusta).
+ * @param lastModified Wartość nagłówka Last-Modified (może być pusta).
+ */
+void ResponseCache::store(const QUrl &url, const QByteArray &body, const QByteArray &etag, const QByteArray &lastModified) {
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QDateTime expiresAt = expiryFor(url, now);
+    if (expiresAt <= now) {
+        QFile::remove(filePath(url, "meta"));
+        QFile::remove(filePath(url, "body"));
+        return;
+    }
+
+    QSaveFile bodyFile(filePath(url, "body"));
+    if (!bodyFile.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    bodyFile.write(body);
+    if (!bodyFile.commit()) {
+        return;
+    }
+
+    Entry entry;
+    entry.etag = etag;
+    entry.lastModified = lastModified;
+    entry.expiresAt = expiresAt;
+    writeMeta(url, entry);
+}
+
+/**
+ * @brief Przedłuża ważność wpisu po odpowiedzi 304 (Not Modified).
+ *
+ * @param url Adres URL żądania.
+ * @param entry Wskaźnik na strukturę, do której zapisywany jest odświeżony wpis.
+ * @return bool Wartość true, jeśli wpis istniał.
+ */
+bool ResponseCache::refresh(const QUrl &url, Entry *entry) {
+    if (!lookup(url, entry)) {
+        return false;
+    }
+    entry->expiresAt = expiryFor(url, QDateTime::currentDateTimeUtc());
+    writeMeta(url, *entry);
+    return true;
+}
+
+/**
+ * @brief Zwraca termin ważności odpowiedzi zgodnie z polityką dla danego punktu końcowego API.
+ *
+ * @param url Adres URL żądania.
+ * @param now Chwila zapisu odpowiedzi.
+ * @return QDateTime Termin ważności.
+ */
+QDateTime ResponseCache::expiryFor(const QUrl &url, const QDateTime &now) {
+    const QString path = url.path();
+    if (path.endsWith("/station/findAll")) {
+        return now.addDays(1);
+    }
+    if (path.contains("/station/sensors/")) {
+        return now.addSecs(3600);
+    }
+    if (path.contains("/data/getData/")) {
+        const qint64 secs = now.toSecsSinceEpoch();
+        return QDateTime::fromSecsSinceEpoch((secs / 3600 + 1) * 3600, Qt::UTC);
+    }
+    return now;
+}
+
+/**
+ * @brief Zlicza odpowiedź obsłużoną bez połączenia z serwerem.
+ */
+void ResponseCache::recordHit(qint64 bytes) {
+    counters.hits++;
+    counters.bytesSaved += bytes;
+}
+
+/**
+ * @brief Zlicza odpowiedź 304 na żądanie warunkowe.
+ */
+void ResponseCache::recordRevalidation(qint64 bytes) {
+    counters.revalidated++;
+    counters.bytesSaved += bytes;
+}
+
+/**
+ * @brief Zlicza odpowiedź pobraną w całości.
+ */
+void ResponseCache::recordMiss(qint64 bytes) {
+    counters.misses++;
+    counters.bytesDownloaded += bytes;
+}
+
+/**
+ * @brief Zwraca statystyki pamięci podręcznej.
+ *
+ * @return Stats Statystyki od uruchomienia aplikacji.
+ */
+ResponseCache::Stats ResponseCache::stats() const {
+    return counters;
+}
+
+/**
+ * @brief Zwraca ścieżkę pliku wpisu dla adresu URL.
+ */
+QString ResponseCache::filePath(const QUrl &url, const QString &suffix) const {
+    const QByteArray hash = QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1).toHex();
+    return QDir(directory).filePath(QString::fromLatin1(hash) + "." + suffix);
+}
+
+/**
+ * @brief Zapisuje metadane wpisu.
+ */
+bool ResponseCache::writeMeta(const QUrl &url, const Entry &entry) const {
+    QJsonObject meta;
+    meta["url"] = url.toString(QUrl::FullyEncoded);
+    meta["etag"] = QString::fromUtf8(entry.etag);
+    meta["lastModified"] = QString::fromUtf8(entry.lastModified);
+    meta["expiresAt"] = entry.expiresAt.toUTC().toString(Qt::ISODate);
+
+    QSaveFile metaFile(filePath(url, "meta"));
+    if (!metaFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    metaFile.write(QJsonDocument(meta).toJson(QJsonDocument::Compact));
+    return metaFile.commit();
+}
\ No newline at end of file
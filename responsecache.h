@@ -0,0 +1,136 @@
+/**
+ * @file responsecache.h
+ * @brief Definicja klasy ResponseCache - dyskowej pamięci podręcznej odpowiedzi API GIOS.
+ */
+
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QMetaType>
+#include <QString>
+#include <QUrl>
+
+class ResponseCache
+{
+public:
+    /**
+     * @brief Wpis pamięci podręcznej.
+     */
+    struct Entry {
+        QByteArray body;
+        QByteArray etag;
+        QByteArray lastModified;
+        QDateTime expiresAt;
+    };
+
+    /**
+     * @brief Statystyki pamięci podręcznej.
+     *
+     * `hits` - odpowiedzi obsłużone bez połączenia z serwerem, `revalidated` - odpowiedzi 304 na żądania
+     * warunkowe, `misses` - odpowiedzi pobrane w całości, `bytesSaved` - bajty treści, których nie trzeba
+     * było pobierać, `bytesDownloaded` - bajty treści pobrane z serwera.
+     */
+    struct Stats {
+        quint64 hits = 0;
+        quint64 revalidated = 0;
+        quint64 misses = 0;
+        quint64 bytesSaved = 0;
+        quint64 bytesDownloaded = 0;
+
+        /**
+         * @brief Zwraca udział żądań obsłużonych z pamięci podręcznej (trafienia i odpowiedzi 304).
+         *
+         * @return double Wartość z zakresu 0..1.
+         */
+        double hitRatio() const;
+    };
+
+    /**
+     * @brief Konstruktor klasy ResponseCache.
+     *
+     * @param directory Katalog pamięci podręcznej; pusty oznacza podkatalog "http" katalogu CacheLocation.
+     */
+    explicit ResponseCache(const QString &directory = QString());
+
+    /**
+     * @brief Wyszukuje wpis dla podanego adresu URL.
+     *
+     * @param url Adres URL żądania.
+     * @param entry Wskaźnik na strukturę, do której zapisywany jest wpis.
+     * @return bool Wartość true, jeśli wpis istnieje (świeży lub nie).
+     */
+    bool lookup(const QUrl &url, Entry *entry) const;
+
+    /**
+     * @brief Zapisuje pobraną odpowiedź wraz z walidatorami i terminem ważności wynikającym z polityki.
+     *
+     * @param url Adres URL żądania.
+     * @param body Treść odpowiedzi.
+     * @param etag Wartość nagłówka ETag (może być pusta).
+     * @param lastModified Wartość nagłówka Last-Modified (może być pusta).
+     */
+    void store(const QUrl &url, const QByteArray &body, const QByteArray &etag, const QByteArray &lastModified);
+
+    /**
+     * @brief Przedłuża ważność wpisu po odpowiedzi 304 (Not Modified).
+     *
+     * @param url Adres URL żądania.
+     * @param entry Wskaźnik na strukturę, do której zapisywany jest odświeżony wpis.
+     * @return bool Wartość true, jeśli wpis istniał.
+     */
+    bool refresh(const QUrl &url, Entry *entry);
+
+    /**
+     * @brief Zwraca termin ważności odpowiedzi zgodnie z polityką dla danego punktu końcowego API.
+     *
+     * Lista stacji jest ważna dobę, listy czujników godzinę, a dane pomiarowe do najbliższej pełnej godziny
+     * (GIOS publikuje pomiary godzinowe). Pozostałe odpowiedzi (np. strony danych archiwalnych) nie mają okresu
+     * ważności i nie są zapisywane (`store`).
+     *
+     * @param url Adres URL żądania.
+     * @param now Chwila zapisu odpowiedzi.
+     * @return QDateTime Termin ważności.
+     */
+    static QDateTime expiryFor(const QUrl &url, const QDateTime &now);
+
+    /**
+     * @brief Zlicza odpowiedź obsłużoną bez połączenia z serwerem.
+     *
+     * @param bytes Rozmiar treści odpowiedzi.
+     */
+    void recordHit(qint64 bytes);
+
+    /**
+     * @brief Zlicza odpowiedź 304 na żądanie warunkowe.
+     *
+     * @param bytes Rozmiar treści odpowiedzi wczytanej z pamięci podręcznej.
+     */
+    void recordRevalidation(qint64 bytes);
+
+    /**
+     * @brief Zlicza odpowiedź pobraną w całości.
+     *
+     * @param bytes Rozmiar pobranej treści.
+     */
+    void recordMiss(qint64 bytes);
+
+    /**
+     * @brief Zwraca statystyki pamięci podręcznej.
+     *
+     * @return Stats Statystyki od uruchomienia aplikacji.
+     */
+    Stats stats() const;
+
+private:
+    QString filePath(const QUrl &url, const QString &suffix) const;
+    bool writeMeta(const QUrl &url, const Entry &entry) const;
+
+    QString directory;
+    Stats counters;
+};
+
+Q_DECLARE_METATYPE(ResponseCache::Stats)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file spscqueue.h
+ * @brief Definicja szablonu SpscQueue - bezblokadowej kolejki cyklicznej dla jednego producenta i jednego konsumenta.
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bezblokadowa kolejka cykliczna o stałej pojemności dla dokładnie jednego wątku zapisującego
+ * i jednego wątku odczytującego.
+ *
+ * Producent zapisuje tylko indeks `tail`, a konsument tylko indeks `head`; każdy z nich publikuje swój indeks
+ * z semantyką release i odczytuje indeks drugiej strony z semantyką acquire, więc element jest w pełni
+ * zapisany, zanim konsument go zobaczy. Indeksy leżą w osobnych liniach pamięci podręcznej procesora,
+ * a każda strona zapamiętuje ostatnio odczytany indeks drugiej strony, dzięki czemu w typowym przypadku
+ * operacja nie dotyka linii należącej do drugiego wątku.
+ *
+ * @tparam T Typ elementu (musi mieć konstruktor domyślny i być przenaszalny).
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /**
+     * @brief Konstruktor klasy SpscQueue.
+     *
+     * @param capacity Najmniejsza pojemność; jest zaokrąglana w górę do potęgi dwójki.
+     */
+    explicit SpscQueue(int capacity)
+    {
+        std::size_t size = 1;
+        while (size < static_cast<std::size_t>(qMax(1, capacity))) {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * @brief Dodaje element na koniec kolejki (wywoływać tylko z wątku producenta).
+     *
+     * @param value Element.
+     * @return bool Wartość false, jeśli kolejka jest pełna (element nie został dodany).
+     */
+    bool push(T value)
+    {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == slots.size()) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == slots.size()) {
+                return false;
+            }
+        }
+        slots[t & mask] = std::move(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pobiera element z początku kolejki (wywoływać tylko z wątku konsumenta).
+     *
+     * Zwolnione miejsce jest zerowane, więc zasoby elementu (np. współdzielony bufor QString) są zwalniane
+     * w wątku konsumenta, a nie przy nadpisaniu przez producenta.
+     *
+     * @param value Wskaźnik na zmienną, do której zostanie przeniesiony element.
+     * @return bool Wartość false, jeśli kolejka jest pusta.
+     */
+    bool pop(T *value)
+    {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) {
+                return false;
+            }
+        }
+        T &slot = slots[h & mask];
+        *value = std::move(slot);
+        slot = T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Zwraca pojemność kolejki.
+     */
+    int capacity() const { return static_cast<int>(slots.size()); }
+
+    /**
+     * @brief Zwraca przybliżoną liczbę elementów (dokładną tylko, gdy druga strona nie działa równocześnie).
+     */
+    int sizeApprox() const
+    {
+        const std::size_t h = head.load(std::memory_order_acquire);
+        return static_cast<int>(tail.load(std::memory_order_acquire) - h);
+    }
+
+private:
+    static constexpr std::size_t CacheLine = 64;
+
+    std::vector<T> slots;
+    std::size_t mask = 0;
+
+    alignas(CacheLine) std::atomic<std::size_t> head{0};
+    std::size_t cachedTail = 0;
+
+    alignas(CacheLine) std::atomic<std::size_t> tail{0};
+    std::size_t cachedHead = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,205 @@
+/**
+ * @file stationcatalog.cpp
+ * @brief Implementacja klasy StationCatalog - zwartego katalogu stacji pomiarowych.
+ */
+
+#include "stationcatalog.h"
+
+#include <QDebug>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <limits>
+
+namespace {
+/** Największa liczba nazw w puli - tyle różnych wartości mają 16-bitowe indeksy w rekordach `Station`. */
+constexpr int MaxNames = std::numeric_limits<quint16>::max() + 1;
+
+/**
+ * @brief Odczytuje współrzędną zapisaną w JSON jako liczba lub tekst.
+ */
+float coordinate(const QJsonValue &value) {
+    if (value.isDouble()) return static_cast<float>(value.toDouble());
+    bool ok = false;
+    const double parsed = value.toString().toDouble(&ok);
+    return ok ? static_cast<float>(parsed) : std::numeric_limits<float>::quiet_NaN();
+}
+}
+
+/**
+ * @brief Wczytuje katalog z tablicy JSON zwróconej przez `station/findAll`.
+ *
+ * Dla każdej stacji tworzy rekord `Station`: współrzędne są zamieniane na liczby, a nazwy miasta,
+ * gminy, powiatu i województwa trafiają do wspólnej puli nazw (każda nazwa jest przechowywana raz).
+ * Buduje mapę identyfikator → pozycja, dzięki której wyszukiwanie stacji po identyfikatorze nie wymaga
+ * przeglądania katalogu. Pusta tablica nie zmienia katalogu.
+ *
+ * @param array Tablica JSON zawierająca dane stacji.
+ */
+void StationCatalog::loadFromJson(const QJsonArray &array) {
+    if (array.isEmpty()) {
+        return;
+    }
+
+    stations.clear();
+    names.clear();
+    nameIndex.clear();
+    indexForId.clear();
+    stations.reserve(array.size());
+    intern(QString());
+
+    for (const QJsonValue &value : array) {
+        const QJsonObject obj = value.toObject();
+        const QJsonObject city = obj["city"].toObject();
+        const QJsonObject commune = city["commune"].toObject();
+
+        Station station;
+        station.id = obj["id"].toInt();
+        station.latitude = coordinate(obj["gegrLat"]);
+        station.longitude = coordinate(obj["gegrLon"]);
+        station.city = intern(city["name"].toString());
+        station.commune = intern(commune["communeName"].toString());
+        station.district = intern(commune["districtName"].toString());
+        station.province = intern(commune["provinceName"].toString());
+        station.stationName = obj["stationName"].toString();
+        station.addressStreet = obj["addressStreet"].toString();
+
+        indexForId.insert(station.id, stations.size());
+        stations.append(station);
+    }
+    stations.squeeze();
+    currentRevision++;
+}
+
+/**
+ * @brief Zwraca liczbę stacji w katalogu.
+ *
+ * @return int Liczba stacji.
+ */
+int StationCatalog::size() const {
+    return stations.size();
+}
+
+/**
+ * @brief Sprawdza, czy katalog jest pusty.
+ *
+ * @return bool Wartość true, jeśli katalog nie zawiera stacji.
+ */
+bool StationCatalog::isEmpty() const {
+    return stations.isEmpty();
+}
+
+/**
+ * @brief Zwraca rekord stacji o podanej pozycji w katalogu.
+ *
+ * @param index Pozycja stacji (0..size()-1).
+ * @return const Station& Rekord stacji.
+ */
+const StationCatalog::Station &StationCatalog::at(int index) const {
+    return stations.at(index);
+}
+
+/**
+ * @brief Zwraca rekord stacji o podanym identyfikatorze (wyszukiwanie O(1)).
+ *
+ * @param stationId Identyfikator stacji.
+ * @return const Station* Wskaźnik na rekord stacji lub nullptr, jeśli stacji nie ma w katalogu.
+ */
+const StationCatalog::Station *StationCatalog::find(int stationId) const {
+    auto it = indexForId.constFind(stationId);
+    return it == indexForId.constEnd() ? nullptr : &stations.at(it.value());
+}
+
+/**
+ * @brief Zwraca nazwę miasta stacji.
+ */
+QString StationCatalog::cityName(const Station &station) const {
+    return names.at(station.city);
+}
+
+/**
+ * @brief Zwraca nazwę gminy stacji.
+ */
+QString StationCatalog::communeName(const Station &station) const {
+    return names.at(station.commune);
+}
+
+/**
+ * @brief Zwraca nazwę powiatu stacji.
+ */
+QString StationCatalog::districtName(const Station &station) const {
+    return names.at(station.district);
+}
+
+/**
+ * @brief Zwraca nazwę województwa stacji.
+ */
+QString StationCatalog::provinceName(const Station &station) const {
+    return names.at(station.province);
+}
+
+/**
+ * @brief Zwraca tekst wyświetlany stacji w formacie "<miasto> | <adres lub nazwa stacji>".
+ *
+ * Jeśli stacja nie ma adresu, używana jest jej nazwa; jeśli nie ma ani adresu, ani nazwy,
+ * zwracana jest sama nazwa miasta.
+ *
+ * @param station Rekord stacji.
+ * @return QString Tekst wyświetlany na liście stacji.
+ */
+QString StationCatalog::displayText(const Station &station) const {
+    QString display = cityName(station);
+    QString additionalInfo;
+
+    if (!station.addressStreet.trimmed().isEmpty()) {
+        additionalInfo = station.addressStreet;
+    } else if (!station.stationName.trimmed().isEmpty()) {
+        additionalInfo = station.stationName;
+    }
+    if (!additionalInfo.isEmpty()) {
+        display += " | " + additionalInfo;
+    }
+    return display;
+}
+
+/**
+ * @brief Sprawdza, czy stacja ma poprawne współrzędne geograficzne.
+ *
+ * @param station Rekord stacji.
+ * @return bool Wartość true, jeśli szerokość i długość geograficzna są znane.
+ */
+bool StationCatalog::hasLocation(const Station &station) {
+    return !qIsNaN(station.latitude) && !qIsNaN(station.longitude);
+}
+
+/**
+ * @brief Zwraca numer rewizji katalogu, zwiększany przy każdym wczytaniu danych.
+ *
+ * @return int Numer rewizji.
+ */
+int StationCatalog::revision() const {
+    return currentRevision;
+}
+
+/**
+ * @brief Zwraca indeks nazwy we wspólnej puli, dodając ją, jeśli wystąpiła po raz pierwszy.
+ *
+ * Gdy pula jest pełna (`MaxNames`), nowa nazwa nie jest dodawana, a zwracany jest indeks pustej nazwy
+ * (dodawanej jako pierwsza w `loadFromJson`), więc indeksy nie przekręcają się i nie wskazują innych nazw.
+ *
+ * @param name Nazwa (miasta, gminy, powiatu lub województwa).
+ * @return quint16 Indeks nazwy w puli `names`.
+ */
+quint16 StationCatalog::intern(const QString &name) {
+    auto it = nameIndex.constFind(name);
+    if (it != nameIndex.constEnd()) {
+        return it.value();
+    }
+    if (names.size() >= MaxNames) {
+        qWarning().noquote() << "Pula nazw katalogu stacji jest pełna, pominięto nazwę" << name;
+        return 0;
+    }
+    const quint16 index = static_cast<quint16>(names.size());
+    names.append(name);
+    nameIndex.insert(name, index);
+    return index;
+}
\ No newline at end of file
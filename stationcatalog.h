@@ -0,0 +1,130 @@
+/**
+ * @file stationcatalog.h
+ * @brief Definicja klasy StationCatalog - zwartego katalogu stacji pomiarowych.
+ */
+
+#ifndef STATIONCATALOG_H
+#define STATIONCATALOG_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class StationCatalog
+{
+public:
+    /**
+     * @brief Rekord stacji.
+     *
+     * Nazwy miasta, gminy, powiatu i województwa powtarzają się w wielu stacjach, dlatego rekord
+     * przechowuje jedynie ich 16-bitowe indeksy we wspólnej puli nazw katalogu.
+     */
+    struct Station {
+        int id;
+        float latitude;
+        float longitude;
+        quint16 city;
+        quint16 commune;
+        quint16 district;
+        quint16 province;
+        QString stationName;
+        QString addressStreet;
+    };
+
+    /**
+     * @brief Wczytuje katalog z tablicy JSON zwróconej przez `station/findAll`.
+     *
+     * Zastępuje dotychczasową zawartość katalogu i zwiększa jego numer rewizji.
+     *
+     * @param array Tablica JSON zawierająca dane stacji.
+     */
+    void loadFromJson(const QJsonArray &array);
+
+    /**
+     * @brief Zwraca liczbę stacji w katalogu.
+     *
+     * @return int Liczba stacji.
+     */
+    int size() const;
+
+    /**
+     * @brief Sprawdza, czy katalog jest pusty.
+     *
+     * @return bool Wartość true, jeśli katalog nie zawiera stacji.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Zwraca rekord stacji o podanej pozycji w katalogu.
+     *
+     * @param index Pozycja stacji (0..size()-1).
+     * @return const Station& Rekord stacji.
+     */
+    const Station &at(int index) const;
+
+    /**
+     * @brief Zwraca rekord stacji o podanym identyfikatorze (wyszukiwanie O(1)).
+     *
+     * @param stationId Identyfikator stacji.
+     * @return const Station* Wskaźnik na rekord stacji lub nullptr, jeśli stacji nie ma w katalogu.
+     */
+    const Station *find(int stationId) const;
+
+    /**
+     * @brief Zwraca nazwę miasta stacji.
+     */
+    QString cityName(const Station &station) const;
+
+    /**
+     * @brief Zwraca nazwę gminy stacji.
+     */
+    QString communeName(const Station &station) const;
+
+    /**
+     * @brief Zwraca nazwę powiatu stacji.
+     */
+    QString districtName(const Station &station) const;
+
+    /**
+     * @brief Zwraca nazwę województwa stacji.
+     */
+    QString provinceName(const Station &station) const;
+
+    /**
+     * @brief Zwraca tekst wyświetlany stacji w formacie "<miasto> | <adres lub nazwa stacji>".
+     *
+     * @param station Rekord stacji.
+     * @return QString Tekst wyświetlany na liście stacji.
+     */
+    QString displayText(const Station &station) const;
+
+    /**
+     * @brief Sprawdza, czy stacja ma poprawne współrzędne geograficzne.
+     *
+     * @param station Rekord stacji.
+     * @return bool Wartość true, jeśli szerokość i długość geograficzna są znane.
+     */
+    static bool hasLocation(const Station &station);
+
+    /**
+     * @brief Zwraca numer rewizji katalogu, zwiększany przy każdym wczytaniu danych.
+     *
+     * Pozwala obiektom zbudowanym na podstawie katalogu (np. indeksom) wykryć, że są nieaktualne.
+     *
+     * @return int Numer rewizji.
+     */
+    int revision() const;
+
+private:
+    quint16 intern(const QString &name);
+
+    QVector<Station> stations;
+    QStringList names;
+    QHash<QString, quint16> nameIndex;
+    QHash<int, int> indexForId;
+    int currentRevision = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,212 @@
+/**
+ * @file stationdatasync.cpp
+ * @brief Implementacja klasy StationDataSync do pakietowego pobierania czujników i danych wielu stacji.
+ */
+
+#include "stationdatasync.h"
+#include "apiclient.h"
+#include "apiendpoints.h"
+#include "datamanager.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+
+/**
+ * @brief Konstruktor klasy StationDataSync.
+ *
+ * Łączy sygnały `batchItemReady` i `batchFinished` obiektu `ApiClient` ze slotami tej klasy.
+ * Wyniki pakietów, których nie zlecił ten obiekt, są ignorowane.
+ *
+ * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+StationDataSync::StationDataSync(ApiClient *apiClient, QObject *parent)
+    : QObject(parent)
+    , apiClient(apiClient)
+    , priority(RequestScheduler::Prefetch)
+{
+    reset();
+    connect(apiClient, &ApiClient::batchItemReady, this, &StationDataSync::onBatchItemReady);
+    connect(apiClient, &ApiClient::batchFinished, this, &StationDataSync::onBatchFinished);
+}
+
+/**
+ * @brief Pobiera czujniki i najnowsze dane pomiarowe dla podanych stacji.
+ *
+ * Tworzy listę adresów `station/sensors/<id>` i zleca ją jako jeden pakiet. Wyniki wcześniej
+ * rozpoczętej synchronizacji, które nadejdą po tym wywołaniu, są ignorowane.
+ *
+ * @param stationIds Identyfikatory stacji.
+ * @param priority Klasa priorytetu żądań.
+ */
+void StationDataSync::syncStations(const QVector<int> &stationIds, RequestScheduler::Priority priority) {
+    QVector<QUrl> urls;
+    urls.reserve(stationIds.size());
+    for (int stationId : stationIds) {
+        urls.append(ApiEndpoints::sensors(stationId));
+    }
+
+    reset();
+    this->priority = priority;
+    batchStationIds = stationIds;
+    sensorsBatchId = apiClient->fetchBatch(urls, priority);
+    finishIfDone();
+}
+
+/**
+ * @brief Pobiera najnowsze dane pomiarowe podanych czujników.
+ *
+ * Pomija etap list czujników: adresy `data/getData/<id>` są od razu zlecane jako jeden pakiet pomiarów.
+ *
+ * @param sensorIds Identyfikatory czujników.
+ * @param priority Klasa priorytetu żądań.
+ */
+void StationDataSync::syncSensors(const QVector<int> &sensorIds, RequestScheduler::Priority priority) {
+    QVector<QUrl> urls;
+    urls.reserve(sensorIds.size());
+    for (int sensorId : sensorIds) {
+        urls.append(ApiEndpoints::measurements(sensorId));
+    }
+
+    reset();
+    this->priority = priority;
+    const int measurementsBatchId = apiClient->fetchBatch(urls, priority);
+    if (measurementsBatchId != -1) {
+        measurementBatches.insert(measurementsBatchId, sensorIds);
+        sensorsTotal = sensorIds.size();
+    }
+    finishIfDone();
+}
+
+/**
+ * @brief Pobiera listę wszystkich stacji, a następnie czujniki i najnowsze dane pomiarowe każdej z nich.
+ *
+ * Zleca pakiet z jednym adresem `station/findAll`; po jego nadejściu lista stacji jest zapisywana lokalnie,
+ * emitowany jest sygnał `stationsReceived`, a dla wszystkich stacji z listy rozpoczyna się `syncStations`.
+ */
+void StationDataSync::syncAll() {
+    reset();
+    priority = RequestScheduler::Backfill;
+    stationsBatchId = apiClient->fetchBatch({ApiEndpoints::stations()}, priority);
+}
+
+/**
+ * @brief Sprawdza, czy synchronizacja jest w toku.
+ *
+ * @return bool Wartość true, jeśli oczekiwane są jeszcze wyniki pakietu.
+ */
+bool StationDataSync::isRunning() const {
+    return stationsBatchId != -1 || sensorsBatchId != -1 || !measurementBatches.isEmpty();
+}
+
+/**
+ * @brief Obsługuje wynik pojedynczego żądania z pakietu.
+ *
+ * Dla pakietu stacji zapisuje listę stacji i rozpoczyna pobieranie czujników wszystkich stacji.
+ * Dla pakietu czujników zapisuje listę czujników stacji i od razu zleca pakiet danych pomiarowych jej
+ * czujników, dzięki czemu pobieranie pomiarów nie czeka na listy czujników pozostałych stacji.
+ * Dla pakietu pomiarów zapisuje dane pomiarowe czujnika jako dane historyczne.
+ *
+ * @param batchId Identyfikator pakietu.
+ * @param index Pozycja żądania w pakiecie.
+ * @param data Dane zwrócone w odpowiedzi na żądanie API.
+ */
+void StationDataSync::onBatchItemReady(int batchId, int index, const QString &data) {
+    const QByteArray bytes = data.toUtf8();
+
+    if (batchId == stationsBatchId) {
+        QJsonDocument doc = QJsonDocument::fromJson(bytes);
+        if (!doc.isArray()) {
+            return;
+        }
+        DataManager::saveHistoricalData("stations", bytes);
+        emit stationsReceived(bytes);
+        emit progress("stacje", 1, 1);
+
+        QVector<int> stationIds;
+        const QJsonArray stations = doc.array();
+        stationIds.reserve(stations.size());
+        for (const QJsonValue &value : stations) {
+            stationIds.append(value.toObject()["id"].toInt());
+        }
+        stationsBatchId = -1;
+        syncStations(stationIds, priority);
+    } else if (batchId == sensorsBatchId && index < batchStationIds.size()) {
+        QJsonDocument doc = QJsonDocument::fromJson(bytes);
+        if (doc.isArray()) {
+            DataManager::saveHistoricalData("sensors", bytes, batchStationIds.at(index));
+            QVector<int> sensorIds;
+            QVector<QUrl> urls;
+            for (const QJsonValue &value : doc.array()) {
+                const int sensorId = value.toObject()["id"].toInt();
+                sensorIds.append(sensorId);
+                urls.append(ApiEndpoints::measurements(sensorId));
+            }
+            const int measurementsBatchId = apiClient->fetchBatch(urls, priority);
+            if (measurementsBatchId != -1) {
+                measurementBatches.insert(measurementsBatchId, sensorIds);
+                sensorsTotal += sensorIds.size();
+            }
+            syncedStations++;
+        }
+        emit progress("czujniki", ++stationsDone, batchStationIds.size());
+    } else if (measurementBatches.contains(batchId)) {
+        const QVector<int> &sensorIds = measurementBatches[batchId];
+        if (index < sensorIds.size() && QJsonDocument::fromJson(bytes).isObject()) {
+            DataManager::saveHistoricalData("measurements", bytes, sensorIds.at(index));
+            syncedSensors++;
+        }
+        emit progress("pomiary", ++sensorsDone, sensorsTotal);
+    }
+}
+
+/**
+ * @brief Obsługuje zakończenie pakietu.
+ *
+ * Zlicza błędy pakietu i emituje sygnał `finished`, gdy zakończyły się pakiet czujników
+ * i wszystkie pakiety pomiarów.
+ *
+ * @param batchId Identyfikator pakietu.
+ * @param failedCount Liczba żądań pakietu zakończonych błędem.
+ */
+void StationDataSync::onBatchFinished(int batchId, int failedCount) {
+    if (batchId == stationsBatchId) {
+        stationsBatchId = -1;
+        failedItems += failedCount;
+        finishIfDone();
+    } else if (batchId == sensorsBatchId) {
+        sensorsBatchId = -1;
+        failedItems += failedCount;
+        finishIfDone();
+    } else if (measurementBatches.remove(batchId)) {
+        failedItems += failedCount;
+        finishIfDone();
+    }
+}
+
+/**
+ * @brief Zeruje stan synchronizacji (wyniki wcześniejszych pakietów będą ignorowane).
+ */
+void StationDataSync::reset() {
+    stationsBatchId = -1;
+    sensorsBatchId = -1;
+    stationsDone = 0;
+    sensorsDone = 0;
+    sensorsTotal = 0;
+    failedItems = 0;
+    syncedStations = 0;
+    syncedSensors = 0;
+    batchStationIds.clear();
+    measurementBatches.clear();
+}
+
+/**
+ * @brief Emituje sygnał `finished`, jeśli nie są oczekiwane wyniki żadnego pakietu.
+ */
+void StationDataSync::finishIfDone() {
+    if (!isRunning()) {
+        emit finished(syncedStations, syncedSensors, failedItems);
+    }
+}
\ No newline at end of file
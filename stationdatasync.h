@@ -0,0 +1,117 @@
+/**
+ * @file stationdatasync.h
+ * @brief Definicja klasy StationDataSync do pakietowego pobierania czujników i danych wielu stacji.
+ */
+
+#ifndef STATIONDATASYNC_H
+#define STATIONDATASYNC_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include "requestscheduler.h"
+
+class ApiClient;
+
+class StationDataSync : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy StationDataSync.
+     *
+     * Łączy sygnały pakietów `ApiClient` ze slotami obsługującymi kolejne etapy pobierania.
+     *
+     * @param apiClient Wskaźnik na obiekt ApiClient do wysyłania żądań API.
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit StationDataSync(ApiClient *apiClient, QObject *parent = nullptr);
+
+    /**
+     * @brief Pobiera czujniki i najnowsze dane pomiarowe dla podanych stacji.
+     *
+     * Pobiera jednym pakietem listy czujników wszystkich stacji, a dane pomiarowe czujników danej stacji
+     * zleca, gdy tylko nadejdzie jej lista czujników. Wyniki są zapisywane lokalnie (`DataManager`), więc
+     * są potem dostępne także w trybie offline. Wywołanie w trakcie trwającej synchronizacji zastępuje ją nową.
+     *
+     * @param stationIds Identyfikatory stacji.
+     * @param priority Klasa priorytetu żądań, domyślnie `RequestScheduler::Prefetch`.
+     */
+    void syncStations(const QVector<int> &stationIds, RequestScheduler::Priority priority = RequestScheduler::Prefetch);
+
+    /**
+     * @brief Pobiera najnowsze dane pomiarowe podanych czujników.
+     *
+     * Zleca jeden pakiet żądań `data/getData/<id>` i zapisuje wyniki lokalnie. Wywołanie w trakcie
+     * trwającej synchronizacji zastępuje ją nową.
+     *
+     * @param sensorIds Identyfikatory czujników.
+     * @param priority Klasa priorytetu żądań, domyślnie `RequestScheduler::Prefetch`.
+     */
+    void syncSensors(const QVector<int> &sensorIds, RequestScheduler::Priority priority = RequestScheduler::Prefetch);
+
+    /**
+     * @brief Pobiera listę wszystkich stacji, a następnie czujniki i najnowsze dane pomiarowe każdej z nich.
+     *
+     * Żądania mają klasę priorytetu `RequestScheduler::Backfill`, więc liczbę jednoczesnych połączeń
+     * i częstość żądań ogranicza kolejka `ApiWorker`, a kliknięcia użytkownika nie czekają za synchronizacją.
+     */
+    void syncAll();
+
+    /**
+     * @brief Sprawdza, czy synchronizacja jest w toku.
+     *
+     * @return bool Wartość true, jeśli oczekiwane są jeszcze wyniki pakietu.
+     */
+    bool isRunning() const;
+
+signals:
+    /**
+     * @brief Sygnał emitowany po obsłużeniu kolejnego żądania.
+     *
+     * @param stage Opis etapu ("stacje", "czujniki" lub "pomiary").
+     * @param done Liczba obsłużonych żądań etapu.
+     * @param total Liczba znanych żądań etapu (dla pomiarów rośnie wraz z pobieraniem list czujników).
+     */
+    void progress(const QString &stage, int done, int total);
+
+    /**
+     * @brief Sygnał emitowany po pobraniu listy wszystkich stacji w `syncAll`.
+     *
+     * @param data Lista stacji w formacie JSON.
+     */
+    void stationsReceived(const QByteArray &data);
+
+    /**
+     * @brief Sygnał emitowany po zakończeniu synchronizacji.
+     *
+     * @param stationCount Liczba stacji, dla których pobrano czujniki.
+     * @param sensorCount Liczba czujników, dla których pobrano dane pomiarowe.
+     * @param failedCount Liczba żądań zakończonych błędem.
+     */
+    void finished(int stationCount, int sensorCount, int failedCount);
+
+private slots:
+    void onBatchItemReady(int batchId, int index, const QString &data);
+    void onBatchFinished(int batchId, int failedCount);
+
+private:
+    void reset();
+    void finishIfDone();
+
+    ApiClient *apiClient;
+    RequestScheduler::Priority priority;
+    int stationsBatchId;
+    int sensorsBatchId;
+    int stationsDone;
+    int sensorsDone;
+    int sensorsTotal;
+    int failedItems;
+    int syncedStations;
+    int syncedSensors;
+    QVector<int> batchStationIds;
+    QHash<int, QVector<int>> measurementBatches;
+};
+
+#endif
\ No newline at end of file
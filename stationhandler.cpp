@@ -4,91 +4,74 @@
  */
 
 #include "stationhandler.h"
+#include "stationcatalog.h"
+#include "stationlistmodel.h"
+#include "stationsearchindex.h"
 
 /**
  * @brief Przetwarza dane stacji z tablicy JSON i aktualizuje listę stacji.
  * 
- * Czyści listę stacji (`stationList`) oraz wektor `allStations`, a następnie przetwarza tablicę JSON 
- * zawierającą dane stacji. Dla każdej stacji wyciąga nazwę stacji, miasto i adres, tworząc tekst 
- * wyświetlany w formacie "<miasto> | <adres lub nazwa stacji>". Zapisuje dane w wektorze `allStations` 
- * jako pary (tekst wyświetlany, obiekt JSON). Następnie wywołuje `updateStationList` w celu aktualizacji 
- * interfejsu użytkownika bez filtrowania.
+ * Wczytuje tablicę JSON do katalogu `catalog` (`StationCatalog`), który przechowuje zwarte rekordy 
+ * stacji zamiast pełnych obiektów JSON. Dla każdej stacji z katalogu tworzy tekst wyświetlany w formacie 
+ * "<miasto> | <adres lub nazwa stacji>". Jednorazowo buduje trigramowy indeks wyszukiwania rozmytego 
+ * (`StationSearchIndex`) po mieście, ulicy i nazwie stacji, a następnie przekazuje go wraz z parami 
+ * (tekst wyświetlany, identyfikator) do modelu `stationModel`, który jednorazowo je sortuje i wylicza 
+ * klucze wyszukiwania. Następnie wywołuje 
+ * `updateStationList` w celu aktualizacji interfejsu użytkownika bez filtrowania.
  * 
  * @param array Tablica JSON zawierająca dane stacji.
- * @param stationList Wskaźnik na `QListWidget`, w którym wyświetlane są nazwy stacji.
+ * @param stationModel Wskaźnik na model listy stacji.
+ * @param stationList Wskaźnik na `QListView`, w którym wyświetlane są nazwy stacji.
  * @param lblStationCount Wskaźnik na `QLabel` wyświetlający liczbę stacji.
- * @param allStations Referencja do listy przechowującej pary (tekst wyświetlany, obiekt JSON) dla wszystkich stacji.
+ * @param catalog Referencja do katalogu stacji.
  * @note Funkcja kończy działanie, jeśli tablica JSON jest pusta.
  */
-void StationHandler::handleStationsData(const QJsonArray &array, QListWidget *stationList, QLabel *lblStationCount, QList<QPair<QString, QJsonObject>> &allStations) {
+void StationHandler::handleStationsData(const QJsonArray &array, StationListModel *stationModel, QListView *stationList, QLabel *lblStationCount, StationCatalog &catalog) {
     if (array.isEmpty()) {
         return;
     }
 
-    stationList->clear();
-    allStations.clear();
+    catalog.loadFromJson(array);
+    QVector<QPair<QString, int>> listEntries;
+    QVector<StationSearchIndex::Document> searchDocuments;
+    listEntries.reserve(catalog.size());
+    searchDocuments.reserve(catalog.size());
 
-    for (const QJsonValue &value : array) {
-        QJsonObject obj = value.toObject();
-        QString name = obj["stationName"].toString();
-        QString city = obj["city"].toObject()["name"].toString();
-        QString address = obj["addressStreet"].toString();
-        QString display = city;
-        QString additionalInfo = "";
-
-        if (!address.trimmed().isEmpty()) {
-            additionalInfo = address;
-        } else if (!name.trimmed().isEmpty()) {
-            additionalInfo = name;
-        }
-        if (!additionalInfo.isEmpty()) {
-            display += " | " + additionalInfo;
-        }
-        allStations.append(qMakePair(display, obj));
+    for (int i = 0; i < catalog.size(); ++i) {
+        const StationCatalog::Station &station = catalog.at(i);
+        listEntries.append(qMakePair(catalog.displayText(station), station.id));
+        searchDocuments.append({catalog.cityName(station), station.addressStreet, station.stationName});
     }
-    updateStationList("", stationList, lblStationCount, allStations);
+
+    StationSearchIndex searchIndex;
+    searchIndex.build(searchDocuments);
+    stationModel->setStations(listEntries, searchIndex);
+    updateStationList("", stationModel, stationList, lblStationCount);
 }
 
 /**
  * @brief Aktualizuje listę stacji w interfejsie użytkownika na podstawie filtra.
  * 
- * Czyści listę stacji (`stationList`) i tworzy nową listę stacji na podstawie wektora `allStations`, 
- * uwzględniając podany filtr tekstowy (ignorując wielkość liter). Sortuje stacje alfabetycznie 
- * według tekstu wyświetlanego i dodaje je do `stationList` jako elementy `QListWidgetItem` 
- * z przypisanym identyfikatorem w danych użytkownika. Jeśli lista nie jest pusta, wybiera 
- * i podświetla pierwszy element. Aktualizuje etykietę `lblStationCount` z liczbą stacji.
+ * Przekazuje filtr do modelu `stationModel`, który przeszukuje wcześniej posortowany katalog 
+ * na podstawie kluczy wyliczonych przy jego budowie (bez względu na wielkość liter i znaki 
+ * diakrytyczne), więc ani sortowanie, ani tworzenie elementów listy nie jest powtarzane przy 
+ * każdym naciśnięciu klawisza. Jeśli lista nie jest pusta, wybiera i podświetla pierwszy element. 
+ * Aktualizuje etykietę `lblStationCount` z liczbą stacji.
  * 
  * @param filter Tekst filtra do wyszukiwania stacji (pusty filtr oznacza brak filtrowania).
- * @param stationList Wskaźnik na `QListWidget`, w którym wyświetlane są nazwy stacji.
+ * @param stationModel Wskaźnik na model listy stacji.
+ * @param stationList Wskaźnik na `QListView`, w którym wyświetlane są nazwy stacji.
  * @param lblStationCount Wskaźnik na `QLabel` wyświetlający liczbę stacji.
- * @param allStations Lista przechowująca pary (tekst wyświetlany, obiekt JSON) dla wszystkich stacji.
  */
-void StationHandler::updateStationList(const QString &filter, QListWidget *stationList, QLabel *lblStationCount, const QList<QPair<QString, QJsonObject>> &allStations) {
-    stationList->clear();
-    QList<QPair<QString, QJsonObject>> filteredStations;
-    for (const auto &pair : allStations) {
-        if (filter.isEmpty() || pair.first.toLower().contains(filter.toLower())) {
-            filteredStations.append(pair);
-        }
-    }
-
-    std::sort(filteredStations.begin(), filteredStations.end(), [](const auto &a, const auto &b) {
-        return a.first.toLower() < b.first.toLower();
-    });
+void StationHandler::updateStationList(const QString &filter, StationListModel *stationModel, QListView *stationList, QLabel *lblStationCount) {
+    stationModel->setFilter(filter);
 
-    for (const auto &pair : filteredStations) {
-        QListWidgetItem *item = new QListWidgetItem(pair.first);
-        item->setData(Qt::UserRole, pair.second["id"].toInt());
-        stationList->addItem(item);
-    }
-
-    if (stationList->count() > 0) {
-        stationList->setCurrentRow(0);
-        stationList->item(0)->setSelected(true);
+    if (stationModel->rowCount() > 0) {
+        stationList->setCurrentIndex(stationModel->index(0, 0));
     }
 
     QString labelText = filter.isEmpty()
-                            ? "Dostępne stacje [ " + QString::number(stationList->count()) + " ]"
-                            : "Wyszukane stacje [ " + QString::number(stationList->count()) + " ]";
+                            ? "Dostępne stacje [ " + QString::number(stationModel->rowCount()) + " ]"
+                            : "Wyszukane stacje [ " + QString::number(stationModel->rowCount()) + " ]";
     lblStationCount->setText(labelText);
-}
+}
\ No newline at end of file
@@ -7,12 +7,12 @@
 #define STATIONHANDLER_H
 
 #include <QJsonArray>
-#include <QListWidget>
+#include <QListView>
 #include <QLabel>
-#include <QJsonObject>
 #include <QString>
-#include <algorithm>
-#include <QJsonObject>
+
+class StationCatalog;
+class StationListModel;
 
 class StationHandler
 {
@@ -20,28 +20,31 @@ public:
     /**
      * @brief Przetwarza dane stacji z tablicy JSON i aktualizuje listę stacji.
      * 
-     * Przetwarza tablicę JSON z danymi stacji, tworząc listę stacji w formacie "<miasto> | <adres lub nazwa stacji>" 
-     * i zapisuje je w wektorze `allStations`. Aktualizuje interfejs użytkownika poprzez wywołanie `updateStationList`.
+     * Wczytuje tablicę JSON z danymi stacji do katalogu `catalog`, tworzy listę stacji w formacie
+     * "<miasto> | <adres lub nazwa stacji>", przekazuje ją do modelu `stationModel` i aktualizuje interfejs
+     * użytkownika poprzez wywołanie `updateStationList`.
      * 
      * @param array Tablica JSON zawierająca dane stacji.
-     * @param stationList Wskaźnik na `QListWidget`, w którym wyświetlane są nazwy stacji.
+     * @param stationModel Wskaźnik na model listy stacji.
+     * @param stationList Wskaźnik na `QListView`, w którym wyświetlane są nazwy stacji.
      * @param lblStationCount Wskaźnik na `QLabel` wyświetlający liczbę stacji.
-     * @param allStations Referencja do listy przechowującej pary (tekst wyświetlany, obiekt JSON) dla wszystkich stacji.
+     * @param catalog Referencja do katalogu stacji.
      */
-    static void handleStationsData(const QJsonArray &array, QListWidget *stationList, QLabel *lblStationCount, QList<QPair<QString, QJsonObject>> &allStations);
+    static void handleStationsData(const QJsonArray &array, StationListModel *stationModel, QListView *stationList, QLabel *lblStationCount, StationCatalog &catalog);
 
     /**
      * @brief Aktualizuje listę stacji w interfejsie użytkownika na podstawie filtra.
      * 
-     * Filtruje i sortuje stacje z listy `allStations` według podanego filtra tekstowego, 
-     * aktualizuje `stationList` i etykietę `lblStationCount` z liczbą stacji.
+     * Filtruje stacje w modelu `stationModel` według podanego filtra tekstowego (bez względu na wielkość
+     * liter i znaki diakrytyczne), zaznacza pierwszy wiersz w `stationList` i aktualizuje etykietę
+     * `lblStationCount` z liczbą stacji.
      * 
      * @param filter Tekst filtra do wyszukiwania stacji (pusty filtr oznacza brak filtrowania).
-     * @param stationList Wskaźnik na `QListWidget`, w którym wyświetlane są nazwy stacji.
+     * @param stationModel Wskaźnik na model listy stacji.
+     * @param stationList Wskaźnik na `QListView`, w którym wyświetlane są nazwy stacji.
      * @param lblStationCount Wskaźnik na `QLabel` wyświetlający liczbę stacji.
-     * @param allStations Lista przechowująca pary (tekst wyświetlany, obiekt JSON) dla wszystkich stacji.
      */
-    static void updateStationList(const QString &filter, QListWidget *stationList, QLabel *lblStationCount, const QList<QPair<QString, QJsonObject>> &allStations);
+    static void updateStationList(const QString &filter, StationListModel *stationModel, QListView *stationList, QLabel *lblStationCount);
 };
 
 #endif
\ No newline at end of file
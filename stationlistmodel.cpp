@@ -0,0 +1,224 @@
+/**
+ * @file stationlistmodel.cpp
+ * @brief Implementacja klasy StationListModel - modelu listy stacji z filtrowaniem przyrostowym.
+ */
+
+#include "stationlistmodel.h"
+#include "textnormalizer.h"
+
+#include <QCollator>
+#include <QLocale>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace {
+/** Liczba dopasowań rozmytych dołączanych po dopasowaniach dokładnych. */
+constexpr int FuzzyExtraLimit = 20;
+/** Liczba wyników zapytania z prefiksem pola. */
+constexpr int FieldQueryLimit = 500;
+/** Minimalna długość klucza, od której dołączane są dopasowania rozmyte. */
+constexpr int FuzzyMinKeyLength = 3;
+}
+
+/**
+ * @brief Konstruktor klasy StationListModel.
+ *
+ * Tworzy pusty model listy stacji.
+ *
+ * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+ */
+StationListModel::StationListModel(QObject *parent) : QAbstractListModel(parent) {}
+
+/**
+ * @brief Zwraca liczbę stacji widocznych po zastosowaniu filtra.
+ *
+ * @param parent Indeks rodzica (model jest płaski, więc dla poprawnego rodzica zwracane jest 0).
+ * @return int Liczba widocznych wierszy.
+ */
+int StationListModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) return 0;
+    return visibleRows.size();
+}
+
+/**
+ * @brief Zwraca dane wiersza dla podanej roli.
+ *
+ * Dla roli `Qt::DisplayRole` zwraca tekst wyświetlany stacji, a dla `Qt::UserRole` jej identyfikator,
+ * zgodnie z konwencją stosowaną wcześniej w elementach `QListWidgetItem`.
+ *
+ * @param index Indeks wiersza.
+ * @param role Rola danych.
+ * @return QVariant Dane wiersza lub pusty QVariant.
+ */
+QVariant StationListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= visibleRows.size()) {
+        return QVariant();
+    }
+
+    const Entry &entry = entries.at(visibleRows.at(index.row()));
+    if (role == Qt::DisplayRole) {
+        auto suffix = rowSuffixes.constFind(index.row());
+        return suffix == rowSuffixes.constEnd() ? entry.display : entry.display + suffix.value();
+    }
+    if (role == Qt::UserRole) return entry.stationId;
+    return QVariant();
+}
+
+/**
+ * @brief Ustawia pełny katalog stacji.
+ *
+ * Dla każdej stacji jednorazowo wylicza klucz wyszukiwania (`TextNormalizer::fold`) oraz klucz
+ * sortowania `QCollator` dla języka polskiego, sortuje tablicę i od tego momentu traktuje ją jako
+ * niezmienną. Filtrowanie operuje wyłącznie na indeksach do tej tablicy. Zapamiętuje odwzorowanie
+ * numerów dokumentów indeksu `searchIndex` na pozycje w posortowanej tablicy.
+ *
+ * @param stations Lista par (tekst wyświetlany, identyfikator stacji).
+ * @param searchIndex Trigramowy indeks pól stacji zbudowany w tej samej kolejności co `stations`.
+ */
+void StationListModel::setStations(const QVector<QPair<QString, int>> &stations, const StationSearchIndex &searchIndex) {
+    QCollator collator(QLocale(QLocale::Polish, QLocale::Poland));
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+
+    QVector<QCollatorSortKey> sortKeys;
+    sortKeys.reserve(stations.size());
+    for (const auto &station : stations) {
+        sortKeys.append(collator.sortKey(station.first));
+    }
+
+    QVector<int> order(stations.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](int a, int b) {
+        return sortKeys.at(a).compare(sortKeys.at(b)) < 0;
+    });
+
+    beginResetModel();
+    entries.clear();
+    entries.reserve(stations.size());
+    entryForStation.clear();
+    rowSuffixes.clear();
+    entryForDocument.resize(stations.size());
+    for (int i : order) {
+        const auto &station = stations.at(i);
+        entryForDocument[i] = entries.size();
+        entryForStation.insert(station.second, entries.size());
+        entries.append({station.second, station.first, TextNormalizer::fold(station.first)});
+    }
+    this->searchIndex = searchIndex;
+
+    visibleRows.resize(entries.size());
+    std::iota(visibleRows.begin(), visibleRows.end(), 0);
+    substringRows = visibleRows;
+    substringFilterKey.clear();
+    currentFilterKey.clear();
+    showingStations = false;
+    endResetModel();
+}
+
+/**
+ * @brief Filtruje listę stacji według podanego tekstu.
+ *
+ * Porównanie odbywa się na kluczach wyznaczonych w `setStations`, więc w trakcie filtrowania nie są
+ * tworzone żadne nowe napisy poza kluczem samego zapytania. Jeśli nowy klucz zawiera poprzedni,
+ * każda pasująca stacja musiała pasować również wcześniej, dlatego przeszukiwany jest tylko
+ * poprzedni wynik. Kolejność wierszy wynika z kolejności tablicy, więc sortowanie nie jest powtarzane.
+ * Dla kluczy o długości co najmniej `FuzzyMinKeyLength` na końcu listy dołączane są najlepiej ocenione
+ * dopasowania rozmyte z indeksu, których nie ma wśród dopasowań dokładnych. Zapytania z prefiksem pola
+ * są przekazywane wprost do indeksu, a wynik jest wyświetlany w kolejności trafności. Ten sam filtr jest
+ * pomijany, chyba że wyświetlana jest lista z `showStations` - wtedy filtr przywraca zwykły widok.
+ *
+ * @param filter Tekst filtra (pusty filtr oznacza brak filtrowania).
+ */
+void StationListModel::setFilter(const QString &filter) {
+    const QString key = TextNormalizer::fold(filter);
+    if (key == currentFilterKey && !showingStations) return;
+
+    QVector<int> rows;
+    if (StationSearchIndex::hasFieldPrefix(filter)) {
+        const QVector<StationSearchIndex::Match> matches = searchIndex.search(filter, FieldQueryLimit);
+        rows.reserve(matches.size());
+        for (const auto &match : matches) {
+            rows.append(entryForDocument.at(match.document));
+        }
+        substringRows.clear();
+        substringFilterKey.clear();
+    } else {
+        QVector<int> matched;
+        if (key.isEmpty()) {
+            matched.resize(entries.size());
+            std::iota(matched.begin(), matched.end(), 0);
+        } else if (!substringFilterKey.isEmpty() && key.contains(substringFilterKey)) {
+            matched.reserve(substringRows.size());
+            for (int row : std::as_const(substringRows)) {
+                if (entries.at(row).searchKey.contains(key)) matched.append(row);
+            }
+        } else {
+            for (int row = 0; row < entries.size(); ++row) {
+                if (entries.at(row).searchKey.contains(key)) matched.append(row);
+            }
+        }
+
+        rows = matched;
+        if (key.size() >= FuzzyMinKeyLength) {
+            const QVector<StationSearchIndex::Match> matches = searchIndex.search(filter, FuzzyExtraLimit);
+            for (const auto &match : matches) {
+                const int row = entryForDocument.at(match.document);
+                if (!std::binary_search(matched.cbegin(), matched.cend(), row)) rows.append(row);
+            }
+        }
+        substringRows = std::move(matched);
+        substringFilterKey = key;
+    }
+
+    beginResetModel();
+    visibleRows = std::move(rows);
+    rowSuffixes.clear();
+    currentFilterKey = key;
+    showingStations = false;
+    endResetModel();
+}
+
+/**
+ * @brief Wyświetla wyłącznie podane stacje, w podanej kolejności.
+ *
+ * Stacje nieobecne w katalogu są pomijane. Dopiski są przechowywane dla widocznych wierszy
+ * i dołączane do tekstu wyświetlanego w `data`. Stan filtra przyrostowego jest zerowany, więc
+ * następne wywołanie `setFilter` przeszukuje cały katalog.
+ *
+ * @param stations Lista par (identyfikator stacji, dopisek do tekstu wyświetlanego).
+ */
+void StationListModel::showStations(const QVector<QPair<int, QString>> &stations) {
+    beginResetModel();
+    visibleRows.clear();
+    rowSuffixes.clear();
+    for (const auto &station : stations) {
+        auto entry = entryForStation.constFind(station.first);
+        if (entry == entryForStation.constEnd()) continue;
+        if (!station.second.isEmpty()) rowSuffixes.insert(visibleRows.size(), station.second);
+        visibleRows.append(entry.value());
+    }
+    substringRows.clear();
+    substringFilterKey.clear();
+    showingStations = true;
+    endResetModel();
+}
+
+/**
+ * @brief Zwraca identyfikator stacji w podanym widocznym wierszu.
+ *
+ * @param row Numer wiersza.
+ * @return int Identyfikator stacji lub -1, jeśli wiersz jest poza zakresem.
+ */
+int StationListModel::stationIdAt(int row) const {
+    if (row < 0 || row >= visibleRows.size()) return -1;
+    return entries.at(visibleRows.at(row)).stationId;
+}
+
+/**
+ * @brief Zwraca liczbę wszystkich stacji w katalogu (niezależnie od filtra).
+ *
+ * @return int Liczba stacji.
+ */
+int StationListModel::totalCount() const {
+    return entries.size();
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/**
+ * @file stationlistmodel.h
+ * @brief Definicja klasy StationListModel - modelu listy stacji z filtrowaniem przyrostowym.
+ */
+
+#ifndef STATIONLISTMODEL_H
+#define STATIONLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
+#include <QPair>
+#include <QString>
+#include "stationsearchindex.h"
+
+class StationListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy StationListModel.
+     *
+     * Tworzy pusty model listy stacji.
+     *
+     * @param parent Wskaźnik na obiekt nadrzędny (QObject), domyślnie nullptr.
+     */
+    explicit StationListModel(QObject *parent = nullptr);
+
+    /**
+     * @brief Zwraca liczbę stacji widocznych po zastosowaniu filtra.
+     *
+     * @param parent Indeks rodzica (model jest płaski, więc dla poprawnego rodzica zwracane jest 0).
+     * @return int Liczba widocznych wierszy.
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @brief Zwraca dane wiersza dla podanej roli.
+     *
+     * Dla roli `Qt::DisplayRole` zwraca tekst wyświetlany stacji, a dla `Qt::UserRole` jej identyfikator.
+     *
+     * @param index Indeks wiersza.
+     * @param role Rola danych.
+     * @return QVariant Dane wiersza lub pusty QVariant.
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Ustawia pełny katalog stacji.
+     *
+     * Buduje niezmienną tablicę stacji posortowaną według polskiej kolacji, z wyliczonymi jednorazowo
+     * kluczami wyszukiwania (bez wielkości liter i znaków diakrytycznych). Przejmuje indeks wyszukiwania
+     * rozmytego, którego numery dokumentów odpowiadają pozycjom w `stations`. Resetuje bieżący filtr.
+     *
+     * @param stations Lista par (tekst wyświetlany, identyfikator stacji).
+     * @param searchIndex Trigramowy indeks pól stacji zbudowany w tej samej kolejności co `stations`.
+     */
+    void setStations(const QVector<QPair<QString, int>> &stations, const StationSearchIndex &searchIndex = StationSearchIndex());
+
+    /**
+     * @brief Filtruje listę stacji według podanego tekstu.
+     *
+     * Jeśli nowy filtr zawiera poprzedni (zawężenie zapytania), przeszukiwane są tylko wiersze
+     * z poprzedniego wyniku. W przeciwnym razie przeszukiwany jest cały katalog. Po stacjach
+     * zawierających filtr dołączane są dopasowania rozmyte z indeksu (literówki, brak polskich znaków),
+     * a zapytania z prefiksem pola ("miasto:", "ulica:", "nazwa:") są obsługiwane wyłącznie przez indeks.
+     *
+     * @param filter Tekst filtra (pusty filtr oznacza brak filtrowania).
+     */
+    void setFilter(const QString &filter);
+
+    /**
+     * @brief Wyświetla wyłącznie podane stacje, w podanej kolejności.
+     *
+     * Służy do prezentacji wyników spoza wyszukiwania tekstowego (np. najbliższych stacji). Do tekstu
+     * wyświetlanego każdej stacji dołączany jest podany dopisek (np. odległość). Kolejne wywołanie
+     * `setFilter` przywraca zwykłe filtrowanie.
+     *
+     * @param stations Lista par (identyfikator stacji, dopisek do tekstu wyświetlanego).
+     */
+    void showStations(const QVector<QPair<int, QString>> &stations);
+
+    /**
+     * @brief Zwraca identyfikator stacji w podanym widocznym wierszu.
+     *
+     * @param row Numer wiersza.
+     * @return int Identyfikator stacji lub -1, jeśli wiersz jest poza zakresem.
+     */
+    int stationIdAt(int row) const;
+
+    /**
+     * @brief Zwraca liczbę wszystkich stacji w katalogu (niezależnie od filtra).
+     *
+     * @return int Liczba stacji.
+     */
+    int totalCount() const;
+
+private:
+    struct Entry {
+        int stationId;
+        QString display;
+        QString searchKey;
+    };
+
+    QVector<Entry> entries;
+    QHash<int, int> entryForStation;
+    QHash<int, QString> rowSuffixes;
+    QVector<int> entryForDocument;
+    QVector<int> substringRows;
+    QVector<int> visibleRows;
+    QString substringFilterKey;
+    QString currentFilterKey;
+    bool showingStations = false;
+    StationSearchIndex searchIndex;
+};
+
+#endif
\ No newline at end of file
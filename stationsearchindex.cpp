@@ -0,0 +1,254 @@
+/**
+ * @file stationsearchindex.cpp
+ * @brief Implementacja klasy StationSearchIndex - trigramowego indeksu odwróconego do wyszukiwania stacji.
+ */
+
+#include "stationsearchindex.h"
+#include "textnormalizer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+/** Minimalny udział trigramów słowa zapytania, które muszą wystąpić w polu dokumentu. */
+constexpr float MinContainment = 0.5f;
+/** Maksymalna liczba słów zapytania branych pod uwagę. */
+constexpr int MaxTerms = 16;
+
+struct FieldPrefix {
+    const char *prefix;
+    StationSearchIndex::Field field;
+};
+
+const FieldPrefix fieldPrefixes[] = {
+    {"city", StationSearchIndex::City},
+    {"miasto", StationSearchIndex::City},
+    {"street", StationSearchIndex::Street},
+    {"ulica", StationSearchIndex::Street},
+    {"name", StationSearchIndex::Name},
+    {"nazwa", StationSearchIndex::Name},
+};
+
+int fieldForPrefix(const QString &prefix) {
+    for (const FieldPrefix &entry : fieldPrefixes) {
+        if (prefix.compare(QLatin1String(entry.prefix), Qt::CaseInsensitive) == 0) {
+            return entry.field;
+        }
+    }
+    return -1;
+}
+}
+
+/**
+ * @brief Buduje indeks dla podanych dokumentów.
+ *
+ * Dla każdego pola każdego dokumentu wyznacza zbiór unikalnych trigramów znormalizowanych słów
+ * i dopisuje numer dokumentu do list wystąpień tych trigramów. Ponieważ dokumenty są przetwarzane
+ * po kolei, listy wystąpień są posortowane bez dodatkowego sortowania. Zapamiętywana jest też liczba
+ * trigramów pola, używana przy ocenie dopasowania.
+ *
+ * @param documents Lista dokumentów do zaindeksowania.
+ */
+void StationSearchIndex::build(const QVector<Document> &documents) {
+    indexedDocuments = documents.size();
+    for (int field = 0; field < FieldCount; ++field) {
+        postings[field].clear();
+        trigramCounts[field].fill(0, documents.size());
+    }
+
+    QVector<quint64> trigrams;
+    for (int doc = 0; doc < documents.size(); ++doc) {
+        const QString texts[FieldCount] = {documents.at(doc).city, documents.at(doc).street, documents.at(doc).name};
+        for (int field = 0; field < FieldCount; ++field) {
+            trigrams.clear();
+            const QStringList words = splitWords(TextNormalizer::fold(texts[field]));
+            for (const QString &word : words) {
+                appendTrigrams(word, trigrams);
+            }
+            std::sort(trigrams.begin(), trigrams.end());
+            trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+            trigramCounts[field][doc] = static_cast<quint16>(qMin<qsizetype>(trigrams.size(), 0xFFFF));
+            for (quint64 trigram : trigrams) {
+                postings[field][trigram].append(doc);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Wyszukuje dokumenty pasujące do zapytania i zwraca je w kolejności trafności.
+ *
+ * Dla każdego słowa zapytania zlicza, ile jego trigramów występuje w danym polu dokumentu (przechodząc
+ * wyłącznie po listach wystąpień trigramów zapytania, a nie po wszystkich dokumentach). Ocena słowa
+ * to głównie udział trafionych trigramów słowa, z niewielką premią dla krótszych pól; dla słów bez
+ * prefiksu pola brane jest najlepsze pole. Dokument trafia do wyników tylko wtedy, gdy każde słowo
+ * osiągnęło próg `MinContainment`, a jego ocena końcowa jest średnią ocen słów.
+ *
+ * @param query Tekst zapytania.
+ * @param limit Maksymalna liczba zwracanych wyników.
+ * @return QVector<Match> Wyniki posortowane malejąco według oceny.
+ */
+QVector<StationSearchIndex::Match> StationSearchIndex::search(const QString &query, int limit) const {
+    const QVector<Term> terms = parseQuery(query);
+    if (terms.isEmpty() || indexedDocuments == 0 || limit <= 0) {
+        return {};
+    }
+
+    QVector<float> totalScore(indexedDocuments, 0.0f);
+    QVector<float> termScore(indexedDocuments, 0.0f);
+    QVector<quint16> hits(indexedDocuments, 0);
+    QVector<quint8> matchedTerms(indexedDocuments, 0);
+    QVector<int> fieldTouched;
+    QVector<int> termTouched;
+
+    for (int termIndex = 0; termIndex < terms.size(); ++termIndex) {
+        const Term &term = terms.at(termIndex);
+        const float termTrigrams = static_cast<float>(term.trigrams.size());
+        termTouched.clear();
+
+        for (int field = 0; field < FieldCount; ++field) {
+            if (!term.fields[field]) continue;
+
+            fieldTouched.clear();
+            for (quint64 trigram : term.trigrams) {
+                auto it = postings[field].constFind(trigram);
+                if (it == postings[field].constEnd()) continue;
+                for (int doc : it.value()) {
+                    if (matchedTerms.at(doc) != termIndex) continue;
+                    if (hits[doc]++ == 0) fieldTouched.append(doc);
+                }
+            }
+
+            for (int doc : std::as_const(fieldTouched)) {
+                const float containment = hits.at(doc) / termTrigrams;
+                const float density = static_cast<float>(hits.at(doc)) / qMax<int>(1, trigramCounts[field].at(doc));
+                const float score = containment * 0.9f + qMin(1.0f, density) * 0.1f;
+                hits[doc] = 0;
+                if (containment < MinContainment || score <= termScore.at(doc)) continue;
+                if (termScore.at(doc) == 0.0f) termTouched.append(doc);
+                termScore[doc] = score;
+            }
+        }
+
+        for (int doc : std::as_const(termTouched)) {
+            totalScore[doc] += termScore.at(doc);
+            matchedTerms[doc] = static_cast<quint8>(termIndex + 1);
+            termScore[doc] = 0.0f;
+        }
+    }
+
+    QVector<Match> matches;
+    matches.reserve(termTouched.size());
+    for (int doc : std::as_const(termTouched)) {
+        matches.append({doc, totalScore.at(doc) / terms.size()});
+    }
+
+    auto byScore = [](const Match &a, const Match &b) {
+        return a.score != b.score ? a.score > b.score : a.document < b.document;
+    };
+    if (matches.size() > limit) {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), byScore);
+        matches.resize(limit);
+    } else {
+        std::sort(matches.begin(), matches.end(), byScore);
+    }
+    return matches;
+}
+
+/**
+ * @brief Sprawdza, czy zapytanie zawiera prefiks pola.
+ *
+ * @param query Tekst zapytania.
+ * @return bool Wartość true, jeśli którekolwiek słowo zapytania ma prefiks pola.
+ */
+bool StationSearchIndex::hasFieldPrefix(const QString &query) {
+    const QStringList tokens = query.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+    for (const QString &token : tokens) {
+        const int colon = token.indexOf(QLatin1Char(':'));
+        if (colon > 0 && fieldForPrefix(token.left(colon)) >= 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Zwraca liczbę zaindeksowanych dokumentów.
+ *
+ * @return int Liczba dokumentów.
+ */
+int StationSearchIndex::documentCount() const {
+    return indexedDocuments;
+}
+
+/**
+ * @brief Dzieli znormalizowany tekst na słowa złożone z liter i cyfr.
+ *
+ * @param foldedText Tekst po normalizacji.
+ * @return QStringList Lista słów.
+ */
+QStringList StationSearchIndex::splitWords(const QString &foldedText) {
+    QStringList words;
+    int start = -1;
+    for (int i = 0; i <= foldedText.size(); ++i) {
+        const bool isWordChar = i < foldedText.size() && foldedText.at(i).isLetterOrNumber();
+        if (isWordChar && start < 0) {
+            start = i;
+        } else if (!isWordChar && start >= 0) {
+            words.append(foldedText.mid(start, i - start));
+            start = -1;
+        }
+    }
+    return words;
+}
+
+/**
+ * @brief Dopisuje trigramy słowa (dopełnionego spacjami z obu stron) do wektora.
+ *
+ * Trigram jest kodowany jako 64-bitowa liczba złożona z trzech 16-bitowych znaków.
+ *
+ * @param word Słowo po normalizacji.
+ * @param trigrams Wektor, do którego dopisywane są trigramy.
+ */
+void StationSearchIndex::appendTrigrams(const QString &word, QVector<quint64> &trigrams) {
+    const QString padded = QLatin1Char(' ') + word + QLatin1Char(' ');
+    for (int i = 0; i + 2 < padded.size(); ++i) {
+        trigrams.append((quint64(padded.at(i).unicode()) << 32)
+                        | (quint64(padded.at(i + 1).unicode()) << 16)
+                        | quint64(padded.at(i + 2).unicode()));
+    }
+}
+
+/**
+ * @brief Rozbija zapytanie na słowa z przypisanymi polami i trigramami.
+ *
+ * @param query Tekst zapytania.
+ * @return QVector<Term> Lista słów zapytania (co najwyżej `MaxTerms`).
+ */
+QVector<StationSearchIndex::Term> StationSearchIndex::parseQuery(const QString &query) {
+    QVector<Term> terms;
+    const QStringList tokens = query.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+
+    for (const QString &token : tokens) {
+        QString text = token;
+        int onlyField = -1;
+        const int colon = token.indexOf(QLatin1Char(':'));
+        if (colon > 0) {
+            onlyField = fieldForPrefix(token.left(colon));
+            if (onlyField >= 0) text = token.mid(colon + 1);
+        }
+
+        const QStringList words = splitWords(TextNormalizer::fold(text));
+        for (const QString &word : words) {
+            Term term;
+            appendTrigrams(word, term.trigrams);
+            std::sort(term.trigrams.begin(), term.trigrams.end());
+            term.trigrams.erase(std::unique(term.trigrams.begin(), term.trigrams.end()), term.trigrams.end());
+            for (int field = 0; field < FieldCount; ++field) {
+                term.fields[field] = onlyField < 0 || onlyField == field;
+            }
+            terms.append(term);
+            if (terms.size() == MaxTerms) return terms;
+        }
+    }
+    return terms;
+}
\ No newline at end of file
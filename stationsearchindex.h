@@ -0,0 +1,99 @@
+/**
+ * @file stationsearchindex.h
+ * @brief Definicja klasy StationSearchIndex - trigramowego indeksu odwróconego do wyszukiwania stacji.
+ */
+
+#ifndef STATIONSEARCHINDEX_H
+#define STATIONSEARCHINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class StationSearchIndex
+{
+public:
+    /**
+     * @brief Pola stacji objęte indeksem.
+     */
+    enum Field {
+        City = 0,
+        Street = 1,
+        Name = 2,
+        FieldCount = 3
+    };
+
+    /**
+     * @brief Dokument indeksu - teksty pól jednej stacji.
+     */
+    struct Document {
+        QString city;
+        QString street;
+        QString name;
+    };
+
+    /**
+     * @brief Wynik wyszukiwania - numer dokumentu i jego ocena (0..1).
+     */
+    struct Match {
+        int document;
+        float score;
+    };
+
+    /**
+     * @brief Buduje indeks dla podanych dokumentów.
+     *
+     * Każde pole jest normalizowane (`TextNormalizer::fold`), dzielone na słowa, a każde słowo
+     * na trigramy z dopełnieniem spacją z obu stron. Dla każdego trigramu i pola zapisywana jest
+     * posortowana lista numerów dokumentów. Numer dokumentu odpowiada jego pozycji w `documents`.
+     *
+     * @param documents Lista dokumentów do zaindeksowania.
+     */
+    void build(const QVector<Document> &documents);
+
+    /**
+     * @brief Wyszukuje dokumenty pasujące do zapytania i zwraca je w kolejności trafności.
+     *
+     * Zapytanie składa się ze słów rozdzielonych spacjami. Słowo może być poprzedzone prefiksem pola
+     * ("city:", "street:", "name:" lub polskimi odpowiednikami "miasto:", "ulica:", "nazwa:"),
+     * ograniczającym dopasowanie do tego pola. Dokument musi pasować do każdego słowa; dopasowanie
+     * jest rozmyte, więc toleruje literówki i brak polskich znaków.
+     *
+     * @param query Tekst zapytania.
+     * @param limit Maksymalna liczba zwracanych wyników.
+     * @return QVector<Match> Wyniki posortowane malejąco według oceny.
+     */
+    QVector<Match> search(const QString &query, int limit = 50) const;
+
+    /**
+     * @brief Sprawdza, czy zapytanie zawiera prefiks pola.
+     *
+     * @param query Tekst zapytania.
+     * @return bool Wartość true, jeśli którekolwiek słowo zapytania ma prefiks pola.
+     */
+    static bool hasFieldPrefix(const QString &query);
+
+    /**
+     * @brief Zwraca liczbę zaindeksowanych dokumentów.
+     *
+     * @return int Liczba dokumentów.
+     */
+    int documentCount() const;
+
+private:
+    struct Term {
+        QVector<quint64> trigrams;
+        bool fields[FieldCount];
+    };
+
+    static QStringList splitWords(const QString &foldedText);
+    static void appendTrigrams(const QString &word, QVector<quint64> &trigrams);
+    static QVector<Term> parseQuery(const QString &query);
+
+    QHash<quint64, QVector<int>> postings[FieldCount];
+    QVector<quint16> trigramCounts[FieldCount];
+    int indexedDocuments = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,261 @@
+/**
+ * @file stationspatialindex.cpp
+ * @brief Implementacja klasy StationSpatialIndex - drzewa k-d współrzędnych stacji.
+ */
+
+#include "stationspatialindex.h"
+
+#include <QtMath>
+#include <algorithm>
+#include <queue>
+
+namespace {
+/** Średni promień Ziemi w kilometrach. */
+constexpr double EarthRadiusKm = 6371.0088;
+
+struct HeapEntry {
+    double squaredDistance;
+    int location;
+    bool operator<(const HeapEntry &other) const { return squaredDistance < other.squaredDistance; }
+};
+}
+
+/**
+ * @brief Buduje indeks dla podanych położeń stacji.
+ *
+ * Drzewo jest zapisane niejawnie w tablicy `tree`: dla zakresu [begin, end) element środkowy jest
+ * węzłem dzielącym, lewa połowa to lewe poddrzewo, a prawa - prawe. Oś podziału zmienia się cyklicznie
+ * (x, y, z). Dodatkowo budowana jest lista stacji posortowana według szerokości geograficznej
+ * na potrzeby zapytań prostokątnych.
+ *
+ * @param locations Lista położeń stacji.
+ */
+void StationSpatialIndex::build(const QVector<Location> &locations) {
+    this->locations = locations;
+    tree.clear();
+    tree.reserve(locations.size());
+    byLatitude.clear();
+    byLatitude.reserve(locations.size());
+    locationForStation.clear();
+
+    for (int i = 0; i < locations.size(); ++i) {
+        Point point;
+        toUnitVector(locations.at(i).latitude, locations.at(i).longitude, point.coords);
+        point.location = i;
+        tree.append(point);
+        byLatitude.append(i);
+        locationForStation.insert(locations.at(i).stationId, i);
+    }
+
+    buildRange(0, tree.size(), 0);
+    std::sort(byLatitude.begin(), byLatitude.end(), [this](int a, int b) {
+        return this->locations.at(a).latitude < this->locations.at(b).latitude;
+    });
+}
+
+/**
+ * @brief Zwraca `k` stacji najbliższych podanemu punktowi, od najbliższej.
+ *
+ * Przeszukuje drzewo w głąb, najpierw po stronie podziału zawierającej punkt, utrzymując kopiec
+ * `k` najlepszych kandydatów. Druga strona podziału jest odwiedzana tylko wtedy, gdy odległość
+ * od płaszczyzny podziału jest mniejsza niż najgorszy z kandydatów.
+ *
+ * @param latitude Szerokość geograficzna punktu.
+ * @param longitude Długość geograficzna punktu.
+ * @param k Liczba szukanych stacji.
+ * @param excludeStationId Identyfikator stacji pomijanej w wynikach, domyślnie -1.
+ * @return QVector<Neighbor> Najbliższe stacje posortowane rosnąco według odległości.
+ */
+QVector<StationSpatialIndex::Neighbor> StationSpatialIndex::nearest(double latitude, double longitude, int k, int excludeStationId) const {
+    QVector<Neighbor> result;
+    if (k <= 0 || tree.isEmpty()) return result;
+
+    double target[3];
+    toUnitVector(latitude, longitude, target);
+    std::priority_queue<HeapEntry> best;
+
+    struct Range { int begin; int end; int depth; };
+    QVector<Range> stack;
+    stack.append({0, static_cast<int>(tree.size()), 0});
+
+    while (!stack.isEmpty()) {
+        const Range range = stack.takeLast();
+        if (range.begin >= range.end) continue;
+
+        const int mid = range.begin + (range.end - range.begin) / 2;
+        const Point &point = tree.at(mid);
+        if (locations.at(point.location).stationId != excludeStationId) {
+            const double distance = squaredChord(point.coords, target);
+            if (static_cast<int>(best.size()) < k) {
+                best.push({distance, point.location});
+            } else if (distance < best.top().squaredDistance) {
+                best.pop();
+                best.push({distance, point.location});
+            }
+        }
+
+        const int axis = range.depth % 3;
+        const double delta = target[axis] - point.coords[axis];
+        const Range nearSide = delta < 0 ? Range{range.begin, mid, range.depth + 1} : Range{mid + 1, range.end, range.depth + 1};
+        const Range farSide = delta < 0 ? Range{mid + 1, range.end, range.depth + 1} : Range{range.begin, mid, range.depth + 1};
+
+        if (static_cast<int>(best.size()) < k || delta * delta < best.top().squaredDistance) {
+            stack.append(farSide);
+        }
+        stack.append(nearSide);
+    }
+
+    result.resize(static_cast<int>(best.size()));
+    for (int i = result.size() - 1; i >= 0; --i) {
+        result[i] = {locations.at(best.top().location).stationId, chordToKm(best.top().squaredDistance)};
+        best.pop();
+    }
+    return result;
+}
+
+/**
+ * @brief Zwraca wszystkie stacje w podanej odległości od punktu, od najbliższej.
+ *
+ * Promień jest zamieniany na długość cięciwy, a poddrzewa leżące w całości dalej od płaszczyzny
+ * podziału niż ta długość są pomijane.
+ *
+ * @param latitude Szerokość geograficzna punktu.
+ * @param longitude Długość geograficzna punktu.
+ * @param radiusKm Promień w kilometrach.
+ * @return QVector<Neighbor> Stacje posortowane rosnąco według odległości.
+ */
+QVector<StationSpatialIndex::Neighbor> StationSpatialIndex::withinRadius(double latitude, double longitude, double radiusKm) const {
+    QVector<Neighbor> result;
+    if (radiusKm < 0 || tree.isEmpty()) return result;
+
+    double target[3];
+    toUnitVector(latitude, longitude, target);
+    const double chord = 2.0 * qSin(qMin(M_PI, radiusKm / EarthRadiusKm) / 2.0);
+    const double limit = chord * chord;
+
+    struct Range { int begin; int end; int depth; };
+    QVector<Range> stack;
+    stack.append({0, static_cast<int>(tree.size()), 0});
+
+    while (!stack.isEmpty()) {
+        const Range range = stack.takeLast();
+        if (range.begin >= range.end) continue;
+
+        const int mid = range.begin + (range.end - range.begin) / 2;
+        const Point &point = tree.at(mid);
+        const double distance = squaredChord(point.coords, target);
+        if (distance <= limit) {
+            result.append({locations.at(point.location).stationId, chordToKm(distance)});
+        }
+
+        const int axis = range.depth % 3;
+        const double delta = target[axis] - point.coords[axis];
+        if (delta < 0 || delta * delta <= limit) stack.append({range.begin, mid, range.depth + 1});
+        if (delta >= 0 || delta * delta <= limit) stack.append({mid + 1, range.end, range.depth + 1});
+    }
+
+    std::sort(result.begin(), result.end(), [](const Neighbor &a, const Neighbor &b) {
+        return a.distanceKm < b.distanceKm;
+    });
+    return result;
+}
+
+/**
+ * @brief Zwraca identyfikatory stacji leżących w prostokącie współrzędnych.
+ *
+ * Wyszukuje binarnie początek zakresu szerokości geograficznej na liście posortowanej według
+ * szerokości, a następnie sprawdza długość geograficzną stacji z tego zakresu.
+ *
+ * @param minLatitude Minimalna szerokość geograficzna.
+ * @param minLongitude Minimalna długość geograficzna.
+ * @param maxLatitude Maksymalna szerokość geograficzna.
+ * @param maxLongitude Maksymalna długość geograficzna.
+ * @return QVector<int> Identyfikatory stacji posortowane według szerokości geograficznej.
+ */
+QVector<int> StationSpatialIndex::withinBox(double minLatitude, double minLongitude, double maxLatitude, double maxLongitude) const {
+    QVector<int> result;
+    auto it = std::lower_bound(byLatitude.cbegin(), byLatitude.cend(), minLatitude, [this](int location, double value) {
+        return locations.at(location).latitude < value;
+    });
+
+    for (; it != byLatitude.cend(); ++it) {
+        const Location &location = locations.at(*it);
+        if (location.latitude > maxLatitude) break;
+        if (location.longitude >= minLongitude && location.longitude <= maxLongitude) {
+            result.append(location.stationId);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Zwraca położenie stacji o podanym identyfikatorze.
+ *
+ * @param stationId Identyfikator stacji.
+ * @param location Wskaźnik na strukturę, do której zapisywane jest położenie (może być nullptr).
+ * @return bool Wartość true, jeśli stacja jest w indeksie.
+ */
+bool StationSpatialIndex::locationOf(int stationId, Location *location) const {
+    auto it = locationForStation.constFind(stationId);
+    if (it == locationForStation.constEnd()) return false;
+    if (location) *location = locations.at(it.value());
+    return true;
+}
+
+/**
+ * @brief Zwraca liczbę stacji w indeksie.
+ *
+ * @return int Liczba stacji.
+ */
+int StationSpatialIndex::size() const {
+    return locations.size();
+}
+
+/**
+ * @brief Zamienia współrzędne geograficzne na punkt na sferze jednostkowej.
+ */
+void StationSpatialIndex::toUnitVector(double latitude, double longitude, double coords[3]) {
+    const double lat = qDegreesToRadians(latitude);
+    const double lon = qDegreesToRadians(longitude);
+    coords[0] = qCos(lat) * qCos(lon);
+    coords[1] = qCos(lat) * qSin(lon);
+    coords[2] = qSin(lat);
+}
+
+/**
+ * @brief Zwraca kwadrat odległości cięciwowej między dwoma punktami sfery jednostkowej.
+ */
+double StationSpatialIndex::squaredChord(const double a[3], const double b[3]) {
+    const double dx = a[0] - b[0];
+    const double dy = a[1] - b[1];
+    const double dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Zamienia kwadrat długości cięciwy na odległość po okręgu wielkim w kilometrach.
+ */
+double StationSpatialIndex::chordToKm(double squaredChordLength) {
+    const double halfChord = qMin(1.0, qSqrt(squaredChordLength) / 2.0);
+    return 2.0 * EarthRadiusKm * qAsin(halfChord);
+}
+
+/**
+ * @brief Rekurencyjnie porządkuje zakres tablicy `tree` jako poddrzewo k-d.
+ *
+ * @param begin Początek zakresu.
+ * @param end Koniec zakresu (wyłącznie).
+ * @param depth Głębokość poddrzewa (wyznacza oś podziału).
+ */
+void StationSpatialIndex::buildRange(int begin, int end, int depth) {
+    if (end - begin <= 1) return;
+
+    const int axis = depth % 3;
+    const int mid = begin + (end - begin) / 2;
+    std::nth_element(tree.begin() + begin, tree.begin() + mid, tree.begin() + end, [axis](const Point &a, const Point &b) {
+        return a.coords[axis] < b.coords[axis];
+    });
+
+    buildRange(begin, mid, depth + 1);
+    buildRange(mid + 1, end, depth + 1);
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * @file stationspatialindex.h
+ * @brief Definicja klasy StationSpatialIndex - drzewa k-d współrzędnych stacji.
+ */
+
+#ifndef STATIONSPATIALINDEX_H
+#define STATIONSPATIALINDEX_H
+
+#include <QHash>
+#include <QVector>
+
+class StationSpatialIndex
+{
+public:
+    /**
+     * @brief Położenie stacji (stopnie dziesiętne, WGS84).
+     */
+    struct Location {
+        int stationId;
+        double latitude;
+        double longitude;
+    };
+
+    /**
+     * @brief Stacja znaleziona w zapytaniu przestrzennym wraz z odległością w kilometrach.
+     */
+    struct Neighbor {
+        int stationId;
+        double distanceKm;
+    };
+
+    /**
+     * @brief Buduje indeks dla podanych położeń stacji.
+     *
+     * Współrzędne geograficzne są zamieniane na punkty na sferze jednostkowej (x, y, z), z których
+     * budowane jest zrównoważone drzewo k-d zapisane w tablicy. Odległość cięciwowa w 3D jest monotoniczna
+     * względem odległości po okręgu wielkim, więc wyniki są dokładne także dla dużych odległości.
+     *
+     * @param locations Lista położeń stacji.
+     */
+    void build(const QVector<Location> &locations);
+
+    /**
+     * @brief Zwraca `k` stacji najbliższych podanemu punktowi, od najbliższej.
+     *
+     * @param latitude Szerokość geograficzna punktu.
+     * @param longitude Długość geograficzna punktu.
+     * @param k Liczba szukanych stacji.
+     * @param excludeStationId Identyfikator stacji pomijanej w wynikach (np. stacji wyjściowej), domyślnie -1.
+     * @return QVector<Neighbor> Najbliższe stacje posortowane rosnąco według odległości.
+     */
+    QVector<Neighbor> nearest(double latitude, double longitude, int k, int excludeStationId = -1) const;
+
+    /**
+     * @brief Zwraca wszystkie stacje w podanej odległości od punktu, od najbliższej.
+     *
+     * @param latitude Szerokość geograficzna punktu.
+     * @param longitude Długość geograficzna punktu.
+     * @param radiusKm Promień w kilometrach.
+     * @return QVector<Neighbor> Stacje posortowane rosnąco według odległości.
+     */
+    QVector<Neighbor> withinRadius(double latitude, double longitude, double radiusKm) const;
+
+    /**
+     * @brief Zwraca identyfikatory stacji leżących w prostokącie współrzędnych.
+     *
+     * @param minLatitude Minimalna szerokość geograficzna.
+     * @param minLongitude Minimalna długość geograficzna.
+     * @param maxLatitude Maksymalna szerokość geograficzna.
+     * @param maxLongitude Maksymalna długość geograficzna.
+     * @return QVector<int> Identyfikatory stacji posortowane według szerokości geograficznej.
+     */
+    QVector<int> withinBox(double minLatitude, double minLongitude, double maxLatitude, double maxLongitude) const;
+
+    /**
+     * @brief Zwraca położenie stacji o podanym identyfikatorze.
+     *
+     * @param stationId Identyfikator stacji.
+     * @param location Wskaźnik na strukturę, do której zapisywane jest położenie (może być nullptr).
+     * @return bool Wartość true, jeśli stacja jest w indeksie.
+     */
+    bool locationOf(int stationId, Location *location) const;
+
+    /**
+     * @brief Zwraca liczbę stacji w indeksie.
+     *
+     * @return int Liczba stacji.
+     */
+    int size() const;
+
+private:
+    struct Point {
+        double coords[3];
+        int location;
+    };
+
+    static void toUnitVector(double latitude, double longitude, double coords[3]);
+    static double squaredChord(const double a[3], const double b[3]);
+    static double chordToKm(double squaredChordLength);
+    void buildRange(int begin, int end, int depth);
+
+    QVector<Location> locations;
+    QVector<Point> tree;
+    QVector<int> byLatitude;
+    QHash<int, int> locationForStation;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,348 @@
+/**
+ * @file taskexecutor.cpp
+ * @brief Implementacja klasy TaskExecutor - wspólnej puli wątków z podkradaniem zadań, priorytetami i anulowaniem.
+ */
+
+#include "taskexecutor.h"
+#include "metrics.h"
+
+#include <QThread>
+#include <chrono>
+#include <deque>
+
+namespace {
+/** Najdłuższy czas (ms), po którym wątek roboczy czekający na grupę ponownie sprawdza kolejki. */
+constexpr int HelpPollInterval = 1;
+
+/** Indeks wątku roboczego bieżącego wątku (-1 poza pulą). */
+thread_local int currentWorker = -1;
+
+const char *priorityName(int priority) {
+    switch (priority) {
+    case TaskExecutor::High:
+        return "high";
+    case TaskExecutor::Normal:
+        return "normal";
+    default:
+        return "low";
+    }
+}
+
+qint64 nowMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+/**
+ * @brief Zadanie w kolejce: funkcja, znacznik anulowania i chwila zlecenia (do pomiaru czasu oczekiwania).
+ */
+struct TaskExecutor::Task {
+    std::function<void()> run;
+    CancellationToken token;
+    int priority = Normal;
+    qint64 enqueuedAt = 0;
+};
+
+/**
+ * @brief Wątek roboczy z kolejkami dwustronnymi (po jednej na priorytet) chronionymi wspólną blokadą.
+ */
+struct TaskExecutor::Worker {
+    std::mutex mutex;
+    std::deque<Task> queues[PriorityCount];
+    QThread *thread = nullptr;
+};
+
+namespace {
+/** Metryki puli; referencje są pobierane w konstruktorze, więc rejestr metryk istnieje dłużej niż pula. */
+struct ExecutorMetrics {
+    Metrics::Counter *tasks[TaskExecutor::PriorityCount];
+    Metrics::Histogram *queueWait[TaskExecutor::PriorityCount];
+    Metrics::Counter *steals;
+    Metrics::Gauge *queued;
+};
+
+ExecutorMetrics &executorMetrics() {
+    static ExecutorMetrics metrics = [] {
+        ExecutorMetrics m;
+        for (int p = 0; p < TaskExecutor::PriorityCount; ++p) {
+            const QString labels = Metrics::label("priority", priorityName(p));
+            m.tasks[p] = &Metrics::counter("mjp_executor_tasks_total", "Zadania wykonane przez wspólną pulę wątków", labels);
+            m.queueWait[p] = &Metrics::histogram("mjp_executor_queue_wait_microseconds",
+                                                 "Czas oczekiwania zadań w kolejce wspólnej puli wątków", labels);
+        }
+        m.steals = &Metrics::counter("mjp_executor_steals_total", "Zadania podkradzione z kolejek innych wątków roboczych");
+        m.queued = &Metrics::gauge("mjp_executor_queued_tasks", "Zadania oczekujące w kolejkach wspólnej puli wątków");
+        return m;
+    }();
+    return metrics;
+}
+}
+
+/**
+ * @brief Konstruktor klasy TaskGroup.
+ *
+ * @param priority Priorytet zadań grupy.
+ * @param token Znacznik anulowania zadań grupy.
+ */
+TaskExecutor::TaskGroup::TaskGroup(Priority priority, const CancellationToken &token)
+    : state(std::make_shared<State>())
+    , priority(priority)
+    , cancellation(token)
+{
+}
+
+/**
+ * @brief Destruktor klasy TaskGroup - czeka na zakończenie zadań grupy, które mogą odwoływać się do jej właściciela.
+ */
+TaskExecutor::TaskGroup::~TaskGroup() {
+    wait();
+}
+
+/**
+ * @brief Zleca zadanie w ramach grupy.
+ *
+ * Zadanie jest opakowywane tak, aby zawsze (także po anulowaniu) zmniejszyło licznik zadań grupy;
+ * dlatego znacznik grupy jest sprawdzany w opakowaniu, a nie przekazywany do `submit`.
+ *
+ * @param task Zadanie.
+ */
+void TaskExecutor::TaskGroup::run(std::function<void()> task) {
+    state->pending.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<State> shared = state;
+    CancellationToken token = cancellation;
+    TaskExecutor::instance().submit([shared, token, task = std::move(task)]() {
+        if (!token.isCancelled()) {
+            task();
+        }
+        if (shared->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->done.notify_all();
+        }
+    }, priority);
+}
+
+/**
+ * @brief Czeka na zakończenie zleconych zadań grupy.
+ *
+ * W wątku roboczym wykonuje w tym czasie zadania z kolejek, a gdy żadnego nie ma - czeka krótko
+ * na zakończenie grupy i sprawdza kolejki ponownie.
+ */
+void TaskExecutor::TaskGroup::wait() {
+    if (isWorkerThread()) {
+        TaskExecutor &executor = TaskExecutor::instance();
+        while (state->pending.load(std::memory_order_acquire) > 0) {
+            if (!executor.runPending()) {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->done.wait_for(lock, std::chrono::milliseconds(HelpPollInterval), [this] {
+                    return state->pending.load(std::memory_order_acquire) == 0;
+                });
+            }
+        }
+        return;
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [this] {
+        return state->pending.load(std::memory_order_acquire) == 0;
+    });
+}
+
+/**
+ * @brief Anuluje zadania grupy oczekujące w kolejkach.
+ */
+void TaskExecutor::TaskGroup::cancel() {
+    cancellation.cancel();
+}
+
+/**
+ * @brief Zwraca wspólną pulę wątków.
+ *
+ * @return TaskExecutor& Pula wątków.
+ */
+TaskExecutor &TaskExecutor::instance() {
+    static TaskExecutor executor;
+    return executor;
+}
+
+/**
+ * @brief Konstruktor klasy TaskExecutor - uruchamia wątki robocze nazwane "TaskExecutor N" (widoczne w śladzie wykonania).
+ */
+TaskExecutor::TaskExecutor() {
+    executorMetrics();
+    const int count = qMax(1, QThread::idealThreadCount() - 1);
+    workers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < count; ++i) {
+        QThread *thread = QThread::create([this, i]() { workerLoop(i); });
+        thread->setObjectName(QString("TaskExecutor %1").arg(i + 1));
+        workers[i]->thread = thread;
+        thread->start();
+    }
+}
+
+/**
+ * @brief Destruktor klasy TaskExecutor - wykonuje pozostałe zadania i zamyka wątki robocze.
+ */
+TaskExecutor::~TaskExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (const auto &worker : workers) {
+        worker->thread->wait();
+        delete worker->thread;
+    }
+}
+
+/**
+ * @brief Zleca zadanie.
+ *
+ * Licznik zadań jest zwiększany przed dodaniem zadania do kolejki, a budzenie odbywa się pod blokadą
+ * uśpienia, więc wątek sprawdzający licznik przed zaśnięciem nie przeoczy nowego zadania.
+ *
+ * @param task Zadanie.
+ * @param priority Priorytet zadania.
+ * @param token Znacznik anulowania.
+ */
+void TaskExecutor::submit(std::function<void()> task, Priority priority, const CancellationToken &token) {
+    const int target = currentWorker >= 0 ? currentWorker
+                                          : static_cast<int>(nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size());
+    Task entry;
+    entry.run = std::move(task);
+    entry.token = token;
+    entry.priority = priority;
+    entry.enqueuedAt = nowMicroseconds();
+
+    queued.fetch_add(1, std::memory_order_acq_rel);
+    executorMetrics().queued->add(1);
+    {
+        Worker &worker = *workers[target];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[priority].push_back(std::move(entry));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+/**
+ * @brief Wykonuje równolegle fragmenty zakresu jako grupę zadań.
+ */
+void TaskExecutor::parallelFor(int begin, int end, int grain, const std::function<void(int, int)> &body,
+                               Priority priority, const CancellationToken &token) {
+    grain = qMax(1, grain);
+    TaskGroup group(priority, token);
+    for (int from = begin; from < end; from += grain) {
+        const int to = qMin(end, from + grain);
+        group.run([&body, from, to]() { body(from, to); });
+    }
+    group.wait();
+}
+
+/**
+ * @brief Sprawdza, czy bieżący wątek jest wątkiem roboczym puli.
+ */
+bool TaskExecutor::isWorkerThread() {
+    return currentWorker >= 0;
+}
+
+/**
+ * @brief Pobiera zadanie o najwyższym dostępnym priorytecie.
+ *
+ * Dla każdego priorytetu najpierw sprawdza koniec własnej kolejki, a potem początki kolejek pozostałych
+ * wątków (zaczynając od następnego, aby podkradanie rozkładało się równomiernie).
+ *
+ * @param self Indeks bieżącego wątku roboczego lub -1.
+ * @param task Wskaźnik na zmienną, do której zostanie przeniesione zadanie.
+ * @return bool Wartość true, jeśli zadanie zostało pobrane.
+ */
+bool TaskExecutor::takeTask(int self, Task *task) {
+    const int count = static_cast<int>(workers.size());
+    for (int priority = 0; priority < PriorityCount; ++priority) {
+        if (self >= 0) {
+            Worker &own = *workers[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            std::deque<Task> &queue = own.queues[priority];
+            if (!queue.empty()) {
+                *task = std::move(queue.back());
+                queue.pop_back();
+                return true;
+            }
+        }
+        for (int offset = 1; offset <= count; ++offset) {
+            const int victim = (qMax(self, 0) + offset) % count;
+            if (victim == self) {
+                continue;
+            }
+            Worker &other = *workers[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            std::deque<Task> &queue = other.queues[priority];
+            if (!queue.empty()) {
+                *task = std::move(queue.front());
+                queue.pop_front();
+                if (self >= 0) {
+                    executorMetrics().steals->add();
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Wykonuje pobrane zadanie (chyba że zostało anulowane) i aktualizuje metryki.
+ *
+ * @param task Zadanie.
+ */
+void TaskExecutor::execute(Task &task) {
+    queued.fetch_sub(1, std::memory_order_acq_rel);
+    ExecutorMetrics &metrics = executorMetrics();
+    metrics.queued->add(-1);
+    metrics.queueWait[task.priority]->record(nowMicroseconds() - task.enqueuedAt);
+    if (!task.token.isCancelled()) {
+        task.run();
+        metrics.tasks[task.priority]->add();
+    }
+    task.run = nullptr;
+}
+
+/**
+ * @brief Wykonuje jedno oczekujące zadanie w bieżącym wątku roboczym (pomoc podczas oczekiwania na grupę).
+ *
+ * @return bool Wartość true, jeśli wykonano zadanie.
+ */
+bool TaskExecutor::runPending() {
+    Task task;
+    if (!takeTask(currentWorker, &task)) {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+/**
+ * @brief Pętla wątku roboczego: wykonuje zadania, a gdy kolejki są puste - czeka na nowe.
+ *
+ * Po zamknięciu puli wątek kończy się dopiero, gdy wszystkie kolejki są puste.
+ *
+ * @param index Indeks wątku roboczego.
+ */
+void TaskExecutor::workerLoop(int index) {
+    currentWorker = index;
+    for (;;) {
+        if (runPending()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] {
+            return stopping.load() || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping.load() && queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
\ No newline at end of file
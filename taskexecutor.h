@@ -0,0 +1,181 @@
+/**
+ * @file taskexecutor.h
+ * @brief Definicja klasy TaskExecutor - wspólnej puli wątków z podkradaniem zadań, priorytetami i anulowaniem.
+ */
+
+#ifndef TASKEXECUTOR_H
+#define TASKEXECUTOR_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class QThread;
+
+/**
+ * @brief Wspólna pula wątków dla zadań obliczeniowych (dekodowanie, agregacja, zapis danych).
+ *
+ * Każdy wątek roboczy ma własne kolejki dwustronne (po jednej na priorytet): zadania zlecone z wątku roboczego
+ * trafiają do jego kolejki i są pobierane od końca (LIFO - najświeższe dane są jeszcze w pamięci podręcznej),
+ * a bezczynne wątki podkradają zadania z początku kolejek pozostałych wątków (FIFO - najstarsze, zwykle
+ * największe fragmenty pracy). Zadania o wyższym priorytecie są zawsze pobierane przed zadaniami o niższym.
+ *
+ * Liczba wątków jest o jeden mniejsza od liczby rdzeni (co najmniej 1), aby jeden rdzeń pozostał dla wątku
+ * interfejsu; wszystkie zadania obliczeniowe powinny korzystać z tej puli zamiast tworzyć własne wątki.
+ */
+class TaskExecutor
+{
+public:
+    /**
+     * @brief Priorytet zadania.
+     */
+    enum Priority {
+        High,          ///< Zadania, na których wynik czeka użytkownik (np. pomiary wybranego czujnika).
+        Normal,        ///< Zwykłe zadania w tle (np. wczytywanie danych historycznych).
+        Low,           ///< Zadania porządkowe (np. zbiorcza synchronizacja, kompaktowanie).
+        PriorityCount
+    };
+
+    /**
+     * @brief Znacznik anulowania współdzielony przez zlecającego i zadania.
+     *
+     * Kopie znacznika wskazują tę samą flagę. Zadania jeszcze niepobrane z kolejki są pomijane po anulowaniu,
+     * a zadania w toku powinny same sprawdzać `isCancelled` w punktach, w których mogą przerwać pracę.
+     */
+    class CancellationToken
+    {
+    public:
+        CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+        void cancel() const { flag->store(true, std::memory_order_relaxed); }
+        bool isCancelled() const { return flag->load(std::memory_order_relaxed); }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> flag;
+    };
+
+    /**
+     * @brief Grupa zadań z oczekiwaniem na zakończenie wszystkich (fork/join).
+     *
+     * Wątek roboczy czekający w `wait` wykonuje w tym czasie zadania z kolejek (w tym zadania grupy),
+     * więc zagnieżdżone grupy nie blokują puli. Inne wątki (np. wątek interfejsu w destruktorze obiektu)
+     * czekają bez wykonywania zadań. Destruktor grupy czeka na zakończenie jej zadań.
+     */
+    class TaskGroup
+    {
+    public:
+        /**
+         * @brief Konstruktor klasy TaskGroup.
+         *
+         * @param priority Priorytet zadań grupy.
+         * @param token Znacznik anulowania zadań grupy (domyślnie nowy, nieanulowany).
+         */
+        explicit TaskGroup(Priority priority = Normal, const CancellationToken &token = CancellationToken());
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        /**
+         * @brief Zleca zadanie w ramach grupy; zadanie jest pomijane, jeśli znacznik grupy zostanie anulowany.
+         *
+         * @param task Zadanie.
+         */
+        void run(std::function<void()> task);
+
+        /**
+         * @brief Czeka na zakończenie wszystkich zleconych dotąd zadań grupy.
+         */
+        void wait();
+
+        /**
+         * @brief Anuluje zadania grupy oczekujące w kolejkach.
+         */
+        void cancel();
+
+        /**
+         * @brief Zwraca znacznik anulowania grupy.
+         */
+        const CancellationToken &token() const { return cancellation; }
+
+    private:
+        struct State {
+            std::atomic<int> pending{0};
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+
+        std::shared_ptr<State> state;
+        Priority priority;
+        CancellationToken cancellation;
+    };
+
+    /**
+     * @brief Zwraca wspólną pulę (tworzoną przy pierwszym użyciu, zamykaną przy zakończeniu programu).
+     *
+     * @return TaskExecutor& Pula wątków.
+     */
+    static TaskExecutor &instance();
+
+    /**
+     * @brief Zleca zadanie.
+     *
+     * Zadanie zlecone z wątku roboczego trafia do jego kolejki, a zlecone z innego wątku - kolejno do kolejek
+     * wszystkich wątków roboczych.
+     *
+     * @param task Zadanie.
+     * @param priority Priorytet zadania.
+     * @param token Znacznik anulowania; zadanie jest pomijane, jeśli znacznik zostanie anulowany przed jego pobraniem.
+     */
+    void submit(std::function<void()> task, Priority priority = Normal, const CancellationToken &token = CancellationToken());
+
+    /**
+     * @brief Dzieli zakres [begin, end) na fragmenty co najwyżej `grain` elementów i wykonuje je równolegle.
+     *
+     * Wraca po przetworzeniu wszystkich fragmentów; po anulowaniu znacznika kolejne fragmenty są pomijane.
+     * Nie należy wywoływać z wątku interfejsu (wywołanie czeka na zakończenie fragmentów).
+     *
+     * @param begin Początek zakresu.
+     * @param end Koniec zakresu (wyłącznie).
+     * @param grain Największa liczba elementów fragmentu.
+     * @param body Funkcja przetwarzająca fragment [początek, koniec).
+     * @param priority Priorytet fragmentów.
+     * @param token Znacznik anulowania.
+     */
+    static void parallelFor(int begin, int end, int grain, const std::function<void(int, int)> &body,
+                            Priority priority = Normal, const CancellationToken &token = CancellationToken());
+
+    /**
+     * @brief Zwraca liczbę wątków roboczych.
+     */
+    int workerCount() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * @brief Sprawdza, czy bieżący wątek jest wątkiem roboczym puli.
+     */
+    static bool isWorkerThread();
+
+private:
+    struct Task;
+    struct Worker;
+
+    TaskExecutor();
+    ~TaskExecutor();
+
+    bool takeTask(int self, Task *task);
+    void execute(Task &task);
+    bool runPending();
+    void workerLoop(int index);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued{0};
+    std::atomic<unsigned> nextWorker{0};
+    std::atomic<bool> stopping{false};
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+/**
+ * @file textnormalizer.cpp
+ * @brief Implementacja klasy TextNormalizer do normalizacji tekstu na potrzeby wyszukiwania.
+ */
+
+#include "textnormalizer.h"
+
+/**
+ * @brief Zwraca klucz wyszukiwania niezależny od wielkości liter i znaków diakrytycznych.
+ *
+ * Dla tekstu złożonego wyłącznie ze znaków ASCII wystarcza zamiana na małe litery. W pozostałych
+ * przypadkach tekst jest rozkładany do postaci NFD, znaki łączące (np. ogonki, kreski) są pomijane,
+ * a litery "Ł"/"ł", które nie mają rozkładu kanonicznego, są zamieniane jawnie na "l".
+ *
+ * @param text Tekst wejściowy.
+ * @return QString Znormalizowany klucz wyszukiwania.
+ */
+QString TextNormalizer::fold(const QString &text) {
+    bool isAscii = true;
+    for (const QChar ch : text) {
+        if (ch.unicode() > 0x7F) {
+            isAscii = false;
+            break;
+        }
+    }
+    if (isAscii) {
+        return text.toLower();
+    }
+
+    const QString decomposed = text.normalized(QString::NormalizationForm_D);
+    QString result;
+    result.reserve(decomposed.size());
+
+    for (const QChar ch : decomposed) {
+        if (ch.category() == QChar::Mark_NonSpacing) {
+            continue;
+        }
+        if (ch.unicode() == 0x0141 || ch.unicode() == 0x0142) {
+            result += QLatin1Char('l');
+            continue;
+        }
+        result += ch.toCaseFolded();
+    }
+    return result;
+}
\ No newline at end of file
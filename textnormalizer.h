@@ -0,0 +1,26 @@
+/**
+ * @file textnormalizer.h
+ * @brief Definicja klasy TextNormalizer do normalizacji tekstu na potrzeby wyszukiwania.
+ */
+
+#ifndef TEXTNORMALIZER_H
+#define TEXTNORMALIZER_H
+
+#include <QString>
+
+class TextNormalizer
+{
+public:
+    /**
+     * @brief Zwraca klucz wyszukiwania niezależny od wielkości liter i znaków diakrytycznych.
+     *
+     * Sprowadza tekst do małych liter (case folding) i usuwa znaki diakrytyczne, tak aby np. "Łódź"
+     * oraz "lodz" dawały ten sam klucz. Klucz służy wyłącznie do porównań, nie do wyświetlania.
+     *
+     * @param text Tekst wejściowy.
+     * @return QString Znormalizowany klucz wyszukiwania.
+     */
+    static QString fold(const QString &text);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,313 @@
+/**
+ * @file tracing.cpp
+ * @brief Implementacja klasy Tracing - lekkiego śledzenia czasu wykonania z eksportem do formatu Chrome/Perfetto.
+ */
+
+#include "tracing.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/** Liczba zdarzeń w buforze cyklicznym jednego wątku (ok. 770 KB). */
+constexpr quint64 BufferCapacity = 16384;
+
+/**
+ * @brief Miejsce na jedno zdarzenie w buforze cyklicznym.
+ *
+ * Pola są atomowe (zapisywane i odczytywane bez porządkowania), a `sequence` działa jak blokada sekwencyjna:
+ * podczas zapisu zdarzenia o numerze n ma wartość 2n + 1, a po zapisie - 2n + 2. Odczyt jest poprawny, jeśli
+ * przed skopiowaniem pól i po nim `sequence` ma tę samą, oczekiwaną wartość.
+ */
+struct Slot {
+    std::atomic<quint64> sequence{0};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<char> phase{'X'};
+    std::atomic<qint64> start{0};
+    std::atomic<qint64> duration{0};
+    std::atomic<qint64> id{-1};
+};
+
+/**
+ * @brief Bufor cykliczny zdarzeń jednego wątku.
+ *
+ * Zapisuje do niego tylko wątek-właściciel; `head` to liczba wszystkich zapisanych zdarzeń, a każde miejsce
+ * jest publikowane własnym numerem sekwencyjnym (`Slot`), więc `chromeTraceJson` pomija zdarzenia nadpisywane
+ * w trakcie odczytu. `inUse` (chronione blokadą rejestru) ma wartość false po zakończeniu wątku - bufor
+ * przejmuje wtedy kolejny nowy wątek.
+ */
+struct ThreadBuffer {
+    int tid = 0;
+    QString threadName;
+    Slot slots[BufferCapacity];
+    std::atomic<quint64> head{0};
+    bool inUse = true;
+};
+
+/** Blokada rejestru; nie jest niszczona, bo wątki kończone przy zamykaniu programu zwalniają jeszcze bufory. */
+QMutex &registryMutex() {
+    static QMutex *mutex = new QMutex;
+    return *mutex;
+}
+
+/**
+ * @brief Bufory wszystkich wątków.
+ *
+ * Bufor zakończonego wątku jest zachowywany (jego zdarzenia trafiają do śladu), dopóki nie przejmie go nowy
+ * wątek, więc liczba buforów nie przekracza największej liczby jednocześnie działających śledzonych wątków,
+ * nawet gdy wątki (np. z QThreadPool) są często tworzone i kończone.
+ */
+std::vector<std::unique_ptr<ThreadBuffer>> &registry() {
+    static auto *buffers = new std::vector<std::unique_ptr<ThreadBuffer>>;
+    return *buffers;
+}
+
+/** Identyfikator ostatnio przydzielony wątkowi w śladzie (chroniony blokadą rejestru). */
+int lastTid = 0;
+
+thread_local ThreadBuffer *currentBuffer = nullptr;
+
+/** Wartość true po oddaniu bufora kończącego się wątku; późniejsze zdarzenia wątku są pomijane. */
+thread_local bool bufferReleased = false;
+
+/**
+ * @brief Oddaje bufor wątku do ponownego użycia, gdy wątek się kończy (destruktor zmiennej thread_local).
+ *
+ * Czyści `currentBuffer`, więc zdarzenie zapisane później przez destruktor innej zmiennej thread_local nie trafi
+ * do bufora, który mógł już przejąć inny wątek.
+ */
+struct BufferRelease {
+    ThreadBuffer *buffer = nullptr;
+
+    ~BufferRelease() {
+        if (buffer) {
+            QMutexLocker locker(&registryMutex());
+            buffer->inUse = false;
+        }
+        currentBuffer = nullptr;
+        bufferReleased = true;
+    }
+};
+
+thread_local BufferRelease bufferRelease;
+
+const QElapsedTimer &clock() {
+    static const QElapsedTimer timer = [] {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+/**
+ * @brief Przydziela bufor bieżącemu wątkowi: przejmuje bufor zakończonego wątku albo tworzy nowy.
+ *
+ * Przejęty bufor jest opróżniany pod blokadą rejestru (odczyt w `chromeTraceJson` trzyma tę samą blokadę)
+ * i otrzymuje nowy identyfikator wątku, więc zdarzenia obu wątków nie są mieszane.
+ */
+ThreadBuffer *createBuffer() {
+    QThread *thread = QThread::currentThread();
+    QString threadName = thread->objectName();
+    if (threadName.isEmpty()) {
+        threadName = (QCoreApplication::instance() && QCoreApplication::instance()->thread() == thread)
+                         ? QString("GUI")
+                         : QString("Wątek %1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+    }
+
+    QMutexLocker locker(&registryMutex());
+    ThreadBuffer *buffer = nullptr;
+    for (const auto &candidate : registry()) {
+        if (!candidate->inUse) {
+            buffer = candidate.get();
+            buffer->inUse = true;
+            buffer->head.store(0, std::memory_order_relaxed);
+            for (Slot &slot : buffer->slots) {
+                slot.sequence.store(0, std::memory_order_relaxed);
+            }
+            break;
+        }
+    }
+    if (!buffer) {
+        registry().push_back(std::make_unique<ThreadBuffer>());
+        buffer = registry().back().get();
+    }
+    buffer->tid = ++lastTid;
+    buffer->threadName = threadName;
+    bufferRelease.buffer = buffer;
+    return buffer;
+}
+
+}
+
+std::atomic<bool> Tracing::enabled{false};
+
+/**
+ * @brief Włącza lub wyłącza śledzenie.
+ *
+ * @param on Wartość true, jeśli zdarzenia mają być zapisywane.
+ */
+void Tracing::setEnabled(bool on) {
+    clock();
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Zwraca bieżący czas śledzenia w nanosekundach (od pierwszego użycia zegara).
+ */
+qint64 Tracing::now() {
+    return clock().nsecsElapsed();
+}
+
+/**
+ * @brief Zapisuje zdarzenie w buforze cyklicznym bieżącego wątku.
+ *
+ * Pierwsze zdarzenie wątku tworzy jego bufor (jedyne miejsce z blokadą i przydziałem pamięci). Miejsce jest
+ * oznaczane jako zapisywane (nieparzysty numer sekwencyjny) przed zmianą pól i publikowane po niej. Zdarzenia
+ * zapisane po oddaniu bufora kończącego się wątku są pomijane.
+ *
+ * @param event Zdarzenie.
+ */
+void Tracing::record(const Event &event) {
+    ThreadBuffer *buffer = currentBuffer;
+    if (!buffer) {
+        if (bufferReleased) {
+            return;
+        }
+        buffer = currentBuffer = createBuffer();
+    }
+    const quint64 head = buffer->head.load(std::memory_order_relaxed);
+    Slot &slot = buffer->slots[head % BufferCapacity];
+    slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.phase.store(event.phase, std::memory_order_relaxed);
+    slot.start.store(event.start, std::memory_order_relaxed);
+    slot.duration.store(event.duration, std::memory_order_relaxed);
+    slot.id.store(event.id, std::memory_order_relaxed);
+    slot.sequence.store(2 * head + 2, std::memory_order_release);
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Zapisuje początek zdarzenia asynchronicznego, jeśli śledzenie jest włączone.
+ *
+ * @param name Nazwa zdarzenia (tekst o statycznym czasie życia).
+ * @param id Identyfikator łączący początek i koniec zdarzenia.
+ */
+void Tracing::asyncBegin(const char *name, qint64 id) {
+    if (isEnabled()) {
+        record({name, 'b', now(), 0, id});
+    }
+}
+
+/**
+ * @brief Zapisuje koniec zdarzenia asynchronicznego, jeśli śledzenie jest włączone.
+ *
+ * @param name Nazwa zdarzenia (ta sama co w `asyncBegin`).
+ * @param id Identyfikator łączący początek i koniec zdarzenia.
+ */
+void Tracing::asyncEnd(const char *name, qint64 id) {
+    if (isEnabled()) {
+        record({name, 'e', now(), 0, id});
+    }
+}
+
+/**
+ * @brief Zwraca zdarzenia wszystkich wątków w formacie JSON Chrome Trace Event.
+ *
+ * Każde zdarzenie jest kopiowane tylko wtedy, gdy numer sekwencyjny jego miejsca przed skopiowaniem pól i po nim
+ * wskazuje właśnie to, w pełni zapisane zdarzenie; zdarzenia zapisywane lub nadpisane przez wątek w trakcie
+ * odczytu są pomijane, więc odczyt nie wymaga zatrzymywania wątków. Zakresy mają fazę 'X'
+ * (czas w mikrosekundach, identyfikator żądania w `args.requestId`), zdarzenia asynchroniczne - 'b'/'e'
+ * z polem `id`, a nazwy wątków są zapisywane zdarzeniami metadanych 'M'.
+ *
+ * @return QByteArray Dokument JSON śladu.
+ */
+QByteArray Tracing::chromeTraceJson() {
+    QJsonArray traceEvents;
+    QMutexLocker locker(&registryMutex());
+
+    for (const auto &buffer : registry()) {
+        QJsonObject threadName;
+        threadName["name"] = "thread_name";
+        threadName["ph"] = "M";
+        threadName["pid"] = 1;
+        threadName["tid"] = buffer->tid;
+        threadName["args"] = QJsonObject{{"name", buffer->threadName}};
+        traceEvents.append(threadName);
+
+        const quint64 head = buffer->head.load(std::memory_order_acquire);
+        const quint64 first = head > BufferCapacity ? head - BufferCapacity : 0;
+        QVector<Event> events;
+        events.reserve(static_cast<int>(head - first));
+        for (quint64 i = first; i < head; ++i) {
+            const Slot &slot = buffer->slots[i % BufferCapacity];
+            const quint64 published = 2 * i + 2;
+            if (slot.sequence.load(std::memory_order_acquire) != published) {
+                continue;
+            }
+            Event event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.phase = slot.phase.load(std::memory_order_relaxed);
+            event.start = slot.start.load(std::memory_order_relaxed);
+            event.duration = slot.duration.load(std::memory_order_relaxed);
+            event.id = slot.id.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == published) {
+                events.append(event);
+            }
+        }
+
+        for (const Event &event : std::as_const(events)) {
+            QJsonObject json;
+            json["name"] = QString::fromLatin1(event.name);
+            json["cat"] = "mjp";
+            json["ph"] = QString(QLatin1Char(event.phase));
+            json["ts"] = event.start / 1000.0;
+            json["pid"] = 1;
+            json["tid"] = buffer->tid;
+            if (event.phase == 'X') {
+                json["dur"] = event.duration / 1000.0;
+                if (event.id >= 0) {
+                    json["args"] = QJsonObject{{"requestId", event.id}};
+                }
+            } else {
+                json["id"] = event.id;
+            }
+            traceEvents.append(json);
+        }
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = traceEvents;
+    trace["displayTimeUnit"] = "ms";
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Zapisuje ślad w formacie Chrome Trace Event do pliku.
+ *
+ * @param path Ścieżka pliku.
+ * @return bool Wartość true, jeśli plik został zapisany.
+ */
+bool Tracing::writeChromeTrace(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(chromeTraceJson());
+    return true;
+}
\ No newline at end of file
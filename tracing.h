@@ -0,0 +1,149 @@
+/**
+ * @file tracing.h
+ * @brief Definicja klasy Tracing - lekkiego śledzenia czasu wykonania z eksportem do formatu Chrome/Perfetto.
+ */
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+class Tracing
+{
+public:
+    /**
+     * @brief Zdarzenie śladu.
+     *
+     * `name` musi wskazywać tekst o statycznym czasie życia (np. literał), bo zapis zdarzenia nie kopiuje
+     * napisów. `phase` to faza zdarzenia w formacie Chrome: 'X' (zakres z czasem trwania), 'b' i 'e'
+     * (początek i koniec zdarzenia asynchronicznego o identyfikatorze `id`).
+     */
+    struct Event {
+        const char *name = nullptr;
+        char phase = 'X';
+        qint64 start = 0;
+        qint64 duration = 0;
+        qint64 id = -1;
+    };
+
+    /**
+     * @brief Zakres śledzenia: zapisuje zdarzenie 'X' od utworzenia do zniszczenia obiektu.
+     *
+     * Przy wyłączonym śledzeniu koszt ogranicza się do odczytu jednej flagi atomowej.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name, qint64 id = -1)
+            : name(name)
+            , id(id)
+            , start(isEnabled() ? now() : -1)
+        {
+        }
+
+        ~Scope() {
+            if (start >= 0) {
+                record({name, 'X', start, now() - start, id});
+            }
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *name;
+        qint64 id;
+        qint64 start;
+    };
+
+    /**
+     * @brief Sprawdza, czy śledzenie jest włączone.
+     */
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Włącza lub wyłącza śledzenie.
+     *
+     * Bufory wątków są przydzielane dopiero przy pierwszym zdarzeniu, więc nigdy niewłączone śledzenie
+     * nie zajmuje pamięci. Wyłączenie nie usuwa zapisanych zdarzeń.
+     *
+     * @param on Wartość true, jeśli zdarzenia mają być zapisywane.
+     */
+    static void setEnabled(bool on);
+
+    /**
+     * @brief Zwraca bieżący czas śledzenia w nanosekundach (zegar monotoniczny).
+     */
+    static qint64 now();
+
+    /**
+     * @brief Zapisuje zdarzenie w buforze cyklicznym bieżącego wątku.
+     *
+     * Bufor ma stałą pojemność; po jej wyczerpaniu najstarsze zdarzenia są nadpisywane. Zapis nie blokuje
+     * innych wątków ani nie przydziela pamięci (poza pierwszym zdarzeniem wątku).
+     *
+     * @param event Zdarzenie.
+     */
+    static void record(const Event &event);
+
+    /**
+     * @brief Zapisuje początek zdarzenia asynchronicznego (np. żądania przechodzącego między wątkami).
+     *
+     * @param name Nazwa zdarzenia (tekst o statycznym czasie życia).
+     * @param id Identyfikator łączący początek i koniec zdarzenia.
+     */
+    static void asyncBegin(const char *name, qint64 id);
+
+    /**
+     * @brief Zapisuje koniec zdarzenia asynchronicznego.
+     *
+     * @param name Nazwa zdarzenia (ta sama co w `asyncBegin`).
+     * @param id Identyfikator łączący początek i koniec zdarzenia.
+     */
+    static void asyncEnd(const char *name, qint64 id);
+
+    /**
+     * @brief Zwraca zdarzenia wszystkich wątków w formacie JSON Chrome Trace Event (chrome://tracing, Perfetto).
+     *
+     * Można ją wywołać w trakcie działania programu; zdarzenia nadpisane w czasie odczytu są pomijane.
+     *
+     * @return QByteArray Dokument JSON śladu.
+     */
+    static QByteArray chromeTraceJson();
+
+    /**
+     * @brief Zapisuje ślad w formacie Chrome Trace Event do pliku.
+     *
+     * @param path Ścieżka pliku.
+     * @return bool Wartość true, jeśli plik został zapisany.
+     */
+    static bool writeChromeTrace(const QString &path);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+#ifdef MJP_NO_TRACING
+#define MJP_TRACE_SCOPE(name) static_cast<void>(0)
+#define MJP_TRACE_SCOPE_ID(name, id) static_cast<void>(0)
+#define MJP_TRACE_ASYNC_BEGIN(name, id) static_cast<void>(0)
+#define MJP_TRACE_ASYNC_END(name, id) static_cast<void>(0)
+#else
+#define MJP_TRACE_CONCAT_IMPL(a, b) a##b
+#define MJP_TRACE_CONCAT(a, b) MJP_TRACE_CONCAT_IMPL(a, b)
+/** Śledzi czas wykonania bieżącego bloku. */
+#define MJP_TRACE_SCOPE(name) Tracing::Scope MJP_TRACE_CONCAT(mjpTraceScope, __LINE__)(name)
+/** Śledzi czas wykonania bieżącego bloku z identyfikatorem żądania (widocznym w argumentach zdarzenia). */
+#define MJP_TRACE_SCOPE_ID(name, id) Tracing::Scope MJP_TRACE_CONCAT(mjpTraceScope, __LINE__)(name, id)
+/** Rozpoczyna zdarzenie asynchroniczne o podanym identyfikatorze. */
+#define MJP_TRACE_ASYNC_BEGIN(name, id) Tracing::asyncBegin(name, id)
+/** Kończy zdarzenie asynchroniczne o podanym identyfikatorze. */
+#define MJP_TRACE_ASYNC_END(name, id) Tracing::asyncEnd(name, id)
+#endif
+
+#endif
\ No newline at end of file